@@ -0,0 +1,45 @@
+// algorithms/graph/bellman_ford.cpp
+#include "graph_algorithms.h"
+
+using std::vector;
+using std::size_t;
+
+bool bellmanFord(const Graph& g, VertexId source, vector<Distance>& dist, StepTrace* trace) {
+    VertexId n = g.vertexCount();
+    dist.assign(n, INF_DISTANCE);
+    if (source >= n) return true;
+    dist[source] = 0;
+
+    const vector<std::uint64_t>& offsets = g.offsets();
+    const vector<VertexId>& targets = g.targets();
+    const vector<Weight>& weights = g.weights();
+
+    // Up to V-1 rounds over the flat arc arrays; stop as soon as a round changes nothing
+    for (VertexId round = 0; round + 1 < n; ++round) {
+        bool changed = false;
+        for (VertexId u = 0; u < n; ++u) {
+            Distance du = dist[u];
+            if (du == INF_DISTANCE) continue;
+            for (std::uint64_t a = offsets[u]; a < offsets[u + 1]; ++a) {
+                VertexId v = targets[a];
+                Distance candidate = du + weights[a];
+                if (trace) trace->compare(u, v);
+                if (candidate < dist[v]) {
+                    dist[v] = candidate;
+                    changed = true;
+                    if (trace) trace->visit(v, u);
+                }
+            }
+        }
+        if (!changed) return true;
+    }
+
+    // One more pass: any improvement now means a reachable negative cycle
+    for (VertexId u = 0; u < n; ++u) {
+        if (dist[u] == INF_DISTANCE) continue;
+        for (std::uint64_t a = offsets[u]; a < offsets[u + 1]; ++a) {
+            if (dist[u] + weights[a] < dist[targets[a]]) return false;
+        }
+    }
+    return true;
+}
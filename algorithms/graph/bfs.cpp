@@ -0,0 +1,210 @@
+// algorithms/graph/bfs.cpp
+#include "graph_algorithms.h"
+#include "../../utilities/parallel.h"
+#include <atomic>
+#include <memory>
+
+using std::vector;
+using std::size_t;
+using std::uint32_t;
+using std::uint64_t;
+
+namespace {
+
+// Frontier chunk handed to one worker at a time; bottom-up chunks are whole
+// bitmap words so no two workers ever write the same word.
+constexpr size_t TOP_DOWN_GRAIN = 256;
+constexpr size_t BOTTOM_UP_GRAIN = 64 * 64;
+
+// One bit per vertex, set with fetch_or so concurrent discoverers agree on a single winner
+class AtomicBitmap {
+public:
+    explicit AtomicBitmap(size_t bits) : wordCount((bits + 63) / 64), words(new std::atomic<uint64_t>[wordCount]) {
+        clear();
+    }
+    void clear() {
+        for (size_t w = 0; w < wordCount; ++w) words[w].store(0, std::memory_order_relaxed);
+    }
+    bool test(size_t i) const {
+        return (words[i >> 6].load(std::memory_order_relaxed) >> (i & 63)) & 1;
+    }
+    void set(size_t i) {
+        words[i >> 6].fetch_or(uint64_t(1) << (i & 63), std::memory_order_relaxed);
+    }
+    // True only for the caller that flipped the bit from 0 to 1
+    bool trySet(size_t i) {
+        uint64_t mask = uint64_t(1) << (i & 63);
+        if (words[i >> 6].load(std::memory_order_relaxed) & mask) return false; // Cheap pre-check
+        return !(words[i >> 6].fetch_or(mask, std::memory_order_relaxed) & mask);
+    }
+
+private:
+    size_t wordCount;
+    std::unique_ptr<std::atomic<uint64_t>[]> words;
+};
+
+// Padded so per-worker tallies don't share a cache line
+struct alignas(64) WorkerState {
+    vector<VertexId> next;
+    uint64_t scanned = 0;
+    uint64_t nextArcs = 0;
+};
+
+BfsResult referenceBfs(const Graph& g, VertexId source, StepTrace* trace) {
+    VertexId n = g.vertexCount();
+    BfsResult result;
+    result.parent.assign(n, NO_VERTEX);
+    result.depth.assign(n, NO_VERTEX);
+    if (source >= n) return result;
+
+    vector<VertexId> queue;
+    queue.reserve(n);
+    queue.push_back(source);
+    result.parent[source] = source;
+    result.depth[source] = 0;
+    if (trace) {
+        trace->frontier(0, 1);
+        trace->visit(source, source);
+    }
+
+    // The queue holds one level per [head, levelEnd) window
+    size_t head = 0;
+    for (uint32_t level = 0; head < queue.size(); ++level) {
+        size_t levelEnd = queue.size();
+        for (; head < levelEnd; ++head) {
+            VertexId u = queue[head];
+            for (VertexId v : g.neighbors(u)) {
+                if (trace) trace->compare(u, v);
+                if (result.parent[v] != NO_VERTEX) continue;
+                result.parent[v] = u;
+                result.depth[v] = level + 1;
+                queue.push_back(v);
+            }
+        }
+        result.levels = level + 1;
+        if (trace && queue.size() > levelEnd) {
+            trace->frontier(level + 1, queue.size() - levelEnd);
+            for (size_t i = levelEnd; i < queue.size(); ++i) trace->visit(queue[i], result.parent[queue[i]]);
+        }
+    }
+    return result;
+}
+
+BfsResult parallelBfs(const Graph& g, VertexId source, const BfsOptions& options, StepTrace* trace) {
+    VertexId n = g.vertexCount();
+    BfsResult result;
+    result.parent.assign(n, NO_VERTEX);
+    result.depth.assign(n, NO_VERTEX);
+    if (source >= n) return result;
+
+    unsigned threads = resolveThreadCount(options.threads);
+    vector<WorkerState> workers(threads);
+    AtomicBitmap visited(n);
+    AtomicBitmap frontierBits(n);
+
+    // Bottom-up steps scan in-arcs; an undirected graph is its own transpose
+    Graph ownTranspose;
+    const Graph* inArcs = g.isDirected() ? options.transpose : &g;
+
+    vector<VertexId> frontier = {source};
+    visited.set(source);
+    result.parent[source] = source;
+    result.depth[source] = 0;
+    if (trace) {
+        trace->frontier(0, 1);
+        trace->visit(source, source);
+    }
+
+    uint64_t frontierArcs = g.degree(source);
+    uint64_t unexploredArcs = g.arcCount() - frontierArcs;
+    uint64_t scannedTotal = 0;
+    bool bottomUp = false;
+
+    for (uint32_t level = 0; !frontier.empty(); ++level) {
+        // Beamer's heuristic: bottom-up pays off once the frontier touches a large share
+        // of the remaining arcs, and stops paying off once the frontier shrinks again
+        if (options.directionOptimizing) {
+            if (!bottomUp && frontierArcs > unexploredArcs / options.alpha) bottomUp = true;
+            else if (bottomUp && frontier.size() < n / options.beta) bottomUp = false;
+            if (bottomUp && !inArcs) {
+                ownTranspose = g.reversed();
+                inArcs = &ownTranspose;
+            }
+        }
+        for (WorkerState& w : workers) {
+            w.next.clear();
+            w.nextArcs = 0;
+        }
+
+        if (bottomUp) {
+            frontierBits.clear();
+            parallelFor(0, frontier.size(), TOP_DOWN_GRAIN, threads, [&](size_t b, size_t e, unsigned) {
+                for (size_t i = b; i < e; ++i) frontierBits.set(frontier[i]);
+            });
+            // Every unvisited vertex looks for any parent in the frontier and stops at the first hit
+            parallelFor(0, n, BOTTOM_UP_GRAIN, threads, [&](size_t b, size_t e, unsigned id) {
+                WorkerState& w = workers[id];
+                for (size_t v = b; v < e; ++v) {
+                    if (visited.test(v)) continue;
+                    for (VertexId u : inArcs->neighbors(static_cast<VertexId>(v))) {
+                        ++w.scanned;
+                        if (!frontierBits.test(u)) continue;
+                        visited.set(v);
+                        result.parent[v] = u;
+                        result.depth[v] = level + 1;
+                        w.next.push_back(static_cast<VertexId>(v));
+                        w.nextArcs += g.degree(static_cast<VertexId>(v));
+                        break;
+                    }
+                }
+            });
+            ++result.bottomUpLevels;
+        } else {
+            // Every frontier vertex claims its unvisited neighbours; trySet picks one winner each
+            parallelFor(0, frontier.size(), TOP_DOWN_GRAIN, threads, [&](size_t b, size_t e, unsigned id) {
+                WorkerState& w = workers[id];
+                for (size_t i = b; i < e; ++i) {
+                    VertexId u = frontier[i];
+                    for (VertexId v : g.neighbors(u)) {
+                        ++w.scanned;
+                        if (!visited.trySet(v)) continue;
+                        result.parent[v] = u;
+                        result.depth[v] = level + 1;
+                        w.next.push_back(v);
+                        w.nextArcs += g.degree(v);
+                    }
+                }
+            });
+        }
+        result.levels = level + 1;
+
+        // Join the per-worker queues into the next frontier
+        frontier.clear();
+        frontierArcs = 0;
+        for (const WorkerState& w : workers) {
+            frontier.insert(frontier.end(), w.next.begin(), w.next.end());
+            frontierArcs += w.nextArcs;
+        }
+        unexploredArcs = unexploredArcs > frontierArcs ? unexploredArcs - frontierArcs : 0;
+
+        if (trace && !frontier.empty()) {
+            trace->frontier(level + 1, frontier.size());
+            for (unsigned id = 0; id < threads; ++id) {
+                trace->setWorker(static_cast<std::uint8_t>(id));
+                for (VertexId v : workers[id].next) trace->visit(v, result.parent[v]);
+            }
+            trace->setWorker(0);
+        }
+    }
+
+    for (const WorkerState& w : workers) scannedTotal += w.scanned;
+    if (trace) trace->addComparisons(scannedTotal);
+    return result;
+}
+
+} // namespace
+
+BfsResult breadthFirstSearch(const Graph& g, VertexId source, const BfsOptions& options, StepTrace* trace) {
+    if (options.mode == BfsMode::Reference) return referenceBfs(g, source, trace);
+    return parallelBfs(g, source, options, trace);
+}
@@ -0,0 +1,36 @@
+// algorithms/graph/dfs.cpp
+#include "graph_algorithms.h"
+#include <utility>
+
+using std::vector;
+using std::size_t;
+
+vector<VertexId> depthFirstSearch(const Graph& g, VertexId source, StepTrace* trace) {
+    vector<VertexId> order;
+    if (source >= g.vertexCount()) return order;
+    vector<char> visited(g.vertexCount(), 0);
+    // Explicit (vertex, next arc) stack so deep graphs can't overflow the call stack
+    vector<std::pair<VertexId, size_t>> stack;
+    stack.push_back({source, 0});
+    visited[source] = 1;
+    order.push_back(source);
+    if (trace) trace->visit(source, source);
+
+    while (!stack.empty()) {
+        auto& [u, next] = stack.back();
+        Graph::NeighborRange range = g.neighbors(u);
+        if (next == range.size()) {
+            stack.pop_back();
+            continue;
+        }
+        VertexId v = range.target(next++);
+        if (trace) trace->compare(u, v);
+        if (!visited[v]) {
+            visited[v] = 1;
+            order.push_back(v);
+            if (trace) trace->visit(v, u);
+            stack.push_back({v, 0}); // Invalidates u/next; they are re-read next iteration
+        }
+    }
+    return order;
+}
@@ -0,0 +1,61 @@
+// algorithms/graph/dijkstra.cpp
+#include "graph_algorithms.h"
+
+using std::vector;
+using std::size_t;
+
+// One body for every backend; the queue type is fixed at compile time so the
+// hot loop has no virtual calls
+template <typename Queue>
+static void runDijkstra(const Graph& g, VertexId source, vector<Distance>& dist, vector<VertexId>& parent,
+                        StepTrace* trace, PriorityQueueStats* stats) {
+    VertexId n = g.vertexCount();
+    dist.assign(n, INF_DISTANCE);
+    parent.assign(n, NO_VERTEX);
+    if (source >= n) return;
+
+    Queue queue;
+    queue.reset(n);
+    dist[source] = 0;
+    parent[source] = source;
+    queue.update(source, 0);
+
+    QueueItem item;
+    while (queue.pop(item)) {
+        VertexId u = item.id;
+        if (trace) trace->visit(u, parent[u]);
+        Graph::NeighborRange range = g.neighbors(u);
+        for (size_t i = 0; i < range.size(); ++i) {
+            VertexId v = range.target(i);
+            Distance candidate = item.key + range.weight(i);
+            if (trace) trace->compare(u, v);
+            if (candidate < dist[v]) {
+                dist[v] = candidate;
+                parent[v] = u;
+                queue.update(v, candidate);
+            }
+        }
+    }
+    if (stats) *stats = queue.getStats();
+}
+
+void dijkstra(const Graph& g, VertexId source, vector<Distance>& dist, vector<VertexId>& parent,
+              PriorityQueueKind queue, StepTrace* trace, PriorityQueueStats* stats) {
+    switch (queue) {
+        case PriorityQueueKind::LazyBinary:
+            runDijkstra<LazyDeletionQueue<StdBinaryHeap>>(g, source, dist, parent, trace, stats);
+            break;
+        case PriorityQueueKind::IndexedDary:
+            runDijkstra<IndexedDaryHeap<4>>(g, source, dist, parent, trace, stats);
+            break;
+        case PriorityQueueKind::Pairing:
+            runDijkstra<PairingHeap>(g, source, dist, parent, trace, stats);
+            break;
+        case PriorityQueueKind::Radix:
+            runDijkstra<LazyDeletionQueue<RadixHeap>>(g, source, dist, parent, trace, stats);
+            break;
+        case PriorityQueueKind::MinHeap:
+            runDijkstra<LazyDeletionQueue<MinHeapAdapter>>(g, source, dist, parent, trace, stats);
+            break;
+    }
+}
@@ -0,0 +1,216 @@
+// algorithms/graph/floyd_warshall.cpp
+#include "graph_algorithms.h"
+#include "../../utilities/cpu_features.h"
+#include "../../utilities/parallel.h"
+#include <algorithm>
+
+#if defined(__SSE2__) || defined(__AVX2__)
+#include <immintrin.h>
+#elif defined(__ARM_NEON)
+#include <arm_neon.h>
+#endif
+
+using std::size_t;
+using Value = DistanceMatrix::Value;
+
+namespace {
+
+// d[i][k] at or above this counts as unreachable, so a + d[k][j] can never overflow
+constexpr Value UNREACHABLE = DistanceMatrix::INF / 2;
+
+// Row kernels: c[j] = min(c[j], a + b[j]) for j in [0, count)
+struct ScalarRow {
+    static void apply(Value* c, const Value* b, Value a, size_t count) {
+        for (size_t j = 0; j < count; ++j) c[j] = std::min(c[j], a + b[j]); // Branch-free: always store
+    }
+};
+
+#if defined(CPU_DISPATCH_X86) || defined(__AVX2__)
+struct Avx2Row {
+    CPU_TARGET("avx2") static void apply(Value* c, const Value* b, Value a, size_t count) {
+        size_t j = 0;
+        __m256i va = _mm256_set1_epi32(a);
+        for (; j + 8 <= count; j += 8) {
+            __m256i sum = _mm256_add_epi32(va, _mm256_loadu_si256(reinterpret_cast<const __m256i*>(b + j)));
+            __m256i cur = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(c + j));
+            _mm256_storeu_si256(reinterpret_cast<__m256i*>(c + j), _mm256_min_epi32(cur, sum));
+        }
+        ScalarRow::apply(c + j, b + j, a, count - j);
+    }
+};
+#endif
+
+#if defined(CPU_DISPATCH_X86) || defined(__SSE4_1__)
+struct Sse41Row {
+    CPU_TARGET("sse4.1") static void apply(Value* c, const Value* b, Value a, size_t count) {
+        size_t j = 0;
+        __m128i va = _mm_set1_epi32(a);
+        for (; j + 4 <= count; j += 4) {
+            __m128i sum = _mm_add_epi32(va, _mm_loadu_si128(reinterpret_cast<const __m128i*>(b + j)));
+            __m128i cur = _mm_loadu_si128(reinterpret_cast<const __m128i*>(c + j));
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(c + j), _mm_min_epi32(cur, sum));
+        }
+        ScalarRow::apply(c + j, b + j, a, count - j);
+    }
+};
+#endif
+
+// The baseline: SSE2 (no 32-bit min, so select with a compare mask), NEON or scalar
+struct BaselineRow {
+    static void apply(Value* c, const Value* b, Value a, size_t count) {
+        size_t j = 0;
+#if defined(__SSE2__)
+        __m128i va = _mm_set1_epi32(a);
+        for (; j + 4 <= count; j += 4) {
+            __m128i sum = _mm_add_epi32(va, _mm_loadu_si128(reinterpret_cast<const __m128i*>(b + j)));
+            __m128i cur = _mm_loadu_si128(reinterpret_cast<const __m128i*>(c + j));
+            __m128i smaller = _mm_cmplt_epi32(sum, cur);
+            __m128i result = _mm_or_si128(_mm_and_si128(smaller, sum), _mm_andnot_si128(smaller, cur));
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(c + j), result);
+        }
+#elif defined(__ARM_NEON)
+        int32x4_t va = vdupq_n_s32(a);
+        for (; j + 4 <= count; j += 4) {
+            vst1q_s32(c + j, vminq_s32(vld1q_s32(c + j), vaddq_s32(va, vld1q_s32(b + j))));
+        }
+#endif
+        ScalarRow::apply(c + j, b + j, a, count - j);
+    }
+};
+
+// The textbook triple loop over the whole matrix
+void naiveFloydWarshall(DistanceMatrix& d) {
+    size_t n = d.size();
+    for (size_t k = 0; k < n; ++k) {
+        const Value* rowK = d.row(k);
+        for (size_t i = 0; i < n; ++i) {
+            Value* rowI = d.row(i);
+            Value a = rowI[k];
+            if (a >= UNREACHABLE) continue;
+            for (size_t j = 0; j < n; ++j) {
+                if (a + rowK[j] < rowI[j]) rowI[j] = a + rowK[j];
+            }
+        }
+    }
+}
+
+// Relaxes tile (ti, tj) through the vertices of k-block kb. Tiles on the matrix
+// edge may be partial. k stays outermost, which keeps the diagonal tile correct.
+// Always inlined, so each wrapper below compiles the loop with its kernel's
+// instruction set and the kernel inlines into it.
+template <typename Row>
+#if defined(__GNUC__) || defined(__clang__)
+__attribute__((always_inline))
+#endif
+inline void relaxTile(DistanceMatrix& d, size_t tile, size_t ti, size_t tj, size_t kb) {
+    size_t n = d.size();
+    size_t rowEnd = std::min(n, (ti + 1) * tile);
+    size_t colBegin = tj * tile, colCount = std::min(n, colBegin + tile) - colBegin;
+    size_t kEnd = std::min(n, (kb + 1) * tile);
+    for (size_t k = kb * tile; k < kEnd; ++k) {
+        const Value* rowK = d.row(k) + colBegin;
+        for (size_t i = ti * tile; i < rowEnd; ++i) {
+            Value* rowI = d.row(i);
+            Value a = rowI[k];
+            if (a >= UNREACHABLE) continue;
+            Row::apply(rowI + colBegin, rowK, a, colCount);
+        }
+    }
+}
+
+using TileUpdate = void (*)(DistanceMatrix& d, size_t tile, size_t ti, size_t tj, size_t kb);
+
+void scalarTile(DistanceMatrix& d, size_t tile, size_t ti, size_t tj, size_t kb) {
+    relaxTile<ScalarRow>(d, tile, ti, tj, kb);
+}
+void baselineTile(DistanceMatrix& d, size_t tile, size_t ti, size_t tj, size_t kb) {
+    relaxTile<BaselineRow>(d, tile, ti, tj, kb);
+}
+#if defined(CPU_DISPATCH_X86) || defined(__AVX2__)
+CPU_TARGET("avx2") void avx2Tile(DistanceMatrix& d, size_t tile, size_t ti, size_t tj, size_t kb) {
+    relaxTile<Avx2Row>(d, tile, ti, tj, kb);
+}
+#endif
+#if defined(CPU_DISPATCH_X86) || defined(__SSE4_1__)
+CPU_TARGET("sse4.1") void sse41Tile(DistanceMatrix& d, size_t tile, size_t ti, size_t tj, size_t kb) {
+    relaxTile<Sse41Row>(d, tile, ti, tj, kb);
+}
+#endif
+
+// The widest kernel this CPU runs
+TileUpdate vectorTile() {
+#if defined(CPU_DISPATCH_X86)
+    if (cpuHasAvx2()) return avx2Tile;
+    if (cpuHasSse41()) return sse41Tile;
+#elif defined(__AVX2__)
+    return avx2Tile;
+#elif defined(__SSE4_1__)
+    return sse41Tile;
+#endif
+    return baselineTile;
+}
+
+// Three phases per k-block: the diagonal tile alone, then its row and column
+// (each depends only on the diagonal), then every remaining tile (each depends
+// only on one row tile and one column tile), so phases 2 and 3 fan out freely.
+void blockedFloydWarshall(DistanceMatrix& d, size_t tile, unsigned threads, TileUpdate updateTile, StepTrace* trace) {
+    size_t tiles = (d.size() + tile - 1) / tile;
+    for (size_t kb = 0; kb < tiles; ++kb) {
+        if (trace) {
+            trace->tile(kb, kb, 1);
+            for (size_t t = 0; t < tiles; ++t) {
+                if (t == kb) continue;
+                trace->tile(kb, t, 2);
+                trace->tile(t, kb, 2);
+            }
+            for (size_t ti = 0; ti < tiles; ++ti) {
+                for (size_t tj = 0; tj < tiles; ++tj) {
+                    if (ti != kb && tj != kb) trace->tile(ti, tj, 3);
+                }
+            }
+        }
+
+        updateTile(d, tile, kb, kb, kb);
+        parallelFor(0, 2 * tiles, 1, threads, [&](size_t b, size_t e, unsigned) {
+            for (size_t t = b; t < e; ++t) {
+                size_t other = t % tiles;
+                if (other == kb) continue;
+                if (t < tiles) updateTile(d, tile, kb, other, kb);
+                else updateTile(d, tile, other, kb, kb);
+            }
+        });
+        // One task per tile row keeps the row's column tile (ti, kb) hot across its tiles
+        parallelFor(0, tiles, 1, threads, [&](size_t b, size_t e, unsigned) {
+            for (size_t ti = b; ti < e; ++ti) {
+                if (ti == kb) continue;
+                for (size_t tj = 0; tj < tiles; ++tj) {
+                    if (tj != kb) updateTile(d, tile, ti, tj, kb);
+                }
+            }
+        });
+    }
+}
+
+} // namespace
+
+bool floydWarshall(DistanceMatrix& dist, const FloydWarshallOptions& options, StepTrace* trace) {
+    size_t n = dist.size();
+    size_t tile = std::max<size_t>(options.tile, 1);
+    switch (options.variant) {
+        case FloydWarshallVariant::Naive:      naiveFloydWarshall(dist); break;
+        case FloydWarshallVariant::Blocked:    blockedFloydWarshall(dist, tile, 1, scalarTile, trace); break;
+        case FloydWarshallVariant::Vectorized: blockedFloydWarshall(dist, tile, 1, vectorTile(), trace); break;
+        case FloydWarshallVariant::Parallel:   blockedFloydWarshall(dist, tile, options.threads, vectorTile(), trace); break;
+    }
+    if (trace) trace->addComparisons(static_cast<std::uint64_t>(n) * n * n);
+
+    bool negativeCycle = false;
+    for (size_t i = 0; i < n; ++i) {
+        Value* row = dist.row(i);
+        for (size_t j = 0; j < n; ++j) {
+            if (row[j] >= UNREACHABLE) row[j] = DistanceMatrix::INF;
+        }
+        if (row[i] < 0) negativeCycle = true;
+    }
+    return !negativeCycle;
+}
@@ -0,0 +1,151 @@
+// algorithms/graph/graph_algorithms.h
+#pragma once
+#include "../../data_structures/graphs/graph.h"
+#include "../../data_structures/graphs/distance_matrix.h"
+#include "../../data_structures/queues_stacks/priority_queue.h"
+#include "../../utilities/types.h"
+#include "../../utilities/step_trace.h"
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// Graph algorithms run on the frozen CSR Graph. With a trace they report
+// every vertex reached (visit) and every edge relaxation attempt (compare).
+
+enum class BfsMode {
+    Reference, // Single-threaded queue BFS, kept for comparison
+    Parallel   // Level-synchronous, multithreaded, bitmap visited set
+};
+
+struct BfsOptions {
+    BfsMode mode = BfsMode::Parallel;
+    unsigned threads = 0;            // 0 = all hardware threads
+    bool directionOptimizing = true; // Switch to bottom-up steps on large frontiers
+    double alpha = 15.0;             // Bottom-up once frontier arcs > unexplored arcs / alpha
+    double beta = 18.0;              // Back to top-down once the frontier < n / beta vertices
+    // In-arcs for bottom-up steps on directed graphs; reversed() is built on demand if null
+    const Graph* transpose = nullptr;
+};
+
+struct BfsResult {
+    std::vector<VertexId> parent;     // NO_VERTEX when unreached; the source is its own parent
+    std::vector<std::uint32_t> depth; // Level of each vertex, NO_VERTEX when unreached
+    std::uint32_t levels = 0;
+    std::uint32_t bottomUpLevels = 0; // Levels expanded bottom-up
+};
+
+// BFS tree from source. With a trace, each level is reported as a frontier
+// event followed by a visit for every vertex in it.
+BfsResult breadthFirstSearch(const Graph& g, VertexId source, const BfsOptions& options = {},
+                             StepTrace* trace = nullptr);
+
+// Iterative DFS from source; returns vertices in preorder
+std::vector<VertexId> depthFirstSearch(const Graph& g, VertexId source, StepTrace* trace = nullptr);
+
+// Single-source shortest paths with negative weights allowed. Returns false if a
+// negative cycle is reachable from source; dist[v] is INF_DISTANCE when unreachable.
+bool bellmanFord(const Graph& g, VertexId source, std::vector<Distance>& dist, StepTrace* trace = nullptr);
+
+// Single-source shortest paths for non-negative weights. parent[v] is the
+// previous vertex on a shortest path (the source is its own parent). With a
+// trace, every vertex is visited when it is settled. stats, if given, receives
+// the queue's push/pop/decrease-key counts.
+void dijkstra(const Graph& g, VertexId source, std::vector<Distance>& dist, std::vector<VertexId>& parent,
+              PriorityQueueKind queue = PriorityQueueKind::IndexedDary, StepTrace* trace = nullptr,
+              PriorityQueueStats* stats = nullptr);
+
+// Minimum spanning forest of an undirected graph: parent[v] is v's tree
+// neighbour (roots are their own parent) and totalWeight the forest weight.
+// Returns false for directed graphs and for the radix queue, whose keys must be
+// monotone (Prim's keys are edge weights and are not).
+bool prim(const Graph& g, std::vector<VertexId>& parent, Distance& totalWeight,
+          PriorityQueueKind queue = PriorityQueueKind::IndexedDary, StepTrace* trace = nullptr,
+          PriorityQueueStats* stats = nullptr);
+
+enum class FloydWarshallVariant {
+    Naive,      // Plain k-i-j triple loop, kept for comparison
+    Blocked,    // Cache-sized tiles, scalar inner loop
+    Vectorized, // Tiles with a SIMD min-plus inner loop
+    Parallel    // Vectorized tiles, each k-phase's independent tiles spread over threads
+};
+
+inline const std::vector<std::string> FLOYD_WARSHALL_VARIANT_NAMES = {
+    "naive", "blocked", "blocked-simd", "parallel"
+};
+
+struct FloydWarshallOptions {
+    FloydWarshallVariant variant = FloydWarshallVariant::Parallel;
+    unsigned threads = 0;   // Parallel only; 0 = all hardware threads
+    std::size_t tile = 64;  // 64x64 int32 tiles: three of them fit in L1/L2
+};
+
+// All-pairs shortest paths in place on dist (usually DistanceMatrix::fromGraph).
+// Returns false if there is a negative cycle. Unreachable pairs end as
+// DistanceMatrix::INF. With a trace, the blocked variants report each tile
+// update (phase 1: diagonal tile, 2: its row and column, 3: the rest).
+bool floydWarshall(DistanceMatrix& dist, const FloydWarshallOptions& options = {}, StepTrace* trace = nullptr);
+
+enum class KruskalVariant {
+    Classic,      // std::sort every edge, then one union-find pass
+    ParallelSort, // Same pass after a multithreaded edge sort
+    Filter        // Filter-Kruskal: sort only light edges, drop heavy ones already connected
+};
+
+inline const std::vector<std::string> KRUSKAL_VARIANT_NAMES = {"classic", "parallel-sort", "filter"};
+
+struct KruskalOptions {
+    KruskalVariant variant = KruskalVariant::Filter;
+    unsigned threads = 0; // 0 = all hardware threads
+};
+
+// Minimum spanning forest of an undirected graph: forest receives its edges and
+// totalWeight their sum. Returns false for directed graphs. With a trace, every
+// edge examined is a compare and every accepted edge a visit (to, from).
+bool kruskal(const Graph& g, std::vector<Edge>& forest, Distance& totalWeight,
+             const KruskalOptions& options = {}, StepTrace* trace = nullptr);
+
+// Number of connected components (weakly connected when directed), found by
+// uniting every arc's endpoints from several threads with the concurrent union-find
+std::uint32_t connectedComponentCount(const Graph& g, unsigned threads = 0);
+
+// Graph algorithms that run on the CSR Graph. Floyd-Warshall is left out: it
+// runs on a DistanceMatrix and has its own view and workload.
+inline bool isGraphAlgorithm(Algorithm alg) {
+    switch (alg) {
+        case Algorithm::BellmanFord: case Algorithm::BFS: case Algorithm::DFS:
+        case Algorithm::Dijkstra: case Algorithm::Kruskal: case Algorithm::Prim:
+            return true;
+        default:
+            return false;
+    }
+}
+
+// Dispatches on the Algorithm enum with default options; returns false if alg is not a graph algorithm.
+inline bool runGraphAlgorithm(Algorithm alg, const Graph& g, VertexId source, StepTrace* trace = nullptr) {
+    switch (alg) {
+        case Algorithm::BellmanFord: {
+            std::vector<Distance> dist;
+            bellmanFord(g, source, dist, trace);
+            return true;
+        }
+        case Algorithm::BFS: breadthFirstSearch(g, source, BfsOptions{}, trace); return true;
+        case Algorithm::DFS: depthFirstSearch(g, source, trace); return true;
+        case Algorithm::Dijkstra: {
+            std::vector<Distance> dist;
+            std::vector<VertexId> parent;
+            dijkstra(g, source, dist, parent, PriorityQueueKind::IndexedDary, trace);
+            return true;
+        }
+        case Algorithm::Kruskal: {
+            std::vector<Edge> forest;
+            Distance total = 0;
+            return kruskal(g, forest, total, KruskalOptions{}, trace);
+        }
+        case Algorithm::Prim: {
+            std::vector<VertexId> parent;
+            Distance total = 0;
+            return prim(g, parent, total, PriorityQueueKind::IndexedDary, trace);
+        }
+        default: return false;
+    }
+}
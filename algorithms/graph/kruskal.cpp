@@ -0,0 +1,127 @@
+// algorithms/graph/kruskal.cpp
+#include "graph_algorithms.h"
+#include "../../data_structures/maps_sets/disjoint_set.h"
+#include "../../utilities/parallel.h"
+#include <algorithm>
+
+using std::vector;
+using std::size_t;
+
+namespace {
+
+// Below this many edges filter-Kruskal stops partitioning and sorts directly
+constexpr size_t FILTER_BASE_CASE = size_t(1) << 12;
+// Filter passes smaller than this are not worth starting threads for
+constexpr size_t PARALLEL_FILTER_MIN = size_t(1) << 16;
+
+bool lighter(const Edge& a, const Edge& b) {
+    return a.weight < b.weight;
+}
+
+struct KruskalState {
+    DisjointSet sets;
+    vector<Edge>& forest;
+    Distance& totalWeight;
+    StepTrace* trace;
+    unsigned threads;
+};
+
+// Scans edges in weight order; stops early once the forest is spanning
+void kruskalPass(KruskalState& st, vector<Edge>::iterator first, vector<Edge>::iterator last) {
+    for (auto it = first; it != last && st.sets.setCount() > 1; ++it) {
+        if (st.trace) st.trace->compare(it->from, it->to);
+        if (!st.sets.unite(it->from, it->to)) continue;
+        st.forest.push_back(*it);
+        st.totalWeight += it->weight;
+        if (st.trace) st.trace->visit(it->to, it->from);
+    }
+}
+
+// Removes edges whose endpoints are already connected. Only finds run here, so
+// the concurrent (CAS path-halving) find is safe from every thread at once.
+vector<Edge>::iterator filterConnected(KruskalState& st, vector<Edge>::iterator first, vector<Edge>::iterator last) {
+    size_t n = static_cast<size_t>(last - first);
+    if (n < PARALLEL_FILTER_MIN || resolveThreadCount(st.threads) == 1) {
+        return std::remove_if(first, last, [&](const Edge& e) { return st.sets.find(e.from) == st.sets.find(e.to); });
+    }
+    // Mark in parallel, then compact sequentially
+    vector<char> keep(n);
+    parallelFor(0, n, 4096, st.threads, [&](size_t b, size_t e, unsigned) {
+        for (size_t i = b; i < e; ++i) {
+            const Edge& edge = first[static_cast<std::ptrdiff_t>(i)];
+            keep[i] = st.sets.findConcurrent(edge.from) != st.sets.findConcurrent(edge.to);
+        }
+    });
+    auto out = first;
+    for (size_t i = 0; i < n; ++i) {
+        if (keep[i]) *out++ = first[static_cast<std::ptrdiff_t>(i)];
+    }
+    return out;
+}
+
+// Osipov/Sanders/Singler: partition around a sampled pivot weight, solve the light
+// half, then drop heavy edges that the light half already connected before recursing.
+// On sparse random graphs most heavy edges never get sorted at all.
+void filterKruskal(KruskalState& st, vector<Edge>::iterator first, vector<Edge>::iterator last) {
+    size_t n = static_cast<size_t>(last - first);
+    if (n == 0 || st.sets.setCount() <= 1) return;
+    if (n <= FILTER_BASE_CASE) {
+        std::sort(first, last, lighter);
+        kruskalPass(st, first, last);
+        return;
+    }
+    // Median of three spread-out samples as the pivot
+    Weight a = first[0].weight, b = first[static_cast<std::ptrdiff_t>(n / 2)].weight, c = last[-1].weight;
+    Weight pivot = std::max(std::min(a, b), std::min(std::max(a, b), c));
+    auto middle = std::partition(first, last, [pivot](const Edge& e) { return e.weight <= pivot; });
+    if (middle == last) { // Pivot is the maximum: split off the edges equal to it instead
+        middle = std::partition(first, last, [pivot](const Edge& e) { return e.weight < pivot; });
+        if (middle == first) { // All weights equal, so any order is sorted
+            kruskalPass(st, first, last);
+            return;
+        }
+    }
+    filterKruskal(st, first, middle);
+    auto kept = filterConnected(st, middle, last);
+    filterKruskal(st, middle, kept);
+}
+
+} // namespace
+
+bool kruskal(const Graph& g, vector<Edge>& forest, Distance& totalWeight, const KruskalOptions& options, StepTrace* trace) {
+    forest.clear();
+    totalWeight = 0;
+    if (g.isDirected()) return false;
+
+    vector<Edge> edges = g.edgeList();
+    forest.reserve(g.vertexCount());
+    KruskalState st{DisjointSet(g.vertexCount()), forest, totalWeight, trace, options.threads};
+    switch (options.variant) {
+        case KruskalVariant::Classic:
+            std::sort(edges.begin(), edges.end(), lighter);
+            kruskalPass(st, edges.begin(), edges.end());
+            break;
+        case KruskalVariant::ParallelSort:
+            parallelSort(edges, lighter, options.threads);
+            kruskalPass(st, edges.begin(), edges.end());
+            break;
+        case KruskalVariant::Filter:
+            filterKruskal(st, edges.begin(), edges.end());
+            break;
+    }
+    return true;
+}
+
+std::uint32_t connectedComponentCount(const Graph& g, unsigned threads) {
+    DisjointSet sets(g.vertexCount());
+    const vector<std::uint64_t>& offsets = g.offsets();
+    const vector<VertexId>& targets = g.targets();
+    parallelFor(0, g.vertexCount(), 1024, threads, [&](size_t b, size_t e, unsigned) {
+        for (size_t u = b; u < e; ++u) {
+            for (std::uint64_t a = offsets[u]; a < offsets[u + 1]; ++a) {
+                sets.uniteConcurrent(static_cast<VertexId>(u), targets[a]);
+            }
+        }
+    });
+    return sets.setCount();
+}
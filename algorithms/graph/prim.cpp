@@ -0,0 +1,66 @@
+// algorithms/graph/prim.cpp
+#include "graph_algorithms.h"
+
+using std::vector;
+using std::size_t;
+
+template <typename Queue>
+static void runPrim(const Graph& g, vector<VertexId>& parent, Distance& totalWeight,
+                    StepTrace* trace, PriorityQueueStats* stats) {
+    VertexId n = g.vertexCount();
+    parent.assign(n, NO_VERTEX);
+    totalWeight = 0;
+    vector<Distance> key(n, INF_DISTANCE);
+    vector<char> inTree(n, 0);
+
+    // One queue for the whole forest: a popped vertex stays popped across roots
+    Queue queue;
+    queue.reset(n);
+    QueueItem item;
+    for (VertexId root = 0; root < n; ++root) {
+        if (inTree[root]) continue;
+        key[root] = 0;
+        parent[root] = root;
+        queue.update(root, 0);
+        while (queue.pop(item)) {
+            VertexId u = item.id;
+            inTree[u] = 1;
+            totalWeight += item.key;
+            if (trace) trace->visit(u, parent[u]);
+            Graph::NeighborRange range = g.neighbors(u);
+            for (size_t i = 0; i < range.size(); ++i) {
+                VertexId v = range.target(i);
+                Weight w = range.weight(i);
+                if (trace) trace->compare(u, v);
+                if (!inTree[v] && w < key[v]) {
+                    key[v] = w;
+                    parent[v] = u;
+                    queue.update(v, w);
+                }
+            }
+        }
+    }
+    if (stats) *stats = queue.getStats();
+}
+
+bool prim(const Graph& g, vector<VertexId>& parent, Distance& totalWeight,
+          PriorityQueueKind queue, StepTrace* trace, PriorityQueueStats* stats) {
+    if (g.isDirected()) return false;
+    switch (queue) {
+        case PriorityQueueKind::LazyBinary:
+            runPrim<LazyDeletionQueue<StdBinaryHeap>>(g, parent, totalWeight, trace, stats);
+            return true;
+        case PriorityQueueKind::IndexedDary:
+            runPrim<IndexedDaryHeap<4>>(g, parent, totalWeight, trace, stats);
+            return true;
+        case PriorityQueueKind::Pairing:
+            runPrim<PairingHeap>(g, parent, totalWeight, trace, stats);
+            return true;
+        case PriorityQueueKind::MinHeap:
+            runPrim<LazyDeletionQueue<MinHeapAdapter>>(g, parent, totalWeight, trace, stats);
+            return true;
+        case PriorityQueueKind::Radix:
+            return false;
+    }
+    return false;
+}
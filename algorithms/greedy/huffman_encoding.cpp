@@ -0,0 +1,328 @@
+// algorithms/greedy/huffman_encoding.cpp
+#include "huffman_encoding.h"
+#include "../../data_structures/trees/min_heap.h"
+#include <algorithm>
+#include <chrono>
+#include <fstream>
+#include <istream>
+#include <memory>
+#include <ostream>
+
+using std::vector;
+using std::size_t;
+
+namespace {
+
+// Heap keys are weight << WEIGHT_SHIFT | node, so of two equal weights the
+// older node pops first, which keeps the tree shallow
+constexpr unsigned WEIGHT_SHIFT = 16;
+constexpr std::uint64_t NODE_MASK = (std::uint64_t(1) << WEIGHT_SHIFT) - 1;
+
+// Stream layout: the magic, then per chunk a block of
+//   plain length (4 bytes LE), payload length (4 bytes LE),
+//   256 code lengths packed two to a byte (even symbol in the high nibble),
+//   payload: the chunk's codes
+constexpr char STREAM_MAGIC[4] = {'H', 'U', 'F', '1'};
+constexpr size_t BLOCK_HEADER_BYTES = 8 + HUFFMAN_SYMBOLS / 2;
+
+size_t maxPayloadBytes(size_t plainBytes) {
+    return (plainBytes * HUFFMAN_MAX_CODE_LENGTH + 7) / 8;
+}
+
+void storeLittleEndian32(std::uint8_t* p, std::uint32_t v) {
+    for (int k = 0; k < 4; ++k) p[k] = static_cast<std::uint8_t>(v >> (8 * k));
+}
+
+std::uint32_t loadLittleEndian32(const std::uint8_t* p) {
+    return std::uint32_t(p[0]) | std::uint32_t(p[1]) << 8 | std::uint32_t(p[2]) << 16 | std::uint32_t(p[3]) << 24;
+}
+
+// Compilers turn these byte loops into one load or store and a byte swap
+void storeBigEndian32(std::uint8_t* p, std::uint32_t v) {
+    for (int k = 0; k < 4; ++k) p[k] = static_cast<std::uint8_t>(v >> (24 - 8 * k));
+}
+
+std::uint64_t loadBigEndian64(const std::uint8_t* p) {
+    std::uint64_t v = 0;
+    for (int k = 0; k < 8; ++k) v = v << 8 | p[k];
+    return v;
+}
+
+// One greedy build into lengths; returns the longest code
+unsigned buildLengths(const HuffmanCounts& counts, HuffmanLengths& lengths, HuffmanTree* tree) {
+    vector<std::uint8_t> symbols;
+    for (size_t s = 0; s < HUFFMAN_SYMBOLS; ++s) {
+        if (counts[s] > 0) symbols.push_back(static_cast<std::uint8_t>(s));
+    }
+    size_t k = symbols.size();
+    lengths.fill(0);
+    if (tree) {
+        tree->symbols = symbols;
+        tree->weights.clear();
+        tree->merges.clear();
+        for (std::uint8_t s : symbols) tree->weights.push_back(counts[s]);
+    }
+    if (k == 0) return 0;
+    if (k == 1) { // A lone symbol still takes one bit
+        lengths[symbols[0]] = 1;
+        return 1;
+    }
+
+    vector<std::uint64_t> keys(k);
+    for (size_t i = 0; i < k; ++i) keys[i] = counts[symbols[i]] << WEIGHT_SHIFT | i;
+    MinHeap<std::uint64_t> heap(std::move(keys));
+    vector<std::uint32_t> parent(2 * k - 1);
+    for (std::uint32_t next = static_cast<std::uint32_t>(k); heap.size() > 1; ++next) {
+        std::uint64_t a = heap.pop();
+        std::uint64_t b = heap.pop();
+        std::uint32_t x = static_cast<std::uint32_t>(a & NODE_MASK), y = static_cast<std::uint32_t>(b & NODE_MASK);
+        parent[x] = parent[y] = next;
+        std::uint64_t weight = (a >> WEIGHT_SHIFT) + (b >> WEIGHT_SHIFT);
+        heap.push(weight << WEIGHT_SHIFT | next);
+        if (tree) {
+            tree->merges.push_back({x, y});
+            tree->weights.push_back(weight);
+        }
+    }
+    // Every node is made after its children, so counting down from the root finds each depth
+    vector<std::uint8_t> depth(2 * k - 1, 0);
+    for (size_t v = 2 * k - 2; v-- > 0;) depth[v] = static_cast<std::uint8_t>(depth[parent[v]] + 1);
+    unsigned longest = 0;
+    for (size_t i = 0; i < k; ++i) {
+        lengths[symbols[i]] = depth[i];
+        longest = std::max<unsigned>(longest, depth[i]);
+    }
+    return longest;
+}
+
+} // namespace
+
+// Four tables, so a run of one byte value doesn't wait on its own last increment
+HuffmanCounts countSymbols(const std::uint8_t* data, size_t n) {
+    std::uint64_t partial[4][HUFFMAN_SYMBOLS] = {};
+    size_t i = 0;
+    for (; i + 4 <= n; i += 4) {
+        ++partial[0][data[i]];
+        ++partial[1][data[i + 1]];
+        ++partial[2][data[i + 2]];
+        ++partial[3][data[i + 3]];
+    }
+    for (; i < n; ++i) ++partial[0][data[i]];
+    HuffmanCounts counts;
+    for (size_t s = 0; s < HUFFMAN_SYMBOLS; ++s) counts[s] = partial[0][s] + partial[1][s] + partial[2][s] + partial[3][s];
+    return counts;
+}
+
+HuffmanCode buildHuffmanCode(const HuffmanCounts& counts, HuffmanTree* tree) {
+    HuffmanCounts scaled = counts;
+    HuffmanLengths lengths;
+    while (buildLengths(scaled, lengths, tree) > HUFFMAN_MAX_CODE_LENGTH) {
+        for (std::uint64_t& c : scaled) {
+            if (c > 0) c = 1 + c / 2;
+        }
+    }
+    HuffmanCode code;
+    canonicalHuffmanCode(lengths, code);
+    return code;
+}
+
+bool canonicalHuffmanCode(const HuffmanLengths& lengths, HuffmanCode& code) {
+    std::uint32_t perLength[HUFFMAN_MAX_CODE_LENGTH + 1] = {};
+    for (std::uint8_t l : lengths) {
+        if (l > HUFFMAN_MAX_CODE_LENGTH) return false;
+        ++perLength[l];
+    }
+    perLength[0] = 0;
+    // First code of each length: one past the last of the length before, shifted
+    std::uint32_t next[HUFFMAN_MAX_CODE_LENGTH + 1] = {};
+    std::uint32_t c = 0;
+    for (unsigned len = 1; len <= HUFFMAN_MAX_CODE_LENGTH; ++len) {
+        c = (c + perLength[len - 1]) << 1;
+        next[len] = c;
+        if (c + perLength[len] > (std::uint32_t(1) << len)) return false;
+    }
+    code.lengths = lengths;
+    for (size_t s = 0; s < HUFFMAN_SYMBOLS; ++s) {
+        code.codes[s] = lengths[s] > 0 ? static_cast<std::uint16_t>(next[lengths[s]]++) : 0;
+    }
+    return true;
+}
+
+size_t huffmanEncode(const std::uint8_t* data, size_t n, const HuffmanCode& code, vector<std::uint8_t>& out) {
+    // Code and length side by side, one load per symbol
+    std::uint32_t entries[HUFFMAN_SYMBOLS];
+    for (size_t s = 0; s < HUFFMAN_SYMBOLS; ++s) entries[s] = std::uint32_t(code.codes[s]) << 8 | code.lengths[s];
+
+    size_t base = out.size();
+    out.resize(base + maxPayloadBytes(n) + 8);
+    std::uint8_t* p = out.data() + base;
+    std::uint64_t buffer = 0; // The low `pending` bits are waiting to be written
+    unsigned pending = 0;
+    auto put = [&](std::uint8_t s) {
+        std::uint32_t e = entries[s];
+        unsigned length = e & 0xFF;
+        buffer = buffer << length | e >> 8;
+        pending += length;
+    };
+    // Two codes of at most 12 bits on top of fewer than 32 pending fit in the 64-bit buffer
+    size_t i = 0;
+    for (; i + 2 <= n; i += 2) {
+        put(data[i]);
+        put(data[i + 1]);
+        if (pending >= 32) {
+            pending -= 32;
+            storeBigEndian32(p, static_cast<std::uint32_t>(buffer >> pending));
+            p += 4;
+        }
+    }
+    if (i < n) put(data[i]);
+    size_t bits = static_cast<size_t>(p - (out.data() + base)) * 8 + pending;
+    while (pending >= 8) {
+        pending -= 8;
+        *p++ = static_cast<std::uint8_t>(buffer >> pending);
+    }
+    if (pending > 0) *p++ = static_cast<std::uint8_t>(buffer << (8 - pending));
+    out.resize(static_cast<size_t>(p - out.data()));
+    return bits;
+}
+
+HuffmanDecoder::HuffmanDecoder(const HuffmanCode& code) : table(size_t(1) << HUFFMAN_MAX_CODE_LENGTH, 0) {
+    // Every bit pattern that starts with a code decodes to it
+    for (size_t s = 0; s < HUFFMAN_SYMBOLS; ++s) {
+        unsigned length = code.lengths[s];
+        if (length == 0) continue;
+        size_t first = size_t(code.codes[s]) << (HUFFMAN_MAX_CODE_LENGTH - length);
+        size_t span = size_t(1) << (HUFFMAN_MAX_CODE_LENGTH - length);
+        std::fill_n(table.begin() + first, span, static_cast<std::uint16_t>(s << 4 | length));
+    }
+}
+
+bool HuffmanDecoder::decode(const std::uint8_t* bits, size_t byteCount, std::uint8_t* out, size_t n) const {
+    constexpr unsigned PEEK_SHIFT = 64 - HUFFMAN_MAX_CODE_LENGTH;
+    const std::uint8_t* p = bits;
+    const std::uint8_t* end = bits + byteCount;
+    // The top `available` bits of buffer are the next ones in the stream. A
+    // whole-word refill also leaves the bits after those in place; the next
+    // refill ORs the same bits over them, which changes nothing.
+    std::uint64_t buffer = 0;
+    unsigned available = 0;
+    auto refill = [&] {
+        if (end - p >= 8) {
+            buffer |= loadBigEndian64(p) >> available;
+            p += (63 - available) >> 3;
+            available |= 56;
+        } else {
+            while (available <= 56 && p < end) {
+                buffer |= std::uint64_t(*p++) << (56 - available);
+                available += 8;
+            }
+        }
+    };
+    const std::uint16_t* lookup = table.data();
+    bool invalid = false;
+    size_t i = 0;
+    // A refill leaves at least 56 bits: four codes' worth, decoded without checks
+    while (n - i >= 4) {
+        refill();
+        if (available < 4 * HUFFMAN_MAX_CODE_LENGTH) break;
+        for (int k = 0; k < 4; ++k) {
+            std::uint16_t e = lookup[buffer >> PEEK_SHIFT];
+            invalid |= e == 0;
+            unsigned length = e & 0xF;
+            out[i++] = static_cast<std::uint8_t>(e >> 4);
+            buffer <<= length;
+            available -= length;
+        }
+    }
+    for (; i < n; ++i) {
+        refill();
+        std::uint16_t e = lookup[buffer >> PEEK_SHIFT];
+        unsigned length = e & 0xF;
+        if (e == 0 || length > available) return false;
+        out[i] = static_cast<std::uint8_t>(e >> 4);
+        buffer <<= length;
+        available -= length;
+    }
+    return !invalid;
+}
+
+bool huffmanCompress(std::istream& in, std::ostream& out, HuffmanStreamStats* stats, HuffmanTree* firstTree) {
+    auto started = std::chrono::steady_clock::now();
+    if (firstTree) *firstTree = HuffmanTree();
+    HuffmanStreamStats totals;
+    // Not a vector: a chunk-sized buffer zeroed on every call would cost more than a short input
+    std::unique_ptr<std::uint8_t[]> chunk(new std::uint8_t[HUFFMAN_CHUNK_BYTES]);
+    vector<std::uint8_t> block;
+    out.write(STREAM_MAGIC, sizeof STREAM_MAGIC);
+    totals.packedBytes = sizeof STREAM_MAGIC;
+    while (in) {
+        in.read(reinterpret_cast<char*>(chunk.get()), HUFFMAN_CHUNK_BYTES);
+        size_t got = static_cast<size_t>(in.gcount());
+        if (got == 0) break;
+        HuffmanCode code = buildHuffmanCode(countSymbols(chunk.get(), got), totals.chunks == 0 ? firstTree : nullptr);
+        block.assign(BLOCK_HEADER_BYTES, 0);
+        for (size_t s = 0; s < HUFFMAN_SYMBOLS; ++s) block[8 + s / 2] |= code.lengths[s] << (s % 2 == 0 ? 4 : 0);
+        huffmanEncode(chunk.get(), got, code, block);
+        storeLittleEndian32(block.data(), static_cast<std::uint32_t>(got));
+        storeLittleEndian32(block.data() + 4, static_cast<std::uint32_t>(block.size() - BLOCK_HEADER_BYTES));
+        out.write(reinterpret_cast<const char*>(block.data()), static_cast<std::streamsize>(block.size()));
+        if (!out) return false;
+        totals.plainBytes += got;
+        totals.packedBytes += block.size();
+        ++totals.chunks;
+    }
+    if (in.bad() || !out.flush()) return false;
+    totals.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - started).count();
+    if (stats) *stats = totals;
+    return true;
+}
+
+bool huffmanDecompress(std::istream& in, std::ostream& out, HuffmanStreamStats* stats) {
+    auto started = std::chrono::steady_clock::now();
+    HuffmanStreamStats totals;
+    char magic[sizeof STREAM_MAGIC];
+    if (!in.read(magic, sizeof magic) || !std::equal(magic, magic + sizeof magic, STREAM_MAGIC)) return false;
+    totals.packedBytes = sizeof STREAM_MAGIC;
+    std::unique_ptr<std::uint8_t[]> plain(new std::uint8_t[HUFFMAN_CHUNK_BYTES]);
+    vector<std::uint8_t> payload;
+    std::uint8_t header[BLOCK_HEADER_BYTES];
+    for (;;) {
+        in.read(reinterpret_cast<char*>(header), BLOCK_HEADER_BYTES);
+        size_t got = static_cast<size_t>(in.gcount());
+        if (got == 0 && in.eof()) break;
+        if (got != BLOCK_HEADER_BYTES) return false;
+        // Bounds first, so a corrupt header can't ask for more memory than a chunk needs
+        size_t plainLength = loadLittleEndian32(header);
+        size_t payloadLength = loadLittleEndian32(header + 4);
+        if (plainLength == 0 || plainLength > HUFFMAN_CHUNK_BYTES || payloadLength > maxPayloadBytes(plainLength)) return false;
+        HuffmanLengths lengths;
+        for (size_t s = 0; s < HUFFMAN_SYMBOLS; ++s) lengths[s] = (header[8 + s / 2] >> (s % 2 == 0 ? 4 : 0)) & 0xF;
+        HuffmanCode code;
+        if (!canonicalHuffmanCode(lengths, code)) return false;
+        payload.resize(payloadLength);
+        in.read(reinterpret_cast<char*>(payload.data()), static_cast<std::streamsize>(payloadLength));
+        if (static_cast<size_t>(in.gcount()) != payloadLength) return false;
+        if (!HuffmanDecoder(code).decode(payload.data(), payloadLength, plain.get(), plainLength)) return false;
+        out.write(reinterpret_cast<const char*>(plain.get()), static_cast<std::streamsize>(plainLength));
+        if (!out) return false;
+        totals.plainBytes += plainLength;
+        totals.packedBytes += BLOCK_HEADER_BYTES + payloadLength;
+        ++totals.chunks;
+    }
+    if (in.bad() || !out.flush()) return false;
+    totals.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - started).count();
+    if (stats) *stats = totals;
+    return true;
+}
+
+bool huffmanCompressFile(const std::string& from, const std::string& to, HuffmanStreamStats* stats) {
+    std::ifstream in(from, std::ios::binary);
+    std::ofstream out(to, std::ios::binary | std::ios::trunc);
+    return in && out && huffmanCompress(in, out, stats);
+}
+
+bool huffmanDecompressFile(const std::string& from, const std::string& to, HuffmanStreamStats* stats) {
+    std::ifstream in(from, std::ios::binary);
+    std::ofstream out(to, std::ios::binary | std::ios::trunc);
+    return in && out && huffmanDecompress(in, out, stats);
+}
@@ -0,0 +1,89 @@
+// algorithms/greedy/huffman_encoding.h
+#pragma once
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <iosfwd>
+#include <string>
+#include <utility>
+#include <vector>
+
+// Byte-wise canonical Huffman coding. The tree is built greedily from a
+// min-heap (the two lightest nodes merge until one is left) and only its code
+// lengths are kept: codes of one length count up in symbol order, so a block
+// needs nothing but the 256 lengths to be decoded.
+//
+// Lengths are capped at HUFFMAN_MAX_CODE_LENGTH, which lets the decoder look at
+// that many bits at once and find symbol and length in one table entry instead
+// of walking the tree a bit at a time. When a build comes out deeper the counts
+// are halved (staying nonzero) and the tree rebuilt, as bzip2 does; that costs
+// a fraction of a percent of compression on skewed input and nothing otherwise.
+
+constexpr std::size_t HUFFMAN_SYMBOLS = 256;
+// 2^12 two-byte decode entries: 8 KiB, which stays in L1
+constexpr unsigned HUFFMAN_MAX_CODE_LENGTH = 12;
+// The streams work a chunk at a time, each with its own code, so memory stays
+// at a couple of chunks however long the input is
+constexpr std::size_t HUFFMAN_CHUNK_BYTES = std::size_t(1) << 20;
+
+using HuffmanCounts = std::array<std::uint64_t, HUFFMAN_SYMBOLS>;
+using HuffmanLengths = std::array<std::uint8_t, HUFFMAN_SYMBOLS>;
+
+struct HuffmanCode {
+    HuffmanLengths lengths{}; // 0 = symbol absent
+    std::array<std::uint16_t, HUFFMAN_SYMBOLS> codes{};
+};
+
+// The merges of one tree build in the order they happened, for drawing it.
+// Nodes 0..k-1 are the leaves, leaf i holding byte symbols[i]; merge i makes
+// node k + i from the two nodes it names, the lighter one first.
+struct HuffmanTree {
+    std::vector<std::uint8_t> symbols;
+    std::vector<std::uint64_t> weights; // By node
+    std::vector<std::pair<std::uint32_t, std::uint32_t>> merges;
+};
+
+HuffmanCounts countSymbols(const std::uint8_t* data, std::size_t n);
+// Counts must stay below 2^48. When tree is given it receives the final build.
+HuffmanCode buildHuffmanCode(const HuffmanCounts& counts, HuffmanTree* tree = nullptr);
+// The canonical code for a set of lengths, as read back from a block header.
+// False when the lengths are too long or over-subscribe the code space.
+bool canonicalHuffmanCode(const HuffmanLengths& lengths, HuffmanCode& code);
+
+// Appends the codes of data[0, n) to out, most significant bit first, through
+// a 64-bit buffer flushed 32 bits at a time; the last byte is zero-padded.
+// Returns the number of bits written.
+std::size_t huffmanEncode(const std::uint8_t* data, std::size_t n, const HuffmanCode& code,
+                          std::vector<std::uint8_t>& out);
+
+class HuffmanDecoder {
+public:
+    explicit HuffmanDecoder(const HuffmanCode& code);
+    // Decodes n symbols from bits[0, byteCount) into out. False when the bits
+    // run out first or hold a code that isn't in the table.
+    bool decode(const std::uint8_t* bits, std::size_t byteCount, std::uint8_t* out, std::size_t n) const;
+
+private:
+    // Symbol << 4 | length, indexed by the next HUFFMAN_MAX_CODE_LENGTH bits; 0 = no such code
+    std::vector<std::uint16_t> table;
+};
+
+struct HuffmanStreamStats {
+    std::uint64_t plainBytes = 0;
+    std::uint64_t packedBytes = 0; // Headers included
+    std::uint64_t chunks = 0;
+    double seconds = 0.0;          // The whole call, reads and writes included
+    double megabytesPerSecond() const { return seconds > 0.0 ? static_cast<double>(plainBytes) / seconds / 1e6 : 0.0; }
+    double bitsPerByte() const { return plainBytes > 0 ? 8.0 * static_cast<double>(packedBytes) / static_cast<double>(plainBytes) : 0.0; }
+};
+
+// Streams in to out, reading HUFFMAN_CHUNK_BYTES at a time and writing each
+// chunk as a block with its own code. firstTree receives the tree built for
+// the first chunk. False on a read or write error.
+bool huffmanCompress(std::istream& in, std::ostream& out, HuffmanStreamStats* stats = nullptr,
+                     HuffmanTree* firstTree = nullptr);
+// False on a read or write error or a malformed stream
+bool huffmanDecompress(std::istream& in, std::ostream& out, HuffmanStreamStats* stats = nullptr);
+// The same on files opened in binary mode; false also when one can't be opened
+bool huffmanCompressFile(const std::string& from, const std::string& to, HuffmanStreamStats* stats = nullptr);
+bool huffmanDecompressFile(const std::string& from, const std::string& to, HuffmanStreamStats* stats = nullptr);
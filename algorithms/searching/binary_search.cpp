@@ -0,0 +1,189 @@
+// algorithms/searching/binary_search.cpp
+#include "searching.h"
+#include <algorithm>
+#include <chrono>
+
+using std::vector;
+using std::size_t;
+using std::uint32_t;
+using std::uint64_t;
+
+namespace {
+
+// Queries a batched search keeps in flight; enough misses to cover memory latency
+constexpr size_t BATCH = 16;
+// Queries timed together, so reading the clock costs little per query
+constexpr size_t TIMING_BLOCK = 1024;
+// Eytzinger nodes per cache line: tree[16k .. 16k+15] are k's descendants four levels down
+constexpr size_t LINE_INTS = 64 / sizeof(int);
+
+inline void prefetch(const void* p) {
+#if defined(__GNUC__) || defined(__clang__)
+    __builtin_prefetch(p);
+#else
+    (void)p;
+#endif
+}
+
+// Number of trailing one bits of k
+inline unsigned trailingOnes(uint64_t k) {
+#if defined(__GNUC__) || defined(__clang__)
+    return static_cast<unsigned>(__builtin_ctzll(~k));
+#else
+    unsigned count = 0;
+    while (k & 1) { ++count; k >>= 1; }
+    return count;
+#endif
+}
+
+uint64_t classicLowerBound(const int* a, size_t n, int key, size_t& result) {
+    size_t lo = 0, hi = n;
+    uint64_t probes = 0;
+    while (lo < hi) {
+        size_t mid = lo + (hi - lo) / 2;
+        ++probes;
+        if (a[mid] < key) lo = mid + 1;
+        else hi = mid;
+    }
+    result = lo;
+    return probes;
+}
+
+// The answer stays in [base, base + len]; each step halves len whichever way it goes,
+// so the loop trip count is fixed and the move compiles to a conditional move
+uint64_t branchlessLowerBound(const int* a, size_t n, int key, size_t& result) {
+    if (n == 0) {
+        result = 0;
+        return 0;
+    }
+    const int* base = a;
+    size_t len = n;
+    uint64_t probes = 1;
+    while (len > 1) {
+        size_t half = len / 2;
+        prefetch(base + half / 2);
+        prefetch(base + half + half / 2);
+        base = (base[half] < key) ? base + half : base;
+        len -= half;
+        ++probes;
+    }
+    result = static_cast<size_t>(base - a) + (*base < key);
+    return probes;
+}
+
+} // namespace
+
+size_t binarySearch(const vector<int>& sorted, int key, StepTrace* trace) {
+    size_t lo = 0, hi = sorted.size();
+    while (lo < hi) {
+        size_t mid = lo + (hi - lo) / 2;
+        if (trace) {
+            trace->highlight(lo, hi - 1);
+            trace->compare(mid, mid);
+        }
+        if (sorted[mid] < key) lo = mid + 1;
+        else hi = mid;
+    }
+    return lo;
+}
+
+BinarySearcher::BinarySearcher(const vector<int>& data, BinarySearchVariant v) : sorted(data), variant(v) {
+    if (variant != BinarySearchVariant::Eytzinger) return;
+    size_t n = sorted.size();
+    // Pad so tree[0] starts a cache line; then every 16-node block of descendants does too
+    storage.assign(n + 1 + LINE_INTS, 0);
+    size_t misalignment = reinterpret_cast<std::uintptr_t>(storage.data()) % 64 / sizeof(int);
+    tree = storage.data() + (misalignment ? LINE_INTS - misalignment : 0);
+    rank.assign(n + 1, 0);
+    // An in-order walk of the implicit tree visits nodes in sorted order
+    size_t next = 0, k = 1;
+    vector<size_t> stack;
+    while (k <= n || !stack.empty()) {
+        if (k <= n) {
+            stack.push_back(k);
+            k = 2 * k;
+            continue;
+        }
+        k = stack.back();
+        stack.pop_back();
+        tree[k] = sorted[next];
+        rank[k] = static_cast<uint32_t>(next++);
+        k = 2 * k + 1;
+    }
+}
+
+size_t BinarySearcher::lowerBound(int key) const {
+    size_t result;
+    answer(&key, 1, &result);
+    return result;
+}
+
+void BinarySearcher::lowerBounds(const int* keys, size_t count, size_t* out, SearchStats* stats) const {
+    if (!stats) {
+        answer(keys, count, out);
+        return;
+    }
+    for (size_t first = 0; first < count; first += TIMING_BLOCK) {
+        size_t block = std::min(TIMING_BLOCK, count - first);
+        auto start = std::chrono::steady_clock::now();
+        stats->probes += answer(keys + first, block, out + first);
+        auto stop = std::chrono::steady_clock::now();
+        stats->nanoseconds += static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(stop - start).count());
+        stats->queries += block;
+    }
+}
+
+// Returns the number of probes made
+uint64_t BinarySearcher::answer(const int* keys, size_t count, size_t* out) const {
+    const int* a = sorted.data();
+    size_t n = sorted.size();
+    uint64_t probes = 0;
+    switch (variant) {
+        case BinarySearchVariant::Classic:
+            for (size_t q = 0; q < count; ++q) probes += classicLowerBound(a, n, keys[q], out[q]);
+            break;
+        case BinarySearchVariant::Branchless:
+            for (size_t q = 0; q < count; ++q) probes += branchlessLowerBound(a, n, keys[q], out[q]);
+            break;
+        case BinarySearchVariant::Eytzinger:
+            for (size_t q = 0; q < count; ++q) {
+                size_t k = 1;
+                while (k <= n) {
+                    prefetch(tree + LINE_INTS * k);
+                    k = 2 * k + (tree[k] < keys[q]);
+                    ++probes;
+                }
+                // Undo the final run of right turns; what's left is the last left turn, the answer
+                k >>= trailingOnes(k) + 1;
+                out[q] = k ? rank[k] : n;
+            }
+            break;
+        case BinarySearchVariant::Batched: {
+            if (n == 0) {
+                for (size_t q = 0; q < count; ++q) out[q] = 0;
+                break;
+            }
+            // Every query halves the same len each step, so the group moves in lockstep
+            const int* base[BATCH];
+            for (size_t first = 0; first < count; first += BATCH) {
+                size_t group = std::min(BATCH, count - first);
+                const int* groupKeys = keys + first;
+                for (size_t g = 0; g < group; ++g) base[g] = a;
+                size_t len = n;
+                while (len > 1) {
+                    size_t half = len / 2;
+                    for (size_t g = 0; g < group; ++g) {
+                        base[g] = (base[g][half] < groupKeys[g]) ? base[g] + half : base[g];
+                        prefetch(base[g] + (len - half) / 2);
+                    }
+                    len -= half;
+                    probes += group;
+                }
+                for (size_t g = 0; g < group; ++g) out[first + g] = static_cast<size_t>(base[g] - a) + (*base[g] < groupKeys[g]);
+                probes += group;
+            }
+            break;
+        }
+    }
+    return probes;
+}
@@ -0,0 +1,139 @@
+// algorithms/searching/linear_search.cpp
+#include "searching.h"
+#include "../../data_structures/lists/linked_list.h"
+#include "../../utilities/cpu_features.h"
+#include "../../utilities/parallel.h"
+#include <algorithm>
+#include <atomic>
+
+#if defined(__SSE2__) || defined(__AVX2__)
+#include <immintrin.h>
+#elif defined(__ARM_NEON)
+#include <arm_neon.h>
+#endif
+
+using std::vector;
+using std::size_t;
+
+namespace {
+
+// Elements per parallel chunk: large enough to amortize handing it out
+constexpr size_t PARALLEL_CHUNK = size_t(1) << 16;
+
+inline unsigned lowestBit(unsigned mask) {
+#if defined(__GNUC__) || defined(__clang__)
+    return static_cast<unsigned>(__builtin_ctz(mask));
+#else
+    unsigned bit = 0;
+    while (!(mask & 1)) { ++bit; mask >>= 1; }
+    return bit;
+#endif
+}
+
+#if defined(CPU_DISPATCH_X86) || defined(__AVX2__)
+// 32 keys per step, on CPUs that have AVX2 even when the build doesn't assume it
+CPU_TARGET("avx2") size_t avx2LinearSearch(const int* data, size_t n, int key) {
+    size_t i = 0;
+    __m256i needle = _mm256_set1_epi32(key);
+    for (; i + 32 <= n; i += 32) {
+        const __m256i* p = reinterpret_cast<const __m256i*>(data + i);
+        __m256i e0 = _mm256_cmpeq_epi32(_mm256_loadu_si256(p), needle);
+        __m256i e1 = _mm256_cmpeq_epi32(_mm256_loadu_si256(p + 1), needle);
+        __m256i e2 = _mm256_cmpeq_epi32(_mm256_loadu_si256(p + 2), needle);
+        __m256i e3 = _mm256_cmpeq_epi32(_mm256_loadu_si256(p + 3), needle);
+        // One test per 32 keys; only a hit pays for finding which lane matched
+        __m256i any = _mm256_or_si256(_mm256_or_si256(e0, e1), _mm256_or_si256(e2, e3));
+        if (_mm256_testz_si256(any, any)) continue;
+        const __m256i hits[4] = {e0, e1, e2, e3};
+        for (unsigned v = 0; v < 4; ++v) {
+            unsigned mask = static_cast<unsigned>(_mm256_movemask_ps(_mm256_castsi256_ps(hits[v])));
+            if (mask) return i + v * 8 + lowestBit(mask);
+        }
+    }
+    return i + scalarLinearSearch(data + i, n - i, key);
+}
+#endif
+
+} // namespace
+
+size_t scalarLinearSearch(const int* data, size_t n, int key) {
+    for (size_t i = 0; i < n; ++i) {
+        if (data[i] == key) return i;
+    }
+    return n;
+}
+
+size_t linearSearch(const int* data, size_t n, int key) {
+#if defined(CPU_DISPATCH_X86)
+    if (cpuHasAvx2()) return avx2LinearSearch(data, n, key);
+#elif defined(__AVX2__)
+    return avx2LinearSearch(data, n, key);
+#endif
+    size_t i = 0;
+#if defined(__SSE2__)
+    __m128i needle = _mm_set1_epi32(key);
+    for (; i + 16 <= n; i += 16) {
+        const __m128i* p = reinterpret_cast<const __m128i*>(data + i);
+        __m128i e0 = _mm_cmpeq_epi32(_mm_loadu_si128(p), needle);
+        __m128i e1 = _mm_cmpeq_epi32(_mm_loadu_si128(p + 1), needle);
+        __m128i e2 = _mm_cmpeq_epi32(_mm_loadu_si128(p + 2), needle);
+        __m128i e3 = _mm_cmpeq_epi32(_mm_loadu_si128(p + 3), needle);
+        __m128i any = _mm_or_si128(_mm_or_si128(e0, e1), _mm_or_si128(e2, e3));
+        if (_mm_movemask_epi8(any) == 0) continue;
+        const __m128i hits[4] = {e0, e1, e2, e3};
+        for (unsigned v = 0; v < 4; ++v) {
+            unsigned mask = static_cast<unsigned>(_mm_movemask_ps(_mm_castsi128_ps(hits[v])));
+            if (mask) return i + v * 4 + lowestBit(mask);
+        }
+    }
+#elif defined(__ARM_NEON) && defined(__aarch64__)
+    int32x4_t needle = vdupq_n_s32(key);
+    for (; i + 16 <= n; i += 16) {
+        uint32x4_t e0 = vceqq_s32(vld1q_s32(data + i), needle);
+        uint32x4_t e1 = vceqq_s32(vld1q_s32(data + i + 4), needle);
+        uint32x4_t e2 = vceqq_s32(vld1q_s32(data + i + 8), needle);
+        uint32x4_t e3 = vceqq_s32(vld1q_s32(data + i + 12), needle);
+        uint32x4_t any = vorrq_u32(vorrq_u32(e0, e1), vorrq_u32(e2, e3));
+        if (vmaxvq_u32(any) == 0) continue;
+        break; // The scalar tail below pins down the lane
+    }
+#endif
+    return i + scalarLinearSearch(data + i, n - i, key);
+}
+
+size_t linearSearch(const vector<int>& data, int key, StepTrace* trace) {
+    if (trace && trace->isRecording()) {
+        for (size_t i = 0; i < data.size(); ++i) {
+            trace->compare(i, i);
+            if (data[i] == key) return i;
+        }
+        return data.size();
+    }
+    size_t found = linearSearch(data.data(), data.size(), key);
+    if (trace) trace->addComparisons(found < data.size() ? found + 1 : data.size());
+    return found;
+}
+
+size_t parallelLinearSearch(const vector<int>& data, int key, unsigned threads) {
+    size_t n = data.size();
+    if (n <= PARALLEL_CHUNK) return linearSearch(data.data(), n, key); // Not worth waking threads
+    std::atomic<size_t> best{n};
+    parallelFor(0, n, PARALLEL_CHUNK, threads, [&](size_t b, size_t e, unsigned) {
+        if (b >= best.load(std::memory_order_relaxed)) return; // An earlier chunk already hit
+        size_t found = b + linearSearch(data.data() + b, e - b, key);
+        if (found == e) return;
+        size_t current = best.load(std::memory_order_relaxed);
+        while (found < current && !best.compare_exchange_weak(current, found, std::memory_order_relaxed)) {}
+    });
+    return best.load(std::memory_order_relaxed);
+}
+
+size_t linearSearch(const LinkedList& list, int key, StepTrace* trace) {
+    size_t position = 0;
+    for (int value : list) {
+        if (trace) trace->compare(position, position);
+        if (value == key) return position;
+        ++position;
+    }
+    return position;
+}
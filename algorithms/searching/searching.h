@@ -0,0 +1,104 @@
+// algorithms/searching/searching.h
+#pragma once
+#include "../../utilities/types.h"
+#include "../../utilities/step_trace.h"
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// Searches over std::vector<int> (sorted, except for linear search). Traced
+// runs report the range still in play (highlight) and every probed index (compare).
+
+class LinkedList;
+
+// Index of the first element >= key, or sorted.size() when there is none
+std::size_t binarySearch(const std::vector<int>& sorted, int key, StepTrace* trace = nullptr);
+// Index of an element equal to key, or sorted.size() when absent
+std::size_t ternarySearch(const std::vector<int>& sorted, int key, StepTrace* trace = nullptr);
+
+// Index of the first element equal to key, or n when absent. Compares 8 keys
+// per instruction with AVX2 (picked at run time on x86-64), 4 with SSE2 or
+// NEON, one at a time elsewhere, and checks a 32- or 16-key stride for any hit
+// before locating it.
+std::size_t linearSearch(const int* data, std::size_t n, int key);
+// One key at a time; what the compiler makes of the plain loop
+std::size_t scalarLinearSearch(const int* data, std::size_t n, int key);
+// Recorded traces step through the scalar loop for the visualizer; otherwise the
+// vectorized scan runs and only the compare count (elements examined) is added
+std::size_t linearSearch(const std::vector<int>& data, int key, StepTrace* trace = nullptr);
+// Chunks of the array are scanned by all threads (0 = every hardware thread).
+// Chunks are handed out in order, and chunks after a known hit are skipped.
+std::size_t parallelLinearSearch(const std::vector<int>& data, int key, unsigned threads = 0);
+// Position of the first node holding key, or list.size() when absent
+std::size_t linearSearch(const LinkedList& list, int key, StepTrace* trace = nullptr);
+
+enum class LinearSearchVariant { Scalar, Simd, Parallel, LinkedList };
+
+inline const std::vector<std::string> LINEAR_SEARCH_VARIANT_NAMES = {
+    "scalar", "simd", "parallel", "linked-list"
+};
+
+// Memory layouts and access patterns for answering many lower-bound queries:
+//   classic     textbook loop; the next probe waits on a hard-to-predict branch
+//   branchless  conditional moves plus a prefetch of both possible next probes
+//   eytzinger   keys stored in BFS order of the implicit search tree, so the next
+//               four levels of a query sit in one cache line and get prefetched
+//   batched     branchless, but a group of queries advances level by level so
+//               their cache misses overlap instead of serializing
+enum class BinarySearchVariant { Classic, Branchless, Eytzinger, Batched };
+
+inline const std::vector<std::string> BINARY_SEARCH_VARIANT_NAMES = {
+    "classic", "branchless", "eytzinger", "batched"
+};
+
+// Per-query cost, accumulated over calls to BinarySearcher::lowerBounds
+struct SearchStats {
+    std::uint64_t queries = 0;
+    std::uint64_t probes = 0;      // Key comparisons, i.e. memory touches
+    std::uint64_t nanoseconds = 0; // Wall time spent answering queries
+    double nsPerQuery() const { return queries ? static_cast<double>(nanoseconds) / queries : 0.0; }
+    double probesPerQuery() const { return queries ? static_cast<double>(probes) / queries : 0.0; }
+};
+
+class BinarySearcher {
+public:
+    // Keeps a reference to sorted; the Eytzinger variant also builds its own copy
+    BinarySearcher(const std::vector<int>& sorted, BinarySearchVariant variant);
+    // tree points into storage and sorted is a reference, so a copy would alias
+    // the original's buffers; hold searchers by pointer instead
+    BinarySearcher(const BinarySearcher&) = delete;
+    BinarySearcher& operator=(const BinarySearcher&) = delete;
+
+    // out[i] = lower bound of keys[i] as an index into sorted
+    void lowerBounds(const int* keys, std::size_t count, std::size_t* out, SearchStats* stats = nullptr) const;
+    std::size_t lowerBound(int key) const;
+
+private:
+    const std::vector<int>& sorted;
+    BinarySearchVariant variant;
+    std::vector<int> storage;         // Eytzinger keys, padded for cache-line alignment
+    int* tree = nullptr;              // tree[1..n] in BFS order; children of k are 2k and 2k+1
+    std::vector<std::uint32_t> rank;  // Sorted index of tree[k]
+
+    std::uint64_t answer(const int* keys, std::size_t count, std::size_t* out) const;
+};
+
+inline bool isSearchAlgorithm(Algorithm alg) {
+    return alg == Algorithm::BinarySearch || alg == Algorithm::LinearSearch || alg == Algorithm::TernarySearch;
+}
+
+// Dispatches on the Algorithm enum; returns false if alg is not a search.
+// found is the index the search reports (data.size() when absent).
+inline bool runSearch(Algorithm alg, const std::vector<int>& data, int key, std::size_t& found,
+                      StepTrace* trace = nullptr) {
+    switch (alg) {
+        case Algorithm::BinarySearch:
+            found = binarySearch(data, key, trace);
+            if (found < data.size() && data[found] != key) found = data.size();
+            return true;
+        case Algorithm::LinearSearch:  found = linearSearch(data, key, trace); return true;
+        case Algorithm::TernarySearch: found = ternarySearch(data, key, trace); return true;
+        default: return false;
+    }
+}
@@ -0,0 +1,28 @@
+// algorithms/searching/ternary_search.cpp
+#include "searching.h"
+
+using std::vector;
+using std::size_t;
+
+// Two probes split the range in thirds. It narrows faster per step than binary
+// search but spends more comparisons overall (about 2 log3 n vs log2 n).
+size_t ternarySearch(const vector<int>& sorted, int key, StepTrace* trace) {
+    size_t lo = 0, hi = sorted.size();
+    while (lo < hi) {
+        size_t third = (hi - lo) / 3;
+        size_t left = lo + third, right = hi - 1 - third;
+        if (trace) {
+            trace->highlight(lo, hi - 1);
+            trace->compare(left, right);
+        }
+        if (sorted[left] == key) return left;
+        if (sorted[right] == key) return right;
+        if (key < sorted[left]) hi = left;
+        else if (sorted[right] < key) lo = right + 1;
+        else {
+            lo = left + 1;
+            hi = right;
+        }
+    }
+    return sorted.size();
+}
@@ -0,0 +1,21 @@
+// algorithms/sorting/bubble_sort.cpp
+#include "sorting.h"
+#include <utility>
+
+using std::vector;
+
+void bubbleSort(vector<int>& arr, StepTrace* trace) {
+    size_t n = arr.size();
+    for (size_t pass = 0; pass + 1 < n; ++pass) {
+        bool swapped = false;
+        for (size_t j = 0; j + 1 < n - pass; ++j) {
+            if (trace) trace->compare(j, j + 1);
+            if (arr[j + 1] < arr[j]) {
+                std::swap(arr[j], arr[j + 1]);
+                if (trace) trace->swap(j, j + 1);
+                swapped = true;
+            }
+        }
+        if (!swapped) break; // Already sorted, stop early
+    }
+}
@@ -0,0 +1,69 @@
+// algorithms/sorting/heap_sort.cpp
+#include "sort_tasks.h"
+#include "../../data_structures/trees/max_heap.h"
+#include <cstdint>
+
+using std::vector;
+
+namespace {
+
+// Below this the heap stays in cache and alignment buys nothing
+constexpr size_t ALIGN_THRESHOLD = size_t(1) << 14;
+constexpr size_t CACHE_LINE = 64;
+
+// Reports heap steps against positions in the whole array
+struct TraceObserver {
+    StepTrace* trace;
+    size_t offset;
+    void compare(size_t i, size_t j) { if (trace) trace->compare(offset + i, offset + j); }
+    void write(size_t i, int value) { if (trace) trace->write(offset + i, value); }
+};
+
+// Elements to leave out in front so that every sibling group of the heap starts
+// on a multiple of its own size, i.e. never straddles a cache line
+template <unsigned D>
+size_t alignedStart(const vector<int>& arr) {
+    constexpr size_t GROUP = D * sizeof(int);
+    if (arr.size() < ALIGN_THRESHOLD || GROUP > CACHE_LINE || CACHE_LINE % GROUP) return 0;
+    // Children of the root start at heap index 1
+    auto firstChild = reinterpret_cast<std::uintptr_t>(arr.data() + 1);
+    size_t skew = (GROUP - firstChild % GROUP) % GROUP;
+    return skew % sizeof(int) ? 0 : skew / sizeof(int);
+}
+
+template <unsigned D, typename Observer>
+void dAryHeapSort(vector<int>& arr, size_t start, Observer obs) {
+    int* heap = arr.data() + start;
+    size_t n = arr.size() - start;
+    ReverseOrder<std::less<int>> maxFirst;
+
+    heapBuild<D>(heap, n, maxFirst, obs);
+    for (size_t end = n - 1; end > 0; --end) {
+        // The root moves to the end; the displaced last element refills it from the bottom
+        int last = heap[end];
+        heap[end] = heap[0];
+        obs.write(end, heap[end]);
+        heapSiftDown<D>(heap, end, 0, last, maxFirst, obs);
+    }
+}
+
+template <unsigned D>
+void dAryHeapSort(vector<int>& arr, StepTrace* trace) {
+    size_t start = alignedStart<D>(arr);
+    // Untraced runs get an observer that compiles away
+    if (trace) dAryHeapSort<D>(arr, start, TraceObserver{trace, start});
+    else dAryHeapSort<D>(arr, start, NullHeapObserver());
+    // The few elements skipped for alignment slide into the sorted run: O(n) moves
+    if (start > 0) insertionSortRange(arr, 0, arr.size(), trace);
+}
+
+} // namespace
+
+void heapSort(vector<int>& arr, StepTrace* trace, unsigned arity) {
+    if (arr.size() < 2) return;
+    switch (arity) {
+        case 2: dAryHeapSort<2>(arr, trace); break;
+        case 8: dAryHeapSort<8>(arr, trace); break;
+        default: dAryHeapSort<4>(arr, trace); break;
+    }
+}
@@ -0,0 +1,26 @@
+// algorithms/sorting/insertion_sort.cpp
+#include "sort_tasks.h"
+
+using std::vector;
+
+void insertionSortRange(vector<int>& arr, size_t lo, size_t hi, StepTrace* trace) {
+    for (size_t i = lo + 1; i < hi; ++i) {
+        int key = arr[i];
+        size_t j = i;
+        while (j > lo) {
+            if (trace) trace->compare(j - 1, i);
+            if (arr[j - 1] <= key) break;
+            arr[j] = arr[j - 1]; // Shift right instead of swapping
+            if (trace) trace->write(j, arr[j]);
+            --j;
+        }
+        if (j != i) {
+            arr[j] = key;
+            if (trace) trace->write(j, key);
+        }
+    }
+}
+
+void insertionSort(vector<int>& arr, StepTrace* trace) {
+    insertionSortRange(arr, 0, arr.size(), trace);
+}
@@ -0,0 +1,115 @@
+// algorithms/sorting/merge_sort.cpp
+#include "sort_tasks.h"
+#include <algorithm>
+#include <memory>
+
+using std::vector;
+
+namespace {
+
+// Merges src[a, aEnd) and src[b, bEnd) into dst starting at out
+void mergeInto(const vector<int>& src, vector<int>& dst, size_t a, size_t aEnd, size_t b, size_t bEnd, size_t out,
+               StepTrace* trace) {
+    while (a < aEnd && b < bEnd) {
+        if (trace) trace->compare(a, b);
+        dst[out++] = (src[b] < src[a]) ? src[b++] : src[a++]; // Stable: ties take the left run
+    }
+    while (a < aEnd) dst[out++] = src[a++];
+    while (b < bEnd) dst[out++] = src[b++];
+}
+
+void copyBack(vector<int>& arr, const vector<int>& scratch, size_t lo, size_t hi, StepTrace* trace) {
+    for (size_t k = lo; k < hi; ++k) {
+        arr[k] = scratch[k];
+        if (trace) trace->write(k, arr[k]);
+    }
+}
+
+// Both halves are sorted; an in-order seam means there is nothing to merge
+bool alreadyMerged(const vector<int>& arr, size_t mid, StepTrace* trace) {
+    if (trace) trace->compare(mid - 1, mid);
+    return arr[mid - 1] <= arr[mid];
+}
+
+// Every level shares the one scratch buffer allocated up front
+void mergeSortRange(vector<int>& arr, vector<int>& scratch, size_t lo, size_t hi, StepTrace* trace) {
+    if (hi - lo <= INSERTION_CUTOFF) {
+        insertionSortRange(arr, lo, hi, trace);
+        return;
+    }
+    size_t mid = lo + (hi - lo) / 2;
+    if (trace) trace->highlight(lo, hi - 1);
+    mergeSortRange(arr, scratch, lo, mid, trace);
+    mergeSortRange(arr, scratch, mid, hi, trace);
+    if (alreadyMerged(arr, mid, trace)) return;
+    mergeInto(arr, scratch, lo, mid, mid, hi, lo, trace);
+    copyBack(arr, scratch, lo, hi, trace);
+}
+
+// Splits a large merge in two at the middle of the longer run (binary-searching
+// the split point in the shorter one) so the top levels don't serialize on a
+// single O(n) merge. Ties keep left-run elements first, as in mergeInto.
+void parallelMerge(SortTasks& tasks, const vector<int>& src, vector<int>& dst, size_t a, size_t aEnd, size_t b,
+                   size_t bEnd, size_t out, StepTrace* trace) {
+    size_t total = (aEnd - a) + (bEnd - b);
+    if (total <= tasks.forkCutoff) {
+        mergeInto(src, dst, a, aEnd, b, bEnd, out, trace);
+        return;
+    }
+    size_t aSplit, bSplit;
+    if (aEnd - a >= bEnd - b) {
+        aSplit = a + (aEnd - a) / 2;
+        bSplit = std::lower_bound(src.begin() + b, src.begin() + bEnd, src[aSplit]) - src.begin();
+    } else {
+        bSplit = b + (bEnd - b) / 2;
+        aSplit = std::upper_bound(src.begin() + a, src.begin() + aEnd, src[bSplit]) - src.begin();
+    }
+    if (trace) trace->addComparisons(1); // The binary search, counted once per split
+    size_t outSplit = out + (aSplit - a) + (bSplit - b);
+    forkJoin(tasks, trace,
+        [&](StepTrace* t) { parallelMerge(tasks, src, dst, a, aSplit, b, bSplit, out, t); },
+        [&](StepTrace* t) { parallelMerge(tasks, src, dst, aSplit, aEnd, bSplit, bEnd, outSplit, t); });
+}
+
+void parallelCopyBack(SortTasks& tasks, vector<int>& arr, const vector<int>& scratch, size_t lo, size_t hi,
+                      StepTrace* trace) {
+    if (hi - lo <= tasks.forkCutoff) {
+        copyBack(arr, scratch, lo, hi, trace);
+        return;
+    }
+    size_t mid = lo + (hi - lo) / 2;
+    forkJoin(tasks, trace,
+        [&](StepTrace* t) { parallelCopyBack(tasks, arr, scratch, lo, mid, t); },
+        [&](StepTrace* t) { parallelCopyBack(tasks, arr, scratch, mid, hi, t); });
+}
+
+void parallelMergeSort(SortTasks& tasks, vector<int>& arr, vector<int>& scratch, size_t lo, size_t hi,
+                       StepTrace* trace) {
+    if (hi - lo <= tasks.forkCutoff) {
+        mergeSortRange(arr, scratch, lo, hi, trace);
+        return;
+    }
+    size_t mid = lo + (hi - lo) / 2;
+    if (trace) trace->highlight(lo, hi - 1);
+    forkJoin(tasks, trace,
+        [&](StepTrace* t) { parallelMergeSort(tasks, arr, scratch, lo, mid, t); },
+        [&](StepTrace* t) { parallelMergeSort(tasks, arr, scratch, mid, hi, t); });
+    if (alreadyMerged(arr, mid, trace)) return;
+    // Merge into scratch, then copy back once every part of the merge has read its input
+    parallelMerge(tasks, arr, scratch, lo, mid, mid, hi, lo, trace);
+    parallelCopyBack(tasks, arr, scratch, lo, hi, trace);
+}
+
+} // namespace
+
+void mergeSort(vector<int>& arr, StepTrace* trace, const ParallelSortOptions& parallel) {
+    vector<int> scratch(arr.size());
+    if (!parallel.pool || arr.size() <= parallel.forkCutoff) {
+        mergeSortRange(arr, scratch, 0, arr.size(), trace);
+        return;
+    }
+    std::unique_ptr<SharedTrace> sink(trace ? new SharedTrace(*trace) : nullptr);
+    SortTasks tasks{*parallel.pool, std::max<size_t>(parallel.forkCutoff, INSERTION_CUTOFF), sink.get()};
+    TaskTrace root(sink.get());
+    parallelMergeSort(tasks, arr, scratch, 0, arr.size(), root.get());
+}
@@ -0,0 +1,102 @@
+// algorithms/sorting/quick_sort.cpp
+#include "sort_tasks.h"
+#include <algorithm>
+#include <memory>
+#include <utility>
+
+using std::vector;
+
+namespace {
+
+// Ranges at least this long take Tukey's ninther instead of a plain median of three
+constexpr size_t NINTHER_THRESHOLD = 128;
+
+size_t medianOf3(const vector<int>& arr, size_t a, size_t b, size_t c, StepTrace* trace) {
+    if (trace) trace->compare(a, b);
+    if (arr[b] < arr[a]) std::swap(a, b);
+    if (trace) trace->compare(b, c);
+    if (arr[c] >= arr[b]) return b;
+    if (trace) trace->compare(a, c);
+    return arr[c] < arr[a] ? a : c;
+}
+
+size_t choosePivot(const vector<int>& arr, size_t lo, size_t hi, StepTrace* trace) {
+    size_t n = hi - lo, mid = lo + n / 2, last = hi - 1;
+    if (n < NINTHER_THRESHOLD) return medianOf3(arr, lo, mid, last, trace);
+    size_t s = n / 8;
+    return medianOf3(arr, medianOf3(arr, lo, lo + s, lo + 2 * s, trace),
+                     medianOf3(arr, mid - s, mid, mid + s, trace),
+                     medianOf3(arr, last - 2 * s, last - s, last, trace), trace);
+}
+
+// Dutch-flag partition of arr[lo, hi): afterwards [lo, lt) < pivot, [lt, gt) == pivot
+// and [gt, hi) > pivot. Runs of equal keys are finished in one pass, so inputs
+// with few distinct values no longer degrade to quadratic time.
+std::pair<size_t, size_t> partition3(vector<int>& arr, size_t lo, size_t hi, StepTrace* trace) {
+    size_t p = choosePivot(arr, lo, hi, trace);
+    std::swap(arr[lo], arr[p]);
+    if (trace) trace->swap(lo, p);
+    int pivot = arr[lo];
+    size_t lt = lo, i = lo + 1, gt = hi; // arr[lt] always holds a copy of the pivot
+    while (i < gt) {
+        if (trace) trace->compare(i, lt);
+        if (arr[i] < pivot) {
+            std::swap(arr[i], arr[lt]);
+            if (trace) trace->swap(i, lt);
+            ++lt;
+            ++i;
+        } else if (pivot < arr[i]) {
+            --gt;
+            std::swap(arr[i], arr[gt]);
+            if (trace) trace->swap(i, gt);
+        } else {
+            ++i;
+        }
+    }
+    return {lt, gt};
+}
+
+// Sorts arr[lo, hi) with an explicit stack; pushing the larger side first keeps it O(log n)
+void quickSortRange(vector<int>& arr, size_t lo, size_t hi, StepTrace* trace) {
+    vector<std::pair<size_t, size_t>> ranges;
+    ranges.push_back({lo, hi});
+    while (!ranges.empty()) {
+        auto [first, last] = ranges.back();
+        ranges.pop_back();
+        if (last - first <= INSERTION_CUTOFF) {
+            insertionSortRange(arr, first, last, trace);
+            continue;
+        }
+        if (trace) trace->highlight(first, last - 1);
+        auto [lt, gt] = partition3(arr, first, last, trace);
+        std::pair<size_t, size_t> left = {first, lt}, right = {gt, last};
+        if (lt - first < last - gt) std::swap(left, right);
+        ranges.push_back(left);
+        ranges.push_back(right);
+    }
+}
+
+void parallelQuickSort(SortTasks& tasks, vector<int>& arr, size_t lo, size_t hi, StepTrace* trace) {
+    if (hi - lo <= tasks.forkCutoff) {
+        quickSortRange(arr, lo, hi, trace);
+        return;
+    }
+    if (trace) trace->highlight(lo, hi - 1);
+    auto [lt, gt] = partition3(arr, lo, hi, trace);
+    forkJoin(tasks, trace,
+        [&](StepTrace* t) { parallelQuickSort(tasks, arr, lo, lt, t); },
+        [&](StepTrace* t) { parallelQuickSort(tasks, arr, gt, hi, t); });
+}
+
+} // namespace
+
+void quickSort(vector<int>& arr, StepTrace* trace, const ParallelSortOptions& parallel) {
+    if (!parallel.pool || arr.size() <= parallel.forkCutoff) {
+        quickSortRange(arr, 0, arr.size(), trace);
+        return;
+    }
+    std::unique_ptr<SharedTrace> sink(trace ? new SharedTrace(*trace) : nullptr);
+    SortTasks tasks{*parallel.pool, std::max<size_t>(parallel.forkCutoff, INSERTION_CUTOFF), sink.get()};
+    TaskTrace root(sink.get());
+    parallelQuickSort(tasks, arr, 0, arr.size(), root.get());
+}
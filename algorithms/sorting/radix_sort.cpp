@@ -0,0 +1,160 @@
+// algorithms/sorting/radix_sort.cpp
+#include "sorting.h"
+#include "../../utilities/parallel.h"
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <type_traits>
+
+using std::vector;
+using std::uint32_t;
+using std::uint64_t;
+
+namespace {
+
+// Blocks smaller than this aren't worth a thread of their own
+constexpr size_t MIN_BLOCK = size_t(1) << 16;
+// Above this size the 11-bit digit wins: one pass fewer for 32-bit keys outweighs
+// a histogram that no longer fits in L1
+constexpr size_t WIDE_DIGIT_THRESHOLD = size_t(1) << 16;
+
+// Maps a key to an unsigned integer of the same width with the same order
+template <typename T> struct RadixKey;
+template <> struct RadixKey<std::int32_t> {
+    using Bits = uint32_t;
+    static Bits of(std::int32_t v) { return static_cast<uint32_t>(v) ^ 0x80000000u; }
+};
+template <> struct RadixKey<uint32_t> {
+    using Bits = uint32_t;
+    static Bits of(uint32_t v) { return v; }
+};
+template <> struct RadixKey<std::int64_t> {
+    using Bits = uint64_t;
+    static Bits of(std::int64_t v) { return static_cast<uint64_t>(v) ^ (uint64_t(1) << 63); }
+};
+template <> struct RadixKey<uint64_t> {
+    using Bits = uint64_t;
+    static Bits of(uint64_t v) { return v; }
+};
+// Negative floats reverse their order when read as integers: flip every bit of
+// those, and only the sign bit of the rest. Branch-free so it vectorizes.
+template <> struct RadixKey<float> {
+    using Bits = uint32_t;
+    static Bits of(float v) {
+        uint32_t bits;
+        std::memcpy(&bits, &v, sizeof bits);
+        return bits ^ (static_cast<uint32_t>(-static_cast<std::int32_t>(bits >> 31)) | 0x80000000u);
+    }
+};
+template <> struct RadixKey<double> {
+    using Bits = uint64_t;
+    static Bits of(double v) {
+        uint64_t bits;
+        std::memcpy(&bits, &v, sizeof bits);
+        return bits ^ (static_cast<uint64_t>(-static_cast<std::int64_t>(bits >> 63)) | (uint64_t(1) << 63));
+    }
+};
+
+template <typename T, unsigned DigitBits>
+void lsdRadixSort(vector<T>& data, unsigned threadRequest, StepTrace* trace) {
+    using Key = RadixKey<T>;
+    using Bits = typename Key::Bits;
+    constexpr size_t RADIX = size_t(1) << DigitBits;
+    constexpr Bits MASK = static_cast<Bits>(RADIX - 1);
+    constexpr unsigned PASSES = (sizeof(Bits) * 8 + DigitBits - 1) / DigitBits;
+
+    size_t n = data.size();
+    if (n < 2) return;
+    // Recorded events must come from one thread, in scatter order
+    bool recording = trace && trace->isRecording();
+    unsigned threads = recording ? 1 : resolveThreadCount(threadRequest);
+    size_t blocks = std::max<size_t>(1, std::min<size_t>(threads, n / MIN_BLOCK));
+    blocks = std::max<size_t>(blocks, (n - 1) / std::numeric_limits<uint32_t>::max() + 1); // Counts are 32-bit
+    size_t blockSize = (n + blocks - 1) / blocks;
+    auto blockEnd = [&](size_t k) { return std::min(n, (k + 1) * blockSize); };
+
+    // counts[(block * PASSES + pass) * RADIX + digit], all filled by a single read of the input
+    vector<uint32_t> counts(blocks * PASSES * RADIX, 0);
+    parallelFor(0, blocks, 1, threads, [&](size_t b, size_t e, unsigned) {
+        for (size_t k = b; k < e; ++k) {
+            uint32_t* c = &counts[k * PASSES * RADIX];
+            for (size_t i = k * blockSize, end = blockEnd(k); i < end; ++i) {
+                Bits key = Key::of(data[i]);
+                for (unsigned p = 0; p < PASSES; ++p) ++c[p * RADIX + ((key >> (p * DigitBits)) & MASK)];
+            }
+        }
+    });
+
+    vector<T> buffer(n); // Ping-pong target, allocated once for all passes
+    T* src = data.data();
+    T* dst = buffer.data();
+    vector<size_t> offsets(blocks * RADIX);
+    bool histogramsFresh = true; // Per-block counts still describe the current order
+    Bits firstKey = Key::of(data[0]);
+
+    for (unsigned p = 0; p < PASSES; ++p) {
+        unsigned shift = p * DigitBits;
+        // Digit totals don't depend on element order, so the first read answers this for every pass
+        size_t firstDigit = (firstKey >> shift) & MASK, sameDigit = 0;
+        for (size_t k = 0; k < blocks; ++k) sameDigit += counts[(k * PASSES + p) * RADIX + firstDigit];
+        if (sameDigit == n) continue;
+
+        // Per-block counts do depend on order: recount this digit after an earlier scatter
+        if (!histogramsFresh && blocks > 1) {
+            parallelFor(0, blocks, 1, threads, [&](size_t b, size_t e, unsigned) {
+                for (size_t k = b; k < e; ++k) {
+                    uint32_t* c = &counts[(k * PASSES + p) * RADIX];
+                    std::fill(c, c + RADIX, 0);
+                    for (size_t i = k * blockSize, end = blockEnd(k); i < end; ++i) ++c[(Key::of(src[i]) >> shift) & MASK];
+                }
+            });
+        }
+        histogramsFresh = false;
+
+        // Digit-major, block-minor offsets: block k's run of a digit follows block k-1's, keeping the sort stable
+        size_t running = 0;
+        for (size_t d = 0; d < RADIX; ++d) {
+            for (size_t k = 0; k < blocks; ++k) {
+                offsets[k * RADIX + d] = running;
+                running += counts[(k * PASSES + p) * RADIX + d];
+            }
+        }
+        parallelFor(0, blocks, 1, threads, [&](size_t b, size_t e, unsigned) {
+            for (size_t k = b; k < e; ++k) {
+                size_t* offset = &offsets[k * RADIX];
+                for (size_t i = k * blockSize, end = blockEnd(k); i < end; ++i) {
+                    size_t pos = offset[(Key::of(src[i]) >> shift) & MASK]++;
+                    dst[pos] = src[i];
+                    if constexpr (std::is_same<T, int>::value) {
+                        if (recording) trace->write(pos, src[i]);
+                    }
+                }
+            }
+        });
+        if (trace && !(recording && std::is_same<T, int>::value)) trace->addWrites(n);
+        std::swap(src, dst);
+    }
+    if (src != data.data()) data.swap(buffer);
+}
+
+} // namespace
+
+template <typename T>
+void radixSortKeys(vector<T>& data, const RadixSortOptions& options, StepTrace* trace) {
+    if (options.digitBits == 11) lsdRadixSort<T, 11>(data, options.threads, trace);
+    else lsdRadixSort<T, 8>(data, options.threads, trace);
+}
+
+template void radixSortKeys<std::int32_t>(vector<std::int32_t>&, const RadixSortOptions&, StepTrace*);
+template void radixSortKeys<uint32_t>(vector<uint32_t>&, const RadixSortOptions&, StepTrace*);
+template void radixSortKeys<std::int64_t>(vector<std::int64_t>&, const RadixSortOptions&, StepTrace*);
+template void radixSortKeys<uint64_t>(vector<uint64_t>&, const RadixSortOptions&, StepTrace*);
+template void radixSortKeys<float>(vector<float>&, const RadixSortOptions&, StepTrace*);
+template void radixSortKeys<double>(vector<double>&, const RadixSortOptions&, StepTrace*);
+
+void radixSort(vector<int>& arr, StepTrace* trace) {
+    RadixSortOptions options;
+    options.digitBits = arr.size() >= WIDE_DIGIT_THRESHOLD ? 11 : 8;
+    radixSortKeys(arr, options, trace);
+}
@@ -0,0 +1,20 @@
+// algorithms/sorting/selection_sort.cpp
+#include "sorting.h"
+#include <utility>
+
+using std::vector;
+
+void selectionSort(vector<int>& arr, StepTrace* trace) {
+    size_t n = arr.size();
+    for (size_t i = 0; i + 1 < n; ++i) {
+        size_t minIdx = i;
+        for (size_t j = i + 1; j < n; ++j) {
+            if (trace) trace->compare(minIdx, j);
+            if (arr[j] < arr[minIdx]) minIdx = j;
+        }
+        if (minIdx != i) {
+            std::swap(arr[i], arr[minIdx]);
+            if (trace) trace->swap(i, minIdx);
+        }
+    }
+}
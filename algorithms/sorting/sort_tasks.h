@@ -0,0 +1,49 @@
+// algorithms/sorting/sort_tasks.h
+#pragma once
+#include "sorting.h"
+#include "../../utilities/thread_pool.h"
+
+// Pieces shared by the divide-and-conquer sorts.
+
+// Ranges this short are finished by insertion sort
+constexpr std::size_t INSERTION_CUTOFF = 16;
+
+// Insertion sort of arr[lo, hi)
+void insertionSortRange(std::vector<int>& arr, std::size_t lo, std::size_t hi, StepTrace* trace);
+
+// Everything the tasks of one parallel sort share
+struct SortTasks {
+    ThreadPool& pool;
+    std::size_t forkCutoff;
+    SharedTrace* sink; // Null when untraced
+};
+
+// The private trace of one task, published when the task ends
+class TaskTrace {
+public:
+    explicit TaskTrace(SharedTrace* s) : sink(s), local(s ? s->makeLocal(ThreadPool::currentWorker()) : StepTrace(false)) {}
+    ~TaskTrace() { if (sink) sink->publish(local); }
+    TaskTrace(const TaskTrace&) = delete;
+    TaskTrace& operator=(const TaskTrace&) = delete;
+
+    StepTrace* get() { return sink ? &local : nullptr; }
+
+private:
+    SharedTrace* sink;
+    StepTrace local;
+};
+
+// Offers left(trace) to the pool as a stealable task, runs right(trace) inline
+// and waits for both. Events recorded so far are published first so they
+// replay before anything the two halves do.
+template <typename Left, typename Right>
+void forkJoin(SortTasks& tasks, StepTrace* trace, Left left, Right right) {
+    if (trace) tasks.sink->publish(*trace);
+    TaskGroup group(tasks.pool);
+    group.run([&tasks, &left] {
+        TaskTrace own(tasks.sink);
+        left(own.get());
+    });
+    right(trace);
+    group.wait();
+}
@@ -0,0 +1,75 @@
+// algorithms/sorting/sorting.h
+#pragma once
+#include "../../utilities/types.h"
+#include "../../utilities/step_trace.h"
+#include <cstddef>
+#include <vector>
+
+// Every sort works in place. When a trace is supplied the sort reports each
+// compare/swap/write on it, otherwise it runs untraced at full speed.
+
+class ThreadPool;
+
+// Parallel mode for the divide-and-conquer sorts: subranges of at least
+// forkCutoff elements become tasks on pool, so idle workers can steal them.
+// Smaller ranges, and everything when pool is null, run sequentially. Traced
+// events carry the id of the worker that produced them.
+struct ParallelSortOptions {
+    ThreadPool* pool = nullptr;
+    std::size_t forkCutoff = std::size_t(1) << 13;
+};
+
+void bubbleSort(std::vector<int>& arr, StepTrace* trace = nullptr);
+void selectionSort(std::vector<int>& arr, StepTrace* trace = nullptr);
+void insertionSort(std::vector<int>& arr, StepTrace* trace = nullptr);
+void mergeSort(std::vector<int>& arr, StepTrace* trace = nullptr, const ParallelSortOptions& parallel = {});
+void quickSort(std::vector<int>& arr, StepTrace* trace = nullptr, const ParallelSortOptions& parallel = {});
+// Max-heap of the given arity (2, 4 or 8) built with Floyd's method and bottom-up sift-down
+void heapSort(std::vector<int>& arr, StepTrace* trace = nullptr, unsigned arity = 4);
+void radixSort(std::vector<int>& arr, StepTrace* trace = nullptr);
+
+// LSD radix sort on an order-preserving unsigned image of each key (sign bit
+// flipped for integers, IEEE bits flipped for floats, so negatives and -0.0
+// sort correctly). One read pass builds the histograms for every digit, and
+// digits on which all keys agree are skipped. Threads split the input into
+// blocks with their own histograms, so the scatter stays stable; a block's
+// counts change with the order, so with more than one block each pass after the
+// first re-reads the input to recount its digit. Implemented for int32_t,
+// uint32_t, int64_t, uint64_t, float and double.
+struct RadixSortOptions {
+    unsigned digitBits = 8; // 8 or 11
+    unsigned threads = 1;   // 0 = all hardware threads
+};
+template <typename T>
+void radixSortKeys(std::vector<T>& data, const RadixSortOptions& options = {}, StepTrace* trace = nullptr);
+
+inline bool isSortingAlgorithm(Algorithm alg) {
+    switch (alg) {
+        case Algorithm::BubbleSort: case Algorithm::HeapSort: case Algorithm::InsertionSort:
+        case Algorithm::MergeSort: case Algorithm::QuickSort: case Algorithm::RadixSort:
+        case Algorithm::SelectionSort:
+            return true;
+        default:
+            return false;
+    }
+}
+
+inline bool hasParallelSort(Algorithm alg) {
+    return alg == Algorithm::MergeSort || alg == Algorithm::QuickSort;
+}
+
+// Dispatches on the Algorithm enum; returns false if alg is not a sort.
+// Sorts without a parallel mode ignore the options.
+inline bool runSort(Algorithm alg, std::vector<int>& arr, StepTrace* trace = nullptr,
+                    const ParallelSortOptions& parallel = {}) {
+    switch (alg) {
+        case Algorithm::BubbleSort:    bubbleSort(arr, trace); return true;
+        case Algorithm::HeapSort:      heapSort(arr, trace); return true;
+        case Algorithm::InsertionSort: insertionSort(arr, trace); return true;
+        case Algorithm::MergeSort:     mergeSort(arr, trace, parallel); return true;
+        case Algorithm::QuickSort:     quickSort(arr, trace, parallel); return true;
+        case Algorithm::RadixSort:     radixSort(arr, trace); return true;
+        case Algorithm::SelectionSort: selectionSort(arr, trace); return true;
+        default: return false;
+    }
+}
@@ -0,0 +1,67 @@
+// algorithms/tree_traversals/in_order.cpp
+#include "tree_traversals.h"
+
+using std::size_t;
+
+// The constructor and destructor are shared by all three orders
+TreeTraversal::TreeTraversal(BinaryTree& tree, TraversalOrder order, TraversalMethod method, size_t stackCapacity)
+    : pool(tree.pool), root(tree.rootIndex), morris(method == TraversalMethod::Morris), cur(tree.rootIndex) {
+    switch (order) {
+        case TraversalOrder::PreOrder:
+            step = morris ? &TreeTraversal::preOrderMorris : &TreeTraversal::preOrderStack;
+            break;
+        case TraversalOrder::InOrder:
+            step = morris ? &TreeTraversal::inOrderMorris : &TreeTraversal::inOrderStack;
+            break;
+        case TraversalOrder::PostOrder:
+            step = morris ? &TreeTraversal::postOrderMorris : &TreeTraversal::postOrderStack;
+            if (morris) cur = VIRTUAL_ROOT;
+            break;
+    }
+    if (!morris) stack.reserve(stackCapacity);
+}
+
+TreeTraversal::~TreeTraversal() {
+    // Unthreading happens on the way back up, so finishing the walk is what restores the tree
+    if (morris) {
+        while (next() != NIL_NODE) {}
+    }
+}
+
+// Left spine onto the stack, then pop one node and continue from its right child
+NodeIndex TreeTraversal::inOrderStack() {
+    while (cur != NIL_NODE) {
+        push(cur);
+        cur = pool[cur].left();
+    }
+    if (stack.empty()) return NIL_NODE;
+    NodeIndex n = stack.back();
+    stack.pop_back();
+    cur = pool[n].right();
+    return n;
+}
+
+// Before descending left, the left subtree's last node gets a thread back to cur.
+// Reaching cur again through that thread means its left subtree is done: cur is
+// next, and the thread comes out.
+NodeIndex TreeTraversal::inOrderMorris() {
+    while (cur != NIL_NODE) {
+        NodeIndex n = cur;
+        NodeIndex l = pool[n].left();
+        if (l == NIL_NODE) {
+            cur = pool[n].right();
+            return n;
+        }
+        NodeIndex p = predecessor(n, l);
+        ++threadWrites;
+        if (pool[p].right() == NIL_NODE) {
+            pool[p].setRight(n);
+            cur = l;
+        } else {
+            pool[p].setRight(NIL_NODE);
+            cur = pool[n].right();
+            return n;
+        }
+    }
+    return NIL_NODE;
+}
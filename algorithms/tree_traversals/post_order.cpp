@@ -0,0 +1,77 @@
+// algorithms/tree_traversals/post_order.cpp
+#include "tree_traversals.h"
+
+// A node on top of the stack is returned once its right subtree is done, which
+// is the case when it has none or that subtree's root was the last node returned
+NodeIndex TreeTraversal::postOrderStack() {
+    for (;;) {
+        while (cur != NIL_NODE) {
+            push(cur);
+            cur = pool[cur].left();
+        }
+        if (stack.empty()) return NIL_NODE;
+        NodeIndex top = stack.back();
+        NodeIndex r = pool[top].right();
+        if (r != NIL_NODE && r != lastVisited) {
+            cur = r;
+            continue;
+        }
+        stack.pop_back();
+        lastVisited = top;
+        return top;
+    }
+}
+
+// In-order threading from a virtual root whose left child is the real root.
+// When a thread leads back to cur, the right path from left(cur) to the thread
+// holds the nodes that finish next, in reverse: the path's links are reversed,
+// walked from its tail one node per call, and reversed back after the last.
+NodeIndex TreeTraversal::postOrderMorris() {
+    while (emitNext == NIL_NODE) {
+        if (cur == NIL_NODE) return NIL_NODE;
+        NodeIndex l = cur == VIRTUAL_ROOT ? root : pool[cur].left();
+        if (l == NIL_NODE) {
+            cur = cur == VIRTUAL_ROOT ? NIL_NODE : pool[cur].right();
+            continue;
+        }
+        NodeIndex p = predecessor(cur, l);
+        if (pool[p].right() == NIL_NODE) {
+            pool[p].setRight(cur);
+            ++threadWrites;
+            cur = l;
+            continue;
+        }
+        reverseRightPath(l, p);
+        pathHead = l;
+        pathTail = p;
+        pathOwner = cur;
+        emitNext = p;
+    }
+
+    NodeIndex n = emitNext;
+    if (n != pathHead) {
+        emitNext = pool[n].right();
+        return n;
+    }
+    // Last node of the path: put its links back and take the thread out
+    reverseRightPath(pathTail, pathHead);
+    pool[pathTail].setRight(NIL_NODE);
+    ++threadWrites;
+    cur = pathOwner == VIRTUAL_ROOT ? NIL_NODE : pool[pathOwner].right();
+    emitNext = NIL_NODE;
+    return n;
+}
+
+// Points each right link on the path from..to at the node before it. from's own
+// link is left alone, so reversing again from to back to from undoes it.
+void TreeTraversal::reverseRightPath(NodeIndex from, NodeIndex to) {
+    NodeIndex x = from;
+    NodeIndex y = pool[from].right();
+    while (x != to) {
+        NodeIndex z = pool[y].right();
+        pool[y].setRight(x);
+        ++threadWrites;
+        x = y;
+        y = z;
+    }
+}
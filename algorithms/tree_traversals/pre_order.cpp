@@ -0,0 +1,38 @@
+// algorithms/tree_traversals/pre_order.cpp
+#include "tree_traversals.h"
+
+// cur is the next node; only right children still owed wait on the stack
+NodeIndex TreeTraversal::preOrderStack() {
+    if (cur == NIL_NODE) {
+        if (stack.empty()) return NIL_NODE;
+        cur = stack.back();
+        stack.pop_back();
+    }
+    NodeIndex n = cur;
+    if (pool[n].right() != NIL_NODE) push(pool[n].right());
+    cur = pool[n].left();
+    return n;
+}
+
+// Same threading as in-order, but a node is returned when its thread goes in
+// (on the way down) rather than when it comes out
+NodeIndex TreeTraversal::preOrderMorris() {
+    while (cur != NIL_NODE) {
+        NodeIndex n = cur;
+        NodeIndex l = pool[n].left();
+        if (l == NIL_NODE) {
+            cur = pool[n].right();
+            return n;
+        }
+        NodeIndex p = predecessor(n, l);
+        ++threadWrites;
+        if (pool[p].right() == NIL_NODE) {
+            pool[p].setRight(n);
+            cur = l;
+            return n;
+        }
+        pool[p].setRight(NIL_NODE);
+        cur = pool[n].right();
+    }
+    return NIL_NODE;
+}
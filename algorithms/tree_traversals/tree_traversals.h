@@ -0,0 +1,171 @@
+// algorithms/tree_traversals/tree_traversals.h
+#pragma once
+#include "../../data_structures/trees/binary_tree.h"
+#include "../../utilities/types.h"
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <string>
+#include <vector>
+
+// Depth-first orders over any BinaryTree, each in three ways:
+//   recursive  the call stack holds the path; simplest, but a degenerate tree
+//              is as deep as it is large, so depth is capped instead of letting
+//              a sorted-insert BST overflow the thread's stack
+//   stack      the same walk with an explicit, preallocated stack of node indices
+//   morris     threads the tree through its empty right links and unthreads it
+//              on the way back: O(1) extra space at the cost of about 2n extra
+//              link reads. The tree is modified while the walk is in progress.
+
+enum class TraversalOrder { PreOrder, InOrder, PostOrder };
+
+enum class TraversalMethod { Recursive, Stack, Morris };
+
+inline const std::vector<std::string> TRAVERSAL_METHOD_NAMES = {"recursive", "stack", "morris"};
+
+inline bool isTraversalAlgorithm(Algorithm alg) {
+    return alg == Algorithm::InOrder || alg == Algorithm::PreOrder || alg == Algorithm::PostOrder;
+}
+
+// Precondition: isTraversalAlgorithm(alg)
+inline TraversalOrder traversalOrderOf(Algorithm alg) {
+    if (alg == Algorithm::PreOrder) return TraversalOrder::PreOrder;
+    return alg == Algorithm::InOrder ? TraversalOrder::InOrder : TraversalOrder::PostOrder;
+}
+
+// Deepest recursion traverseRecursive attempts: a few hundred KiB of frames,
+// safe on a 1 MiB Windows thread stack, and far above the height of any
+// balanced or randomly built tree that fits in memory
+constexpr std::size_t RECURSION_DEPTH_LIMIT = 4096;
+
+enum class TraversalEnd {
+    Finished, // Every node was visited
+    Stopped,  // visit returned false
+    TooDeep   // The tree is deeper than maxDepth; nothing below that depth was visited
+};
+
+namespace traversal_detail {
+
+template<typename Visit>
+bool walk(const BinaryTree& tree, NodeIndex n, TraversalOrder order, Visit& visit, std::size_t depthLeft,
+          bool& tooDeep) {
+    if (n == NIL_NODE) return true;
+    if (depthLeft == 0) {
+        tooDeep = true;
+        return false;
+    }
+    if (order == TraversalOrder::PreOrder && !visit(n)) return false;
+    if (!walk(tree, tree.left(n), order, visit, depthLeft - 1, tooDeep)) return false;
+    if (order == TraversalOrder::InOrder && !visit(n)) return false;
+    if (!walk(tree, tree.right(n), order, visit, depthLeft - 1, tooDeep)) return false;
+    return order != TraversalOrder::PostOrder || visit(n);
+}
+
+} // namespace traversal_detail
+
+// Calls visit(NodeIndex) for each node in order until it returns false. A
+// recursion can't be suspended between nodes, so this form takes a callback
+// where the other two methods are pulled through TreeTraversal.
+template<typename Visit>
+TraversalEnd traverseRecursive(const BinaryTree& tree, TraversalOrder order, Visit visit,
+                               std::size_t maxDepth = RECURSION_DEPTH_LIMIT) {
+    bool tooDeep = false;
+    if (traversal_detail::walk(tree, tree.root(), order, visit, maxDepth, tooDeep)) return TraversalEnd::Finished;
+    return tooDeep ? TraversalEnd::TooDeep : TraversalEnd::Stopped;
+}
+
+// Lazy traversal: next() does only the work needed to reach the following node,
+// so a caller can stop after k nodes having paid for k (the visualizer pulls one
+// per frame). TraversalMethod::Recursive has no suspendable form and walks with
+// the explicit stack here.
+//
+// A Morris walk leaves threads in the tree until it finishes; destroying the
+// traversal early runs it to the end so the tree is restored. Don't modify or
+// read the tree's links from elsewhere while one is in progress. Post-order
+// Morris uses index NIL_NODE - 1 for its virtual root, so that node must not exist.
+class TreeTraversal {
+public:
+    class Iterator {
+    public:
+        using iterator_category = std::input_iterator_tag;
+        using value_type = NodeIndex;
+        using difference_type = std::ptrdiff_t;
+        using pointer = const NodeIndex*;
+        using reference = const NodeIndex&;
+
+        Iterator(TreeTraversal* owner, NodeIndex n) : traversal(owner), node(n) {}
+        reference operator*() const { return node; }
+        Iterator& operator++() {
+            node = traversal->next();
+            return *this;
+        }
+        bool operator==(const Iterator& other) const { return node == other.node; }
+        bool operator!=(const Iterator& other) const { return node != other.node; }
+
+    private:
+        TreeTraversal* traversal;
+        NodeIndex node;
+    };
+
+    // stackCapacity is reserved up front for the stack method; it still grows
+    // past that on deeper trees
+    TreeTraversal(BinaryTree& tree, TraversalOrder order, TraversalMethod method = TraversalMethod::Stack,
+                  std::size_t stackCapacity = 64);
+    ~TreeTraversal();
+    TreeTraversal(const TreeTraversal&) = delete;
+    TreeTraversal& operator=(const TreeTraversal&) = delete;
+
+    // The following node, or NIL_NODE once every node has been returned
+    NodeIndex next() { return (this->*step)(); }
+
+    // Single pass: begin() pulls the first node
+    Iterator begin() { return Iterator(this, next()); }
+    Iterator end() { return Iterator(this, NIL_NODE); }
+
+    // Deepest the explicit stack has been (0 for Morris)
+    std::size_t peakStack() const { return peak; }
+    // Links written to thread and unthread the tree (0 for the stack method)
+    std::uint64_t linkWrites() const { return threadWrites; }
+
+private:
+    static constexpr NodeIndex VIRTUAL_ROOT = NIL_NODE - 1;
+
+    NodePool& pool;
+    NodeIndex root;
+    NodeIndex (TreeTraversal::*step)();
+    bool morris;
+
+    NodeIndex cur;
+    NodeIndex lastVisited = NIL_NODE;
+    std::vector<NodeIndex> stack;
+    std::size_t peak = 0;
+    std::uint64_t threadWrites = 0;
+
+    // Post-order Morris emits the right path pathHead..pathTail backwards, after
+    // reversing its links; emitNext is the next node of it to return
+    NodeIndex emitNext = NIL_NODE;
+    NodeIndex pathHead = NIL_NODE;
+    NodeIndex pathTail = NIL_NODE;
+    NodeIndex pathOwner = NIL_NODE; // Node whose left subtree the path ends
+
+    void push(NodeIndex n) {
+        stack.push_back(n);
+        if (stack.size() > peak) peak = stack.size();
+    }
+    // Rightmost node of left(n)'s subtree, or the node already threaded back to n
+    NodeIndex predecessor(NodeIndex n, NodeIndex leftChild) const {
+        NodeIndex p = leftChild;
+        for (NodeIndex r = pool[p].right(); r != NIL_NODE && r != n; r = pool[r].right()) p = r;
+        return p;
+    }
+
+    // One stepper per order and method, defined in pre_order.cpp, in_order.cpp
+    // and post_order.cpp
+    NodeIndex preOrderStack();
+    NodeIndex preOrderMorris();
+    NodeIndex inOrderStack();
+    NodeIndex inOrderMorris();
+    NodeIndex postOrderStack();
+    NodeIndex postOrderMorris();
+    void reverseRightPath(NodeIndex from, NodeIndex to);
+};
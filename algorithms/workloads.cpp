@@ -0,0 +1,1349 @@
+// algorithms/workloads.cpp
+#include "workloads.h"
+#include "sorting/sorting.h"
+#include "graph/graph_algorithms.h"
+#include "searching/searching.h"
+#include "tree_traversals/tree_traversals.h"
+#include "greedy/huffman_encoding.h"
+#include "../data_structures/lists/linked_list.h"
+#include "../data_structures/maps_sets/hash_table.h"
+#include "../data_structures/maps_sets/trie.h"
+#include "../data_structures/queues_stacks/queue.h"
+#include "../data_structures/trees/avl_tree.h"
+#include "../data_structures/trees/fenwick_tree.h"
+#include "../data_structures/trees/red_black_tree.h"
+#include "../data_structures/trees/segment_tree.h"
+#include "../utilities/alloc_tracker.h"
+#include "../utilities/thread_pool.h"
+#include <algorithm>
+#include <atomic>
+#include <deque>
+#include <iterator>
+#include <list>
+#include <map>
+#include <random>
+#include <set>
+#include <sstream>
+#include <thread>
+#include <unordered_map>
+
+using std::vector;
+using std::size_t;
+
+vector<int> generateInput(size_t n, InputDistribution dist, uint32_t seed) {
+    vector<int> data(n);
+    std::mt19937 rng(seed);
+    switch (dist) {
+        case InputDistribution::Random: {
+            std::uniform_int_distribution<int> values(0, static_cast<int>(std::max<size_t>(n, 1) * 4));
+            for (int& v : data) v = values(rng);
+            break;
+        }
+        case InputDistribution::Sorted:
+            for (size_t i = 0; i < n; ++i) data[i] = static_cast<int>(i);
+            break;
+        case InputDistribution::Reversed:
+            for (size_t i = 0; i < n; ++i) data[i] = static_cast<int>(n - i);
+            break;
+        case InputDistribution::FewUnique: {
+            std::uniform_int_distribution<int> values(0, 7);
+            for (int& v : data) v = values(rng);
+            break;
+        }
+    }
+    return data;
+}
+
+namespace {
+
+// Merge sort also runs on linked lists holding the same input: one value per
+// node, unrolled nodes and std::list. reset() copies a list built in input
+// order, so every run starts from nodes laid out front to back in memory.
+class SortWorkload : public Workload {
+public:
+    explicit SortWorkload(Algorithm a) : alg(a) {}
+    void prepare(const WorkloadSpec& spec) override {
+        input = generateInput(spec.n, spec.distribution, spec.seed);
+        work = input;
+        arity = HEAP_ARITIES[spec.variant < HEAP_ARITIES.size() ? spec.variant : 0];
+        listVariant = alg == Algorithm::MergeSort && spec.variant < MERGE_VARIANTS.size() ? spec.variant : ARRAY;
+        builtList = LinkedList(listVariant == UNROLLED_LIST ? LinkedList::UNROLLED_NODE_ELEMENTS : 1);
+        list = LinkedList(); // Copying into a fresh list sizes its arena to this input
+        if (listVariant == LIST || listVariant == UNROLLED_LIST) {
+            for (int v : input) builtList.pushBack(v);
+        }
+        // Merge and quick sort fork onto a work-stealing pool unless one thread is asked for
+        parallel.pool = nullptr;
+        if (hasParallelSort(alg) && spec.threads != 1) {
+            if (spec.threads == 0) {
+                parallel.pool = &ThreadPool::shared();
+            } else {
+                if (!ownPool || ownPool->size() != spec.threads) ownPool = std::make_unique<ThreadPool>(spec.threads);
+                parallel.pool = ownPool.get();
+            }
+        }
+        reset();
+    }
+    void reset() override {
+        switch (listVariant) {
+            case LIST: case UNROLLED_LIST: list = builtList; break;
+            case STD_LIST: stdList.assign(input.begin(), input.end()); break;
+            default: std::copy(input.begin(), input.end(), work.begin()); break;
+        }
+        traffic = ListSortStats();
+    }
+    void run(StepTrace* counters) override {
+        switch (listVariant) {
+            case LIST: case UNROLLED_LIST: list.sort(counters, &traffic); break;
+            case STD_LIST: stdList.sort(); break;
+            default:
+                if (alg == Algorithm::HeapSort) heapSort(work, counters, arity);
+                else runSort(alg, work, counters, parallel);
+                break;
+        }
+    }
+    size_t elementCount() const override { return input.size(); }
+    bool verify() const override {
+        switch (listVariant) {
+            case LIST: case UNROLLED_LIST: return list.size() == input.size() && std::is_sorted(list.begin(), list.end());
+            case STD_LIST: return std::is_sorted(stdList.begin(), stdList.end());
+            default: return std::is_sorted(work.begin(), work.end());
+        }
+    }
+    bool usesThreads() const override { return hasParallelSort(alg); }
+    // Heap sort compares node widths, merge sort arrays against lists
+    std::vector<std::string> variants() const override {
+        if (alg == Algorithm::HeapSort) return {"4-ary", "binary", "8-ary"};
+        if (alg == Algorithm::MergeSort) return MERGE_VARIANTS;
+        return {};
+    }
+    std::string counterSummary() const override {
+        if (listVariant != LIST && listVariant != UNROLLED_LIST) return "";
+        double perElement = 1.0 / static_cast<double>(std::max<size_t>(input.size(), 1));
+        return "node_hops=" + std::to_string(traffic.nodeHops) + ";lines_entered=" + std::to_string(traffic.linesEntered) +
+               ";link_writes=" + std::to_string(traffic.linkWrites) + ";element_moves=" + std::to_string(traffic.elementMoves) +
+               ";bytes_per_element=" + std::to_string(static_cast<double>(list.memoryBytes()) * perElement);
+    }
+
+private:
+    inline static const std::vector<unsigned> HEAP_ARITIES = {4, 2, 8};
+    inline static const std::vector<std::string> MERGE_VARIANTS = {"array", "list", "unrolled-list", "std-list"};
+    static constexpr size_t ARRAY = 0;
+    static constexpr size_t LIST = 1;
+    static constexpr size_t UNROLLED_LIST = 2;
+    static constexpr size_t STD_LIST = 3;
+    Algorithm alg;
+    unsigned arity = 4;
+    size_t listVariant = ARRAY;
+    vector<int> input;
+    vector<int> work;
+    LinkedList builtList, list;
+    std::list<int> stdList;
+    ListSortStats traffic;
+    ParallelSortOptions parallel;
+    std::unique_ptr<ThreadPool> ownPool;
+};
+
+// Radix sort over each key type it supports, widened from the same generated input
+class RadixSortWorkload : public Workload {
+public:
+    void prepare(const WorkloadSpec& spec) override {
+        input = generateInput(spec.n, spec.distribution, spec.seed);
+        variant = spec.variant < VARIANTS.size() ? spec.variant : 0;
+        options.digitBits = variant == 0 ? 8 : 11;
+        options.threads = spec.threads;
+        // Centered on zero so the sign handling of the key transforms is exercised
+        int64_t center = static_cast<int64_t>(input.size()) * 2;
+        floats.resize(variant == 2 ? input.size() : 0);
+        wide.resize(variant == 3 ? input.size() : 0);
+        for (size_t i = 0; i < floats.size(); ++i) floats[i] = 0.25f * static_cast<float>(input[i] - center);
+        for (size_t i = 0; i < wide.size(); ++i) wide[i] = (input[i] - center) * 1000003;
+        reset();
+    }
+    void reset() override {
+        work = input;
+        floatWork = floats;
+        wideWork = wide;
+    }
+    void run(StepTrace* counters) override {
+        switch (variant) {
+            case 2: radixSortKeys(floatWork, options, counters); break;
+            case 3: radixSortKeys(wideWork, options, counters); break;
+            default: radixSortKeys(work, options, counters); break;
+        }
+    }
+    size_t elementCount() const override { return input.size(); }
+    bool verify() const override {
+        switch (variant) {
+            case 2: return std::is_sorted(floatWork.begin(), floatWork.end());
+            case 3: return std::is_sorted(wideWork.begin(), wideWork.end());
+            default: return std::is_sorted(work.begin(), work.end());
+        }
+    }
+    bool usesThreads() const override { return true; }
+    std::vector<std::string> variants() const override { return VARIANTS; }
+
+private:
+    inline static const std::vector<std::string> VARIANTS = {"8-bit", "11-bit", "float-11-bit", "int64-11-bit"};
+    RadixSortOptions options;
+    size_t variant = 0;
+    vector<int> input, work;
+    vector<float> floats, floatWork;
+    vector<int64_t> wide, wideWork;
+};
+
+// Search trees: every run builds the tree from spec.n keys, one insert at a
+// time in generated order (or by bulk load from the sorted keys), looks up n
+// keys of which half are present, then erases a random half of the distinct
+// keys. std::set does the same as the reference.
+class TreeWorkload : public Workload {
+public:
+    explicit TreeWorkload(DataStructure ds) : kind(ds) {}
+    void prepare(const WorkloadSpec& spec) override {
+        // Always random: sorted input would turn the plain BST into a list
+        data = generateInput(spec.n, InputDistribution::Random, spec.seed);
+        variant = spec.variant < VARIANTS.size() ? spec.variant : 0;
+        sorted = data;
+        std::sort(sorted.begin(), sorted.end());
+        sorted.erase(std::unique(sorted.begin(), sorted.end()), sorted.end());
+        erasing = sorted;
+        std::shuffle(erasing.begin(), erasing.end(), std::mt19937(spec.seed + 1));
+        erasing.resize(erasing.size() / 2);
+        reset();
+    }
+    void reset() override {
+        switch (kind) {
+            case DataStructure::AVLTree: tree = std::make_unique<AVLTree>(); break;
+            case DataStructure::RedBlackTree: tree = std::make_unique<RedBlackTree>(); break;
+            default: tree = std::make_unique<BinarySearchTree>(); break;
+        }
+        ordered.clear();
+        hits = 0;
+        erased = 0;
+    }
+    void run(StepTrace* counters) override {
+        size_t n = data.size();
+        if (variant == STD_SET) {
+            for (int key : data) ordered.insert(key);
+            for (size_t i = 0; i < n; ++i) hits += ordered.count(i % 2 == 0 ? data[i] : -1 - static_cast<int>(i));
+            for (int key : erasing) erased += ordered.erase(key);
+            return;
+        }
+        if (variant == BULK_LOAD) {
+            tree->bulkLoad(sorted);
+        } else {
+            for (int key : data) tree->insert(key);
+        }
+        for (size_t i = 0; i < n; ++i) hits += tree->contains(i % 2 == 0 ? data[i] : -1 - static_cast<int>(i));
+        for (int key : erasing) erased += tree->erase(key);
+        if (counters) counters->addWrites(tree->getRotations());
+    }
+    size_t elementCount() const override { return data.size() * 2 + erasing.size(); } // Inserts, lookups and erases
+    bool usesDistribution() const override { return false; }
+    bool verify() const override {
+        size_t size = variant == STD_SET ? ordered.size() : tree->size();
+        if (hits != (data.size() + 1) / 2 || erased != erasing.size() || size != sorted.size() - erasing.size()) return false;
+        if (variant == STD_SET) return true;
+        // Only the survivors are still found, and the red-black invariants held through the erases
+        size_t kept = 0;
+        for (int key : sorted) kept += tree->contains(key);
+        if (kept != size) return false;
+        if (auto* redBlack = dynamic_cast<const RedBlackTree*>(tree.get())) return redBlack->blackHeight() >= 0;
+        return true;
+    }
+    std::vector<std::string> variants() const override { return VARIANTS; }
+    std::string counterSummary() const override {
+        if (variant == STD_SET) return "";
+        double nodes = static_cast<double>(std::max<size_t>(tree->size(), 1));
+        return "height=" + std::to_string(tree->height()) + ";rotations=" + std::to_string(tree->getRotations()) +
+               ";bytes_per_node=" + std::to_string(static_cast<double>(tree->memoryBytes()) / nodes);
+    }
+
+private:
+    inline static const std::vector<std::string> VARIANTS = {"insert", "bulk-load", "std-set"};
+    static constexpr size_t BULK_LOAD = 1;
+    static constexpr size_t STD_SET = 2;
+    DataStructure kind;
+    size_t variant = 0;
+    vector<int> data;
+    vector<int> sorted; // Distinct keys
+    vector<int> erasing; // Half of them, shuffled
+    size_t hits = 0;
+    size_t erased = 0;
+    std::unique_ptr<BinarySearchTree> tree;
+    std::set<int> ordered;
+};
+
+// Order-book replay over spec.n price levels: 16 rounds of 2^15 range adds
+// (three in four touch a single level), each followed by a snapshot of 2^15
+// range queries (half of them within 32 levels), 2^20 operations in all. Every variant folds its answers
+// into a checksum that must match what a different implementation of the same
+// monoid produced in prepare(). The plain Fenwick tree has no range add and
+// applies one point add per level; the batched variants answer each round with
+// SegmentTree::queryBatch.
+class RangeQueryWorkload : public Workload {
+public:
+    explicit RangeQueryWorkload(DataStructure ds) : kind(ds) {}
+    void prepare(const WorkloadSpec& spec) override {
+        vector<int> values = generateInput(spec.n, spec.distribution, spec.seed);
+        initial.assign(values.begin(), values.end());
+        size_t n = std::max<size_t>(initial.size(), 1);
+        std::mt19937 rng(spec.seed + 1);
+        std::uniform_int_distribution<size_t> levels(0, n - 1);
+        std::uniform_int_distribution<int> deltas(-50, 50);
+        updates.resize(ROUNDS * UPDATES_PER_ROUND);
+        for (RangeUpdate& u : updates) {
+            u.first = levels(rng);
+            u.last = std::min(n, u.first + (rng() % 4 == 0 ? 1 + rng() % 64 : 1));
+            u.delta = deltas(rng);
+        }
+        queries.resize(ROUNDS * QUERIES_PER_ROUND);
+        for (RangeQuery& q : queries) {
+            q.first = levels(rng);
+            size_t room = n - q.first;
+            q.last = q.first + 1 + (rng() % 2 == 0 ? rng() % std::min<size_t>(room, 32) : rng() % room);
+        }
+        results.assign(QUERIES_PER_ROUND, 0);
+        if (initial.empty()) { // Nothing to update or ask about
+            updates.clear();
+            queries.clear();
+        }
+
+        size_t first = kind == DataStructure::FenwickTree ? FENWICK : SEGMENT_SUM;
+        size_t chosen = first + (spec.variant < variants().size() ? spec.variant : 0);
+        variant = referenceFor(chosen);
+        reset();
+        run(nullptr);
+        expected = checksum;
+        variant = chosen;
+        reset();
+    }
+    void reset() override {
+        switch (variant) {
+            case FENWICK:              fenwick.build(initial); break;
+            case FENWICK_RANGE_UPDATE: rangeFenwick.build(initial); break;
+            case SEGMENT_SUM: case SEGMENT_SUM_BATCHED: sums.build(initial); break;
+            case SEGMENT_MIN: case SEGMENT_MIN_BATCHED: mins.build(initial); break;
+            default:                   maxes.build(initial); break;
+        }
+        checksum = 0;
+    }
+    void run(StepTrace*) override {
+        switch (variant) {
+            case FENWICK:
+                return replay([&](const RangeUpdate& u) { for (size_t i = u.first; i < u.last; ++i) fenwick.add(i, u.delta); },
+                              [&](const RangeQuery& q) { return fenwick.rangeSum(q.first, q.last); });
+            case FENWICK_RANGE_UPDATE:
+                return replay([&](const RangeUpdate& u) { rangeFenwick.add(u.first, u.last, u.delta); },
+                              [&](const RangeQuery& q) { return rangeFenwick.rangeSum(q.first, q.last); });
+            case SEGMENT_SUM: case SEGMENT_SUM_BATCHED: return replaySegments(sums, variant == SEGMENT_SUM_BATCHED);
+            case SEGMENT_MIN: case SEGMENT_MIN_BATCHED: return replaySegments(mins, variant == SEGMENT_MIN_BATCHED);
+            default: return replaySegments(maxes, variant == SEGMENT_MAX_BATCHED);
+        }
+    }
+    size_t elementCount() const override { return updates.size() + queries.size(); } // Operations per run
+    bool verify() const override { return checksum == expected; }
+    bool usesDistribution() const override { return false; }
+    std::vector<std::string> variants() const override {
+        return kind == DataStructure::FenwickTree ? FENWICK_VARIANTS : SEGMENT_VARIANTS;
+    }
+
+private:
+    struct RangeUpdate {
+        size_t first;
+        size_t last;
+        int64_t delta;
+    };
+
+    inline static const std::vector<std::string> FENWICK_VARIANTS = {"point-add", "range-update"};
+    inline static const std::vector<std::string> SEGMENT_VARIANTS = {
+        "sum", "sum-batched", "min", "min-batched", "max", "max-batched"
+    };
+    // Both trees' variants in one numbering, so either can be checked against the other
+    enum : size_t {
+        FENWICK, FENWICK_RANGE_UPDATE, SEGMENT_SUM, SEGMENT_SUM_BATCHED,
+        SEGMENT_MIN, SEGMENT_MIN_BATCHED, SEGMENT_MAX, SEGMENT_MAX_BATCHED
+    };
+    static constexpr size_t ROUNDS = 16;
+    static constexpr size_t UPDATES_PER_ROUND = size_t(1) << 15;
+    static constexpr size_t QUERIES_PER_ROUND = size_t(1) << 15;
+
+    // Same monoid, different code: sums check against the range Fenwick tree
+    // (which checks against the segment tree), segment trees batched against one at a time
+    static size_t referenceFor(size_t v) {
+        if (v <= SEGMENT_SUM_BATCHED) return v == FENWICK_RANGE_UPDATE ? SEGMENT_SUM : FENWICK_RANGE_UPDATE;
+        return v % 2 == 0 ? v + 1 : v - 1;
+    }
+
+    void fold(int64_t result) { checksum = checksum * 0x100000001B3ull + static_cast<uint64_t>(result); }
+
+    template<typename Update, typename Answer>
+    void replay(Update update, Answer answer) {
+        for (size_t u = 0, q = 0; q < queries.size();) {
+            for (size_t end = u + UPDATES_PER_ROUND; u < end; ++u) update(updates[u]);
+            for (size_t end = q + QUERIES_PER_ROUND; q < end; ++q) fold(answer(queries[q]));
+        }
+    }
+    template<typename Monoid>
+    void replaySegments(SegmentTree<Monoid>& tree, bool batched) {
+        auto update = [&](const RangeUpdate& u) { tree.add(u.first, u.last, u.delta); };
+        if (!batched) return replay(update, [&](const RangeQuery& q) { return tree.query(q.first, q.last); });
+        for (size_t u = 0, q = 0; q < queries.size(); q += QUERIES_PER_ROUND) {
+            for (size_t end = u + UPDATES_PER_ROUND; u < end; ++u) update(updates[u]);
+            tree.queryBatch(queries.data() + q, QUERIES_PER_ROUND, results.data());
+            for (int64_t r : results) fold(r);
+        }
+    }
+
+    DataStructure kind;
+    size_t variant = 0;
+    vector<int64_t> initial;
+    vector<RangeUpdate> updates;
+    vector<RangeQuery> queries;
+    vector<int64_t> results; // One round's batched answers
+    uint64_t checksum = 0;
+    uint64_t expected = 0;
+    FenwickTree fenwick;
+    RangeFenwickTree rangeFenwick;
+    SegmentTree<SumMonoid> sums;
+    SegmentTree<MinMonoid> mins;
+    SegmentTree<MaxMonoid> maxes;
+};
+
+// A fixed batch of lookups against a sorted array of spec.n keys, so growing n
+// walks the search through L1, L2, L3 and DRAM. Counts are per query.
+class SearchWorkload : public Workload {
+public:
+    explicit SearchWorkload(Algorithm a) : alg(a) {}
+    void prepare(const WorkloadSpec& spec) override {
+        sorted = generateInput(spec.n, InputDistribution::Random, spec.seed);
+        std::sort(sorted.begin(), sorted.end());
+        std::mt19937 rng(spec.seed + 1);
+        std::uniform_int_distribution<int> values(-1, static_cast<int>(std::max<size_t>(spec.n, 1) * 4) + 1);
+        keys.resize(QUERY_COUNT);
+        for (int& k : keys) k = values(rng);
+        results.assign(QUERY_COUNT, 0);
+        variant = static_cast<BinarySearchVariant>(spec.variant < BINARY_SEARCH_VARIANT_NAMES.size() ? spec.variant : 0);
+        searcher = std::make_unique<BinarySearcher>(sorted, variant);
+    }
+    void reset() override { stats = {}; }
+    void run(StepTrace* counters) override {
+        if (alg == Algorithm::TernarySearch) {
+            for (size_t q = 0; q < keys.size(); ++q) results[q] = ternarySearch(sorted, keys[q], counters);
+            return;
+        }
+        searcher->lowerBounds(keys.data(), keys.size(), results.data(), &stats);
+        if (counters) counters->addComparisons(stats.probes);
+    }
+    size_t elementCount() const override { return keys.size(); }
+    bool verify() const override {
+        for (size_t q = 0; q < keys.size(); q += 97) {
+            auto lower = std::lower_bound(sorted.begin(), sorted.end(), keys[q]);
+            bool present = lower != sorted.end() && *lower == keys[q];
+            if (alg == Algorithm::TernarySearch) {
+                if (present ? sorted[results[q]] != keys[q] : results[q] != sorted.size()) return false;
+            } else if (results[q] != static_cast<size_t>(lower - sorted.begin())) {
+                return false;
+            }
+        }
+        return true;
+    }
+    bool usesDistribution() const override { return false; }
+    std::vector<std::string> variants() const override {
+        return alg == Algorithm::BinarySearch ? BINARY_SEARCH_VARIANT_NAMES : std::vector<std::string>();
+    }
+    std::string counterSummary() const override {
+        if (alg != Algorithm::BinarySearch) return "";
+        return "ns_per_query=" + std::to_string(stats.nsPerQuery()) + ";probes_per_query=" + std::to_string(stats.probesPerQuery());
+    }
+
+private:
+    static constexpr size_t QUERY_COUNT = size_t(1) << 20;
+    Algorithm alg;
+    BinarySearchVariant variant = BinarySearchVariant::Classic;
+    vector<int> sorted;
+    vector<int> keys;
+    vector<size_t> results;
+    std::unique_ptr<BinarySearcher> searcher;
+    SearchStats stats;
+};
+
+// Key-value workload for the hash table: every run inserts spec.n generated keys into an empty table (duplicates overwrite), looks up n
+// keys of which half are present, then erases every other inserted key. The
+// table starts empty so each run pays for its rehashes.
+class HashTableWorkload : public Workload {
+public:
+    void prepare(const WorkloadSpec& spec) override {
+        data = generateInput(spec.n, spec.distribution, spec.seed);
+        variant = spec.variant < VARIANTS.size() ? spec.variant : 0;
+        // What the run must leave behind: distinct keys minus those erased
+        vector<int> distinct = data, erased;
+        for (size_t i = 1; i < data.size(); i += 2) erased.push_back(data[i]);
+        std::sort(distinct.begin(), distinct.end());
+        distinct.erase(std::unique(distinct.begin(), distinct.end()), distinct.end());
+        std::sort(erased.begin(), erased.end());
+        erased.erase(std::unique(erased.begin(), erased.end()), erased.end());
+        expectedSize = distinct.size() - erased.size();
+        reset();
+    }
+    void reset() override {
+        table = HashTable<int, int>(MAX_LOAD_FACTORS[variant < MAX_LOAD_FACTORS.size() ? variant : 0]);
+        chained = std::unordered_map<int, int>();
+        hits = 0;
+    }
+    void run(StepTrace* counters) override {
+        size_t n = data.size();
+        if (variant < MAX_LOAD_FACTORS.size()) {
+            for (size_t i = 0; i < n; ++i) table.insert(data[i], static_cast<int>(i));
+            for (size_t i = 0; i < n; ++i) hits += table.contains(i % 2 == 0 ? data[i] : -1 - static_cast<int>(i));
+            for (size_t i = 1; i < n; i += 2) table.erase(data[i]);
+            if (counters) counters->addComparisons(table.getStats().probes);
+        } else {
+            for (size_t i = 0; i < n; ++i) chained[data[i]] = static_cast<int>(i);
+            for (size_t i = 0; i < n; ++i) hits += chained.count(i % 2 == 0 ? data[i] : -1 - static_cast<int>(i));
+            for (size_t i = 1; i < n; i += 2) chained.erase(data[i]);
+        }
+    }
+    size_t elementCount() const override { return data.size() * 5 / 2; } // Operations per run
+    bool verify() const override {
+        size_t size = variant < MAX_LOAD_FACTORS.size() ? table.size() : chained.size();
+        return hits == (data.size() + 1) / 2 && size == expectedSize;
+    }
+    std::vector<std::string> variants() const override { return VARIANTS; }
+    std::string counterSummary() const override {
+        if (variant >= MAX_LOAD_FACTORS.size()) return "";
+        const HashTableStats& stats = table.getStats();
+        double ops = static_cast<double>(std::max<size_t>(elementCount(), 1));
+        return "probes_per_op=" + std::to_string(static_cast<double>(stats.probes) / ops) +
+               ";max_probe=" + std::to_string(stats.maxProbe) + ";resizes=" + std::to_string(stats.resizes) +
+               ";shifts=" + std::to_string(stats.shifts) + ";capacity=" + std::to_string(table.capacity());
+    }
+
+private:
+    // The Robin Hood table at three load-factor caps, then chained buckets for reference
+    inline static const std::vector<std::string> VARIANTS = {
+        "robin-hood-0.875", "robin-hood-0.5", "robin-hood-0.95", "std-unordered-map"
+    };
+    inline static const std::vector<float> MAX_LOAD_FACTORS = {0.875f, 0.5f, 0.95f};
+    size_t variant = 0;
+    vector<int> data;
+    size_t expectedSize = 0;
+    size_t hits = 0;
+    HashTable<int, int> table;
+    std::unordered_map<int, int> chained;
+};
+
+// A few lookups per run over an unsorted array (or the same values in a linked
+// list): half the keys are present at random positions, half are absent and
+// scan everything. elementCount() is the number of elements examined, so
+// ns/element compares the scans directly.
+class LinearSearchWorkload : public Workload {
+public:
+    void prepare(const WorkloadSpec& spec) override {
+        data = generateInput(spec.n, spec.distribution, spec.seed);
+        variant = static_cast<LinearSearchVariant>(spec.variant < LINEAR_SEARCH_VARIANT_NAMES.size() ? spec.variant : 0);
+        threads = spec.threads;
+        list.clear();
+        if (variant == LinearSearchVariant::LinkedList) {
+            for (int v : data) list.pushBack(v);
+        }
+        std::mt19937 rng(spec.seed + 1);
+        std::uniform_int_distribution<size_t> positions(0, std::max<size_t>(data.size(), 1) - 1);
+        keys.resize(QUERY_COUNT);
+        examined = 0;
+        for (size_t q = 0; q < QUERY_COUNT; ++q) {
+            keys[q] = q % 2 == 0 && !data.empty() ? data[positions(rng)] : -1 - static_cast<int>(q);
+            size_t first = static_cast<size_t>(std::find(data.begin(), data.end(), keys[q]) - data.begin());
+            examined += first < data.size() ? first + 1 : data.size();
+        }
+        results.assign(QUERY_COUNT, 0);
+    }
+    void reset() override {}
+    void run(StepTrace* counters) override {
+        for (size_t q = 0; q < keys.size(); ++q) {
+            switch (variant) {
+                case LinearSearchVariant::Scalar:     results[q] = scalarLinearSearch(data.data(), data.size(), keys[q]); break;
+                case LinearSearchVariant::Simd:       results[q] = linearSearch(data.data(), data.size(), keys[q]); break;
+                case LinearSearchVariant::Parallel:   results[q] = parallelLinearSearch(data, keys[q], threads); break;
+                case LinearSearchVariant::LinkedList: results[q] = linearSearch(list, keys[q]); break;
+            }
+        }
+        if (counters) counters->addComparisons(examined);
+    }
+    size_t elementCount() const override { return examined; }
+    bool verify() const override {
+        for (size_t q = 0; q < keys.size(); ++q) {
+            if (results[q] != static_cast<size_t>(std::find(data.begin(), data.end(), keys[q]) - data.begin())) return false;
+        }
+        return true;
+    }
+    bool usesThreads() const override { return true; }
+    std::vector<std::string> variants() const override { return LINEAR_SEARCH_VARIANT_NAMES; }
+
+private:
+    static constexpr size_t QUERY_COUNT = 16;
+    LinearSearchVariant variant = LinearSearchVariant::Scalar;
+    unsigned threads = 0;
+    vector<int> data;
+    LinkedList list;
+    vector<int> keys;
+    vector<size_t> results;
+    size_t examined = 0;
+};
+
+// One full traversal of a tree of spec.n keys per run. The distribution picks
+// the shape: random inserts into a BST (height around 3 log n), a right or left
+// path of n nodes (the BST that sorted or reversed inserts build), or a complete
+// tree for few-unique. The visit order is hashed and checked against the other
+// iterative method. Recursion refuses paths deeper than RECURSION_DEPTH_LIMIT;
+// such a run visits what it can, counts too_deep=1 and is not an error.
+class TraversalWorkload : public Workload {
+public:
+    explicit TraversalWorkload(Algorithm alg) : order(traversalOrderOf(alg)) {}
+    void prepare(const WorkloadSpec& spec) override {
+        method = static_cast<TraversalMethod>(spec.variant < TRAVERSAL_METHOD_NAMES.size() ? spec.variant : 0);
+        vector<int> keys = generateInput(spec.n, spec.distribution, spec.seed);
+        switch (spec.distribution) {
+            case InputDistribution::Random:
+                tree.clear();
+                tree.reserve(keys.size());
+                for (int key : keys) tree.insert(key);
+                break;
+            case InputDistribution::Sorted:   tree.buildPath(keys); break;
+            case InputDistribution::Reversed: tree.buildPath(keys, true); break;
+            case InputDistribution::FewUnique: tree.buildLevelOrder(keys); break;
+        }
+        // The run is checked against whichever iterative method it isn't
+        TreeTraversal reference(tree, order, method == TraversalMethod::Stack ? TraversalMethod::Morris : TraversalMethod::Stack);
+        expectedHash = 0;
+        for (NodeIndex n : reference) expectedHash = mix(expectedHash, tree.key(n));
+        reset();
+    }
+    void reset() override {
+        hash = 0;
+        visited = 0;
+        tooDeep = false;
+        peakStack = 0;
+        linkWrites = 0;
+    }
+    void run(StepTrace* counters) override {
+        if (method == TraversalMethod::Recursive) {
+            TraversalEnd end = traverseRecursive(tree, order, [&](NodeIndex n) {
+                hash = mix(hash, tree.key(n));
+                ++visited;
+                return true;
+            });
+            tooDeep = end == TraversalEnd::TooDeep;
+        } else {
+            TreeTraversal walk(tree, order, method);
+            for (NodeIndex n : walk) {
+                hash = mix(hash, tree.key(n));
+                ++visited;
+            }
+            peakStack = walk.peakStack();
+            linkWrites = walk.linkWrites();
+        }
+        if (counters) counters->addWrites(linkWrites);
+    }
+    size_t elementCount() const override { return visited; }
+    bool verify() const override { return tooDeep || (visited == tree.size() && hash == expectedHash); }
+    std::vector<std::string> variants() const override { return TRAVERSAL_METHOD_NAMES; }
+    std::string counterSummary() const override {
+        return "height=" + std::to_string(tree.height()) + ";peak_stack=" + std::to_string(peakStack) +
+               ";link_writes=" + std::to_string(linkWrites) + ";too_deep=" + std::to_string(tooDeep ? 1 : 0);
+    }
+
+private:
+    static uint64_t mix(uint64_t h, int key) { return (h ^ static_cast<uint32_t>(key)) * 0x100000001B3ull; }
+
+    TraversalOrder order;
+    TraversalMethod method = TraversalMethod::Recursive;
+    BinarySearchTree tree;
+    uint64_t expectedHash = 0;
+    uint64_t hash = 0;
+    size_t visited = 0;
+    bool tooDeep = false;
+    size_t peakStack = 0;
+    uint64_t linkWrites = 0;
+};
+
+// Dictionary-like words: stems of one to four syllables, each with a few of
+// the usual suffixes, so words share prefixes and endings much as English
+// does. Duplicates are possible and are left in.
+vector<std::string> generateWords(size_t n, uint32_t seed) {
+    static const char* const ONSETS[] = {"", "b", "c", "ch", "d", "f", "g", "h", "j", "k", "l", "m", "n", "p", "pr",
+                                         "qu", "r", "s", "sh", "st", "t", "th", "tr", "v", "w", "y", "z"};
+    static const char* const NUCLEI[] = {"a", "e", "i", "o", "u", "ea", "ou", "ai", "ee", "y"};
+    static const char* const CODAS[] = {"", "", "", "n", "r", "s", "t", "l", "nd", "st", "ck", "ng", "m"};
+    static const char* const SUFFIXES[] = {"", "s", "ed", "ing", "er", "ers", "ly", "ness", "able", "tion", "al", "est"};
+    std::mt19937 rng(seed);
+    std::uniform_int_distribution<int> syllables(1, 4), derived(1, 4);
+    vector<std::string> words;
+    words.reserve(n);
+    std::string stem;
+    while (words.size() < n) {
+        stem.clear();
+        for (int s = syllables(rng); s > 0; --s) {
+            stem += ONSETS[rng() % std::size(ONSETS)];
+            stem += NUCLEI[rng() % std::size(NUCLEI)];
+            stem += CODAS[rng() % std::size(CODAS)];
+        }
+        for (int d = derived(rng); d > 0 && words.size() < n; --d) words.push_back(stem + SUFFIXES[rng() % std::size(SUFFIXES)]);
+    }
+    return words;
+}
+
+// Dictionary workload for the trie: every run loads spec.n generated
+// words (bulk, from the sorted list, or one insert at a time in generated
+// order), looks up n words of which half are present, and completes n/8
+// prefixes of one to four letters, taking the first 8 words of each in order
+// the way an autocomplete box does. The absent words differ from a present one
+// only in their last letter, so they cost a full descent too. std::set is the
+// comparison; the counters include what a 26-pointer-per-node trie would take.
+class TrieWorkload : public Workload {
+public:
+    void prepare(const WorkloadSpec& spec) override {
+        variant = spec.variant < VARIANTS.size() ? spec.variant : 0;
+        words = generateWords(spec.n, spec.seed);
+        sorted = words;
+        std::sort(sorted.begin(), sorted.end());
+        vector<std::string> distinct = sorted;
+        distinct.erase(std::unique(distinct.begin(), distinct.end()), distinct.end());
+        expectedSize = distinct.size();
+        queries.resize(words.size());
+        for (size_t i = 0; i < words.size(); ++i) {
+            queries[i] = words[i];
+            if (i % 2 == 1) queries[i].back() = '~'; // Never generated
+        }
+        std::mt19937 rng(spec.seed + 1);
+        prefixes.resize(words.size() / 8);
+        for (std::string& prefix : prefixes) {
+            prefix = words[rng() % words.size()].substr(0, 1 + rng() % 4);
+        }
+        // Answers from the sorted list, and the nodes of an uncompressed trie:
+        // one per distinct prefix, i.e. per byte a word doesn't share with the one before
+        expectedHits = (queries.size() + 1) / 2;
+        expectedHash = 0;
+        expectedCompletions = 0;
+        for (const std::string& prefix : prefixes) {
+            auto it = std::lower_bound(distinct.begin(), distinct.end(), prefix);
+            for (size_t k = 0; k < COMPLETIONS && it != distinct.end() && it->compare(0, prefix.size(), prefix) == 0; ++k, ++it) {
+                expectedHash = mix(expectedHash, *it);
+                ++expectedCompletions;
+            }
+        }
+        naiveNodes = 1;
+        for (size_t i = 0; i < distinct.size(); ++i) {
+            size_t shared = 0;
+            if (i > 0) {
+                while (shared < distinct[i].size() && shared < distinct[i - 1].size() && distinct[i][shared] == distinct[i - 1][shared]) ++shared;
+            }
+            naiveNodes += distinct[i].size() - shared;
+        }
+        reset();
+    }
+    void reset() override {
+        trie = Trie(); // Each run grows its arenas from nothing
+        ordered.clear();
+        hits = 0;
+        hash = 0;
+        completions = 0;
+    }
+    void run(StepTrace* counters) override {
+        if (variant == STD_SET) {
+            for (const std::string& word : words) ordered.insert(word);
+            for (const std::string& query : queries) hits += ordered.count(query);
+            for (const std::string& prefix : prefixes) {
+                auto it = ordered.lower_bound(prefix);
+                for (size_t k = 0; k < COMPLETIONS && it != ordered.end() && it->compare(0, prefix.size(), prefix) == 0; ++k, ++it) {
+                    hash = mix(hash, *it);
+                    ++completions;
+                }
+            }
+            return;
+        }
+        if (variant == BULK_LOAD) {
+            trie.bulkLoad(sorted);
+        } else {
+            for (const std::string& word : words) trie.insert(word);
+        }
+        for (const std::string& query : queries) hits += trie.contains(query);
+        for (const std::string& prefix : prefixes) {
+            Trie::PrefixRange range = trie.withPrefix(prefix);
+            size_t k = 0;
+            for (auto it = range.begin(); k < COMPLETIONS && it != range.end(); ++it, ++k) {
+                hash = mix(hash, *it);
+                ++completions;
+            }
+        }
+        if (counters) counters->addComparisons(completions);
+    }
+    size_t elementCount() const override { return words.size() + queries.size() + prefixes.size(); } // Operations per run
+    bool verify() const override {
+        size_t size = variant == STD_SET ? ordered.size() : trie.size();
+        return size == expectedSize && hits == expectedHits && hash == expectedHash && completions == expectedCompletions;
+    }
+    bool usesDistribution() const override { return false; }
+    std::vector<std::string> variants() const override { return VARIANTS; }
+    std::string counterSummary() const override {
+        double perWord = 1.0 / static_cast<double>(std::max<size_t>(expectedSize, 1));
+        std::string naive = "naive_bytes_per_word=" + std::to_string(static_cast<double>(naiveNodes * NAIVE_NODE_BYTES) * perWord);
+        if (variant == STD_SET) return naive;
+        TrieStats stats = trie.stats();
+        return "bytes_per_word=" + std::to_string(static_cast<double>(trie.memoryBytes()) * perWord) + ";" + naive +
+               ";leaves=" + std::to_string(stats.leaves) + ";node4=" + std::to_string(stats.node4) +
+               ";node16=" + std::to_string(stats.node16) + ";node48=" + std::to_string(stats.node48) +
+               ";node256=" + std::to_string(stats.node256);
+    }
+
+private:
+    static uint64_t mix(uint64_t h, const std::string& word) {
+        for (char c : word) h = (h ^ static_cast<unsigned char>(c)) * 0x100000001B3ull;
+        return (h ^ 0xFF) * 0x100000001B3ull; // Word boundary
+    }
+
+    inline static const std::vector<std::string> VARIANTS = {"bulk-load", "insert", "std-set"};
+    static constexpr size_t BULK_LOAD = 0;
+    static constexpr size_t STD_SET = 2;
+    static constexpr size_t COMPLETIONS = 8;
+    static constexpr size_t NAIVE_NODE_BYTES = 26 * sizeof(void*) + sizeof(void*); // Children plus an end-of-word flag, padded
+    size_t variant = 0;
+    vector<std::string> words;
+    vector<std::string> sorted; // Duplicates included; bulkLoad drops them
+    vector<std::string> queries;
+    vector<std::string> prefixes;
+    size_t expectedSize = 0;
+    size_t expectedHits = 0;
+    uint64_t expectedHash = 0;
+    size_t expectedCompletions = 0;
+    size_t naiveNodes = 0;
+    Trie trie;
+    std::set<std::string> ordered;
+    size_t hits = 0;
+    uint64_t hash = 0;
+    size_t completions = 0;
+};
+
+// Step-event handoff: for the queues, spec.n TraceEvents go from producer
+// threads to consumer threads through a 1024-slot SPSC or MPMC ring, or through
+// the mutex-guarded queue they are measured against. The rings run one producer
+// and one consumer per two threads (SPSC always one of each); a thread that
+// finds its ring full or empty yields. The deques are single-threaded: events
+// go in at both ends and come out at both ends of a window of 4096, on the
+// chunked Deque or on std::deque. Consumers sum the event indices, and the SPSC
+// consumer also checks they arrive in order.
+class QueueWorkload : public Workload {
+public:
+    explicit QueueWorkload(DataStructure ds) : kind(ds) {}
+    void prepare(const WorkloadSpec& spec) override {
+        size_t first = kind == DataStructure::Deque ? DEQUE : SPSC;
+        variant = first + (spec.variant < variants().size() ? spec.variant : 0);
+        n = spec.n;
+        unsigned threads = spec.threads ? spec.threads : std::max(1u, std::thread::hardware_concurrency());
+        pairs = variant == SPSC ? 1 : std::max(1u, threads / 2);
+        reset();
+    }
+    void reset() override {
+        sum = 0;
+        ordered = true;
+        pushRetries = 0;
+        popRetries = 0;
+    }
+    void run(StepTrace*) override {
+        switch (variant) {
+            case SPSC: {
+                SpscRing<TraceEvent> ring(RING_CAPACITY);
+                handOff([&](const TraceEvent& e) { return ring.tryPush(e); },
+                        [&](TraceEvent& e) { return ring.tryPop(e); });
+                break;
+            }
+            case MPMC: {
+                MpmcRing<TraceEvent> ring(RING_CAPACITY);
+                handOff([&](const TraceEvent& e) { return ring.tryPush(e); },
+                        [&](TraceEvent& e) { return ring.tryPop(e); });
+                break;
+            }
+            case MUTEX: {
+                MutexQueue<TraceEvent> queue;
+                handOff([&](const TraceEvent& e) {
+                            queue.push(e);
+                            return true;
+                        },
+                        [&](TraceEvent& e) { return queue.tryPop(e); });
+                break;
+            }
+            case DEQUE: {
+                Deque<TraceEvent> window;
+                slide(window, [](Deque<TraceEvent>& d, const TraceEvent& e, bool back) { back ? d.pushBack(e) : d.pushFront(e); },
+                      [](Deque<TraceEvent>& d, bool back) {
+                          TraceEvent e = back ? d.back() : d.front();
+                          back ? d.popBack() : d.popFront();
+                          return e;
+                      });
+                break;
+            }
+            default: {
+                std::deque<TraceEvent> window;
+                slide(window, [](std::deque<TraceEvent>& d, const TraceEvent& e, bool back) { back ? d.push_back(e) : d.push_front(e); },
+                      [](std::deque<TraceEvent>& d, bool back) {
+                          TraceEvent e = back ? d.back() : d.front();
+                          back ? d.pop_back() : d.pop_front();
+                          return e;
+                      });
+                break;
+            }
+        }
+    }
+    size_t elementCount() const override { return n; } // Events handed over
+    bool verify() const override {
+        uint64_t expected = static_cast<uint64_t>(n) * (n > 0 ? n - 1 : 0) / 2;
+        return sum == expected && ordered;
+    }
+    bool usesDistribution() const override { return false; }
+    bool usesThreads() const override { return kind != DataStructure::Deque; }
+    std::vector<std::string> variants() const override {
+        return kind == DataStructure::Deque ? DEQUE_VARIANTS : QUEUE_VARIANTS;
+    }
+    std::string counterSummary() const override {
+        if (variant >= DEQUE) return "";
+        return "producers=" + std::to_string(pairs) + ";consumers=" + std::to_string(pairs) +
+               ";push_retries=" + std::to_string(pushRetries) + ";pop_retries=" + std::to_string(popRetries);
+    }
+
+private:
+    static TraceEvent event(size_t i) {
+        return TraceEvent{TraceOp::Visit, 0, 0, static_cast<uint32_t>(i), static_cast<uint32_t>(i), static_cast<int32_t>(i)};
+    }
+
+    // Producer p pushes events p, p + pairs, ...; the consumers share a count of
+    // what has been taken and stop once it reaches n
+    template<typename Push, typename Pop>
+    void handOff(Push push, Pop pop) {
+        std::atomic<size_t> taken{0};
+        std::atomic<uint64_t> total{0}, pushFails{0}, popFails{0};
+        std::atomic<bool> inOrder{true};
+        std::uint32_t scope = AllocationScope::current(); // Count the threads' allocations with the run's
+        vector<std::thread> threads;
+        for (unsigned p = 0; p < pairs; ++p) {
+            threads.emplace_back([&, p] {
+                AllocationScopeJoin join(scope);
+                uint64_t fails = 0;
+                for (size_t i = p; i < n; i += pairs) {
+                    TraceEvent e = event(i);
+                    while (!push(e)) {
+                        ++fails;
+                        std::this_thread::yield();
+                    }
+                }
+                pushFails += fails;
+            });
+        }
+        for (unsigned c = 0; c < pairs; ++c) {
+            threads.emplace_back([&] {
+                AllocationScopeJoin join(scope);
+                uint64_t local = 0, fails = 0;
+                size_t next = 0;
+                TraceEvent e;
+                while (taken.load(std::memory_order_relaxed) < n) {
+                    if (!pop(e)) {
+                        ++fails;
+                        std::this_thread::yield();
+                        continue;
+                    }
+                    taken.fetch_add(1, std::memory_order_relaxed);
+                    local += e.a;
+                    if (pairs == 1 && e.a != next++) inOrder = false;
+                }
+                total += local;
+                popFails += fails;
+            });
+        }
+        for (std::thread& t : threads) t.join();
+        sum = total;
+        ordered = inOrder;
+        pushRetries = pushFails;
+        popRetries = popFails;
+    }
+
+    // Even events go in at the back, odd ones at the front; past WINDOW events,
+    // every push is matched by a pop from the front or (every third) the back
+    template<typename Container, typename Push, typename Pop>
+    void slide(Container& window, Push push, Pop pop) {
+        size_t held = 0;
+        for (size_t i = 0; i < n; ++i) {
+            push(window, event(i), i % 2 == 0);
+            if (++held > WINDOW) {
+                sum += pop(window, i % 3 == 0).a;
+                --held;
+            }
+        }
+        for (; held > 0; --held) sum += pop(window, false).a;
+    }
+
+    inline static const std::vector<std::string> QUEUE_VARIANTS = {"spsc-ring", "mpmc-ring", "mutex-queue"};
+    inline static const std::vector<std::string> DEQUE_VARIANTS = {"chunked", "std-deque"};
+    // Queue variants first, then the deques
+    static constexpr size_t SPSC = 0;
+    static constexpr size_t MPMC = 1;
+    static constexpr size_t MUTEX = 2;
+    static constexpr size_t DEQUE = 3;
+    static constexpr size_t RING_CAPACITY = 1024;
+    static constexpr size_t WINDOW = 4096;
+    DataStructure kind;
+    size_t variant = 0;
+    size_t n = 0;
+    unsigned pairs = 1;
+    uint64_t sum = 0;
+    bool ordered = true;
+    uint64_t pushRetries = 0;
+    uint64_t popRetries = 0;
+};
+
+// spec.n bytes of generated text (the trie's words, spaces and the odd comma)
+// streamed through the Huffman codec: compressed, or decompressed from a
+// stream compressed once in prepare(). verify() decompresses the compressed
+// output, so it checks the round trip either way.
+class HuffmanWorkload : public Workload {
+public:
+    void prepare(const WorkloadSpec& spec) override {
+        variant = spec.variant < VARIANTS.size() ? spec.variant : 0;
+        text.clear();
+        text.reserve(spec.n + 16);
+        vector<std::string> words = generateWords(spec.n / 5 + 1, spec.seed);
+        for (size_t i = 0; text.size() < spec.n; ++i) {
+            text += words[i % words.size()];
+            text += i % 11 == 10 ? ", " : " ";
+        }
+        text.resize(spec.n);
+        std::istringstream in(text);
+        std::ostringstream out;
+        huffmanCompress(in, out);
+        packed = out.str();
+        reset();
+    }
+    void reset() override {
+        source.clear();
+        source.str(variant == DECOMPRESS ? packed : text);
+        sink.str("");
+        sink.clear();
+        ok = false;
+        stats = HuffmanStreamStats();
+    }
+    void run(StepTrace*) override {
+        ok = variant == DECOMPRESS ? huffmanDecompress(source, sink, &stats) : huffmanCompress(source, sink, &stats);
+    }
+    size_t elementCount() const override { return text.size(); } // Plain bytes
+    bool verify() const override {
+        if (!ok) return false;
+        if (variant == DECOMPRESS) return sink.str() == text;
+        std::istringstream in(sink.str());
+        std::ostringstream back;
+        return huffmanDecompress(in, back) && back.str() == text;
+    }
+    bool usesDistribution() const override { return false; }
+    std::vector<std::string> variants() const override { return VARIANTS; }
+    std::string counterSummary() const override {
+        double bitsPerByte = text.empty() ? 0.0 : 8.0 * static_cast<double>(packed.size()) / static_cast<double>(text.size());
+        return "bits_per_byte=" + std::to_string(bitsPerByte) + ";chunks=" + std::to_string(stats.chunks) +
+               ";mb_per_s=" + std::to_string(stats.megabytesPerSecond());
+    }
+
+private:
+    inline static const std::vector<std::string> VARIANTS = {"compress", "decompress"};
+    static constexpr size_t DECOMPRESS = 1;
+    size_t variant = 0;
+    std::string text;
+    std::string packed;
+    std::istringstream source;
+    std::ostringstream sink;
+    bool ok = false;
+    HuffmanStreamStats stats;
+};
+
+// Random CSR graph with spec.n vertices and spec.averageDegree arcs per vertex
+class GraphWorkload : public Workload {
+public:
+    void prepare(const WorkloadSpec& spec) override {
+        graph = generateRandomGraph(static_cast<VertexId>(spec.n), spec.averageDegree, spec.seed, directed());
+    }
+    void reset() override {}
+    size_t elementCount() const override { return graph.vertexCount() + graph.arcCount(); }
+    bool usesDistribution() const override { return false; }
+    bool usesDegree() const override { return true; }
+
+protected:
+    virtual bool directed() const { return false; }
+    Graph graph;
+};
+
+// R-MAT graph, the social-network shape BFS is tuned for. One thread runs the
+// sequential reference BFS so the two modes can be compared directly.
+class BfsWorkload : public GraphWorkload {
+public:
+    void prepare(const WorkloadSpec& spec) override {
+        graph = generateRMatGraph(static_cast<VertexId>(spec.n), spec.averageDegree, spec.seed);
+        // Start from the biggest hub; R-MAT leaves many vertices isolated
+        source = 0;
+        for (VertexId v = 1; v < graph.vertexCount(); ++v) {
+            if (graph.degree(v) > graph.degree(source)) source = v;
+        }
+        options.mode = spec.threads == 1 ? BfsMode::Reference : BfsMode::Parallel;
+        options.threads = spec.threads;
+    }
+    void run(StepTrace* counters) override { result = breadthFirstSearch(graph, source, options, counters); }
+    bool usesThreads() const override { return true; }
+    bool verify() const override {
+        VertexId n = graph.vertexCount();
+        if (n == 0) return true;
+        if (result.depth.size() != n || result.depth[source] != 0) return false;
+        for (VertexId u = 0; u < n; ++u) {
+            if (result.depth[u] == NO_VERTEX) continue;
+            // Tree arcs go exactly one level down; no arc may skip a level
+            if (u != source && result.depth[result.parent[u]] + 1 != result.depth[u]) return false;
+            for (VertexId v : graph.neighbors(u)) {
+                if (result.depth[v] == NO_VERTEX || result.depth[v] > result.depth[u] + 1) return false;
+            }
+        }
+        return true;
+    }
+
+private:
+    VertexId source = 0;
+    BfsOptions options;
+    BfsResult result;
+};
+
+// Road-network-like grid with about spec.n vertices; the variant picks the queue backend
+class ShortestPathWorkload : public GraphWorkload {
+public:
+    void prepare(const WorkloadSpec& spec) override {
+        VertexId side = 1;
+        while (static_cast<std::size_t>(side) * side < spec.n) ++side;
+        graph = generateGridGraph(side, side, spec.seed, 0.85);
+        queue = backends[spec.variant < backends.size() ? spec.variant : 0];
+    }
+    bool usesDegree() const override { return false; }
+    std::vector<std::string> variants() const override {
+        std::vector<std::string> names;
+        for (PriorityQueueKind kind : backends) names.push_back(PRIORITY_QUEUE_NAMES[static_cast<size_t>(kind)]);
+        return names;
+    }
+    std::string counterSummary() const override {
+        return "pushes=" + std::to_string(stats.pushes) + ";pops=" + std::to_string(stats.pops) +
+               ";decrease_keys=" + std::to_string(stats.decreaseKeys) + ";stale_pops=" + std::to_string(stats.stalePops);
+    }
+
+protected:
+    std::vector<PriorityQueueKind> backends = {PriorityQueueKind::IndexedDary, PriorityQueueKind::LazyBinary,
+                                               PriorityQueueKind::Pairing, PriorityQueueKind::Radix,
+                                               PriorityQueueKind::MinHeap};
+    PriorityQueueKind queue = PriorityQueueKind::IndexedDary;
+    PriorityQueueStats stats;
+};
+
+class DijkstraWorkload : public ShortestPathWorkload {
+public:
+    void run(StepTrace* counters) override { dijkstra(graph, 0, dist, parent, queue, counters, &stats); }
+    bool verify() const override {
+        if (graph.vertexCount() == 0) return true;
+        if (dist[0] != 0) return false;
+        // Every arc is relaxed and every reached vertex is explained by its parent arc
+        for (VertexId u = 0; u < graph.vertexCount(); ++u) {
+            if (dist[u] == INF_DISTANCE) continue;
+            Graph::NeighborRange range = graph.neighbors(u);
+            bool explained = (u == 0);
+            for (size_t i = 0; i < range.size(); ++i) {
+                VertexId v = range.target(i);
+                if (dist[u] + range.weight(i) < dist[v]) return false;
+                if (v == parent[u] && dist[v] + range.weight(i) == dist[u]) explained = true;
+            }
+            if (!explained) return false;
+        }
+        return true;
+    }
+
+private:
+    vector<Distance> dist;
+    vector<VertexId> parent;
+};
+
+class PrimWorkload : public ShortestPathWorkload {
+public:
+    // The radix heap needs monotone keys, which Prim's edge-weight keys are not
+    PrimWorkload() {
+        backends.erase(std::remove(backends.begin(), backends.end(), PriorityQueueKind::Radix), backends.end());
+    }
+    void prepare(const WorkloadSpec& spec) override {
+        ShortestPathWorkload::prepare(spec);
+        // Reference weight from the plain binary heap; every backend must match it
+        vector<VertexId> referenceParent;
+        prim(graph, referenceParent, expectedWeight, PriorityQueueKind::LazyBinary);
+    }
+    void run(StepTrace* counters) override { ok = prim(graph, parent, weight, queue, counters, &stats); }
+    bool verify() const override { return ok && weight == expectedWeight; }
+
+private:
+    vector<VertexId> parent;
+    Distance weight = 0;
+    Distance expectedWeight = 0;
+    bool ok = false;
+};
+
+// Random graph with spec.n vertices; the variant picks the Floyd-Warshall loop
+// structure, checked against Dijkstra from a few sources. The two n x n
+// matrices cap n at MAX_VERTICES (128 MiB between them, and minutes per run).
+class FloydWarshallWorkload : public GraphWorkload {
+public:
+    void prepare(const WorkloadSpec& spec) override {
+        WorkloadSpec capped = spec;
+        capped.n = std::min(spec.n, MAX_VERTICES);
+        GraphWorkload::prepare(capped);
+        input = DistanceMatrix::fromGraph(graph);
+        options.variant = static_cast<FloydWarshallVariant>(spec.variant);
+        options.threads = spec.threads;
+    }
+    void reset() override { dist = input; }
+    void run(StepTrace* counters) override { ok = floydWarshall(dist, options, counters); }
+    size_t elementCount() const override { return input.size() * input.size(); }
+    bool usesThreads() const override { return true; }
+    size_t maxSize() const override { return MAX_VERTICES; }
+    std::vector<std::string> variants() const override { return FLOYD_WARSHALL_VARIANT_NAMES; }
+    bool verify() const override {
+        if (!ok) return false;
+        VertexId n = graph.vertexCount();
+        vector<Distance> expected;
+        vector<VertexId> parent;
+        for (VertexId source : {VertexId(0), n / 2, n > 0 ? n - 1 : 0}) {
+            if (source >= n) continue;
+            dijkstra(graph, source, expected, parent);
+            for (VertexId v = 0; v < n; ++v) {
+                Distance got = dist.at(source, v) == DistanceMatrix::INF ? INF_DISTANCE : dist.at(source, v);
+                if (got != expected[v]) return false;
+            }
+        }
+        return true;
+    }
+
+private:
+    static constexpr size_t MAX_VERTICES = 4096;
+    FloydWarshallOptions options;
+    DistanceMatrix input;
+    DistanceMatrix dist;
+    bool ok = false;
+};
+
+class KruskalWorkload : public GraphWorkload {
+public:
+    void prepare(const WorkloadSpec& spec) override {
+        GraphWorkload::prepare(spec);
+        options.variant = static_cast<KruskalVariant>(spec.variant);
+        options.threads = spec.threads;
+        // Prim gives the reference weight, the concurrent union-find the expected edge count
+        vector<VertexId> parent;
+        prim(graph, parent, expectedWeight);
+        expectedEdges = graph.vertexCount() - connectedComponentCount(graph, spec.threads);
+    }
+    void run(StepTrace* counters) override { ok = kruskal(graph, forest, weight, options, counters); }
+    bool usesThreads() const override { return true; }
+    std::vector<std::string> variants() const override { return KRUSKAL_VARIANT_NAMES; }
+    bool verify() const override { return ok && weight == expectedWeight && forest.size() == expectedEdges; }
+
+private:
+    KruskalOptions options;
+    vector<Edge> forest;
+    Distance weight = 0;
+    Distance expectedWeight = 0;
+    size_t expectedEdges = 0;
+    bool ok = false;
+};
+
+class DfsWorkload : public GraphWorkload {
+public:
+    void run(StepTrace* counters) override { order = depthFirstSearch(graph, 0, counters); }
+    bool verify() const override {
+        vector<char> seen(graph.vertexCount(), 0);
+        for (VertexId v : order) {
+            if (seen[v]) return false;
+            seen[v] = 1;
+        }
+        return graph.vertexCount() == 0 || (!order.empty() && order.front() == 0);
+    }
+
+private:
+    vector<VertexId> order;
+};
+
+class BellmanFordWorkload : public GraphWorkload {
+public:
+    void run(StepTrace* counters) override { ok = bellmanFord(graph, 0, dist, counters); }
+    bool verify() const override {
+        if (!ok) return false; // Generated weights are positive, so no negative cycle exists
+        for (VertexId u = 0; u < graph.vertexCount(); ++u) {
+            if (dist[u] == INF_DISTANCE) continue;
+            Graph::NeighborRange range = graph.neighbors(u);
+            for (size_t i = 0; i < range.size(); ++i) {
+                if (dist[u] + range.weight(i) < dist[range.target(i)]) return false;
+            }
+        }
+        return true;
+    }
+
+protected:
+    bool directed() const override { return true; }
+
+private:
+    vector<Distance> dist;
+    bool ok = false;
+};
+
+template<typename W>
+std::unique_ptr<Workload> makeStructureWorkload() { return std::make_unique<W>(); }
+
+template<typename W, DataStructure Kind>
+std::unique_ptr<Workload> makeStructureWorkload() { return std::make_unique<W>(Kind); }
+
+// Workloads that measure a data structure's own operations rather than an
+// algorithm, so they get rows of their own instead of riding on an algorithm's variants
+const std::map<DataStructure, std::unique_ptr<Workload> (*)()> STRUCTURE_WORKLOADS = {
+    {DataStructure::HashTable, makeStructureWorkload<HashTableWorkload>},
+    {DataStructure::Trie, makeStructureWorkload<TrieWorkload>},
+    {DataStructure::Deque, makeStructureWorkload<QueueWorkload, DataStructure::Deque>},
+    {DataStructure::Queue, makeStructureWorkload<QueueWorkload, DataStructure::Queue>},
+    {DataStructure::AVLTree, makeStructureWorkload<TreeWorkload, DataStructure::AVLTree>},
+    {DataStructure::BinarySearchTree, makeStructureWorkload<TreeWorkload, DataStructure::BinarySearchTree>},
+    {DataStructure::FenwickTree, makeStructureWorkload<RangeQueryWorkload, DataStructure::FenwickTree>},
+    {DataStructure::RedBlackTree, makeStructureWorkload<TreeWorkload, DataStructure::RedBlackTree>},
+    {DataStructure::SegmentTree, makeStructureWorkload<RangeQueryWorkload, DataStructure::SegmentTree>},
+};
+
+} // namespace
+
+std::unique_ptr<Workload> makeWorkload(DataStructure ds) {
+    auto it = STRUCTURE_WORKLOADS.find(ds);
+    return it != STRUCTURE_WORKLOADS.end() ? it->second() : nullptr;
+}
+
+vector<DataStructure> benchmarkedStructures() {
+    vector<DataStructure> structures;
+    for (const auto& entry : STRUCTURE_WORKLOADS) structures.push_back(entry.first);
+    return structures;
+}
+
+std::unique_ptr<Workload> makeWorkload(Algorithm alg) {
+    if (alg == Algorithm::RadixSort) return std::make_unique<RadixSortWorkload>();
+    if (isSortingAlgorithm(alg)) return std::make_unique<SortWorkload>(alg);
+    if (alg == Algorithm::LinearSearch) return std::make_unique<LinearSearchWorkload>();
+    if (isSearchAlgorithm(alg)) return std::make_unique<SearchWorkload>(alg);
+    if (isTraversalAlgorithm(alg)) return std::make_unique<TraversalWorkload>(alg);
+    switch (alg) {
+        case Algorithm::BFS: return std::make_unique<BfsWorkload>();
+        case Algorithm::DFS: return std::make_unique<DfsWorkload>();
+        case Algorithm::FloydWarshall: return std::make_unique<FloydWarshallWorkload>();
+        case Algorithm::Dijkstra: return std::make_unique<DijkstraWorkload>();
+        case Algorithm::Kruskal: return std::make_unique<KruskalWorkload>();
+        case Algorithm::Prim: return std::make_unique<PrimWorkload>();
+        case Algorithm::BellmanFord: return std::make_unique<BellmanFordWorkload>();
+        case Algorithm::HuffmanEncoding: return std::make_unique<HuffmanWorkload>();
+        default: return nullptr;
+    }
+}
@@ -0,0 +1,62 @@
+// algorithms/workloads.h
+#pragma once
+#include "../utilities/types.h"
+#include "../utilities/step_trace.h"
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+// Headless, repeatable runs of the real algorithm implementations. Input is
+// generated once in prepare(), reset() restores it between repetitions, and
+// only run() is meant to be timed. Shared by the empirical complexity mode
+// and the benchmark executable.
+
+enum class InputDistribution { Random, Sorted, Reversed, FewUnique };
+
+inline const std::vector<std::string> INPUT_DISTRIBUTION_NAMES = {
+    "random", "sorted", "reversed", "few-unique"
+};
+
+struct WorkloadSpec {
+    std::size_t n = 0;              // Elements, or vertices for graph workloads
+    InputDistribution distribution = InputDistribution::Random;
+    double averageDegree = 8.0;     // Graph workloads only: edges per vertex
+    unsigned threads = 0;           // Parallel workloads only: 0 = all hardware threads, 1 = sequential
+    std::size_t variant = 0;        // Index into Workload::variants()
+    std::uint32_t seed = 1;
+};
+
+std::vector<int> generateInput(std::size_t n, InputDistribution dist, std::uint32_t seed);
+
+class Workload {
+public:
+    virtual ~Workload() = default;
+    virtual void prepare(const WorkloadSpec& spec) = 0;
+    virtual void reset() = 0;
+    virtual void run(StepTrace* counters) = 0;
+    // Input elements touched by one run (for ns/element and throughput)
+    virtual std::size_t elementCount() const = 0;
+    // Sanity check of the last run's output, so benchmarks catch broken fast paths
+    virtual bool verify() const { return true; }
+    // Which WorkloadSpec fields the workload actually reads
+    virtual bool usesDistribution() const { return true; }
+    virtual bool usesDegree() const { return false; }
+    virtual bool usesThreads() const { return false; }
+    // Largest spec.n the workload will prepare; bigger sizes are clamped to it
+    virtual std::size_t maxSize() const { return SIZE_MAX; }
+    // Interchangeable implementations of the same algorithm (e.g. queue backends);
+    // empty when there is only one
+    virtual std::vector<std::string> variants() const { return {}; }
+    // Algorithm-specific counters from the last run, as "name=value;..." (may be empty)
+    virtual std::string counterSummary() const { return ""; }
+};
+
+// nullptr when the algorithm has no headless workload yet
+std::unique_ptr<Workload> makeWorkload(Algorithm alg);
+// Operations on a data structure itself (e.g. hash table inserts and lookups);
+// nullptr when the structure has no workload of its own
+std::unique_ptr<Workload> makeWorkload(DataStructure ds);
+// The structures makeWorkload(DataStructure) knows, in enum order
+std::vector<DataStructure> benchmarkedStructures();
@@ -0,0 +1,328 @@
+// benchmarks/algorithm_benchmark.cpp
+// Headless benchmark over every Algorithm entry and every data structure with a
+// workload of its own. Links no SFML so it can run in CI.
+//
+//   ./algorithm_benchmark [--sizes 1000,100000] [--dists random,sorted,reversed,few-unique]
+//                         [--degrees 4,32] [--threads 1,0] [--reps 5] [--warmup 1] [--budget-ms 2000]
+//                         [--algorithms "Merge Sort,BFS"] [--structures "Hash Table"]
+//                         [--variants pairing,radix] [--format csv|json]
+//
+// Naming only --algorithms or only --structures runs just those; naming neither runs everything.
+// Exit status is non-zero when any run fails its output check.
+#include "../algorithms/workloads.h"
+#include "../utilities/alloc_tracker.h"
+#include "../utilities/types.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <iostream>
+#include <limits>
+#include <new>
+#include <sstream>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+using std::string;
+using std::vector;
+using std::size_t;
+using std::cout;
+using std::cerr;
+using std::endl;
+
+struct BenchmarkOptions {
+    vector<size_t> sizes = {1000, 10000, 100000};
+    vector<InputDistribution> distributions = {InputDistribution::Random, InputDistribution::Sorted,
+                                               InputDistribution::Reversed, InputDistribution::FewUnique};
+    vector<double> degrees = {4.0, 32.0};
+    vector<unsigned> threads = {0}; // 0 = all hardware threads, 1 = sequential reference
+    vector<Algorithm> algorithms; // Empty (with structures empty too) = all
+    vector<DataStructure> structures;
+    vector<string> variants;      // Empty = every variant a workload offers
+    int repetitions = 5;
+    int warmup = 1;
+    double budgetMs = 2000.0; // Larger sizes are skipped once one run exceeds this
+    bool json = false;
+};
+
+struct BenchmarkRow {
+    string benchmark; // Algorithm or data structure name
+    string variant;
+    string distribution;
+    double degree = 0.0;
+    unsigned threads = 0;
+    size_t n = 0;
+    bool supported = false;
+    bool ok = true;
+    size_t elements = 0;
+    double medianNs = 0.0;
+    double nsPerElement = 0.0;
+    double elementsPerSec = 0.0;
+    uint64_t comparisons = 0;
+    uint64_t swaps = 0;
+    uint64_t allocations = 0;
+    uint64_t allocatedBytes = 0;
+    int64_t peakBytes = 0;
+    string counters; // Workload-specific "name=value;..." pairs
+};
+
+static vector<string> splitList(const string& s) {
+    vector<string> parts;
+    std::stringstream ss(s);
+    string item;
+    while (std::getline(ss, item, ',')) {
+        if (!item.empty()) parts.push_back(item);
+    }
+    return parts;
+}
+
+// The whole of s as a number; false for anything else, including a sign on an unsigned
+template <typename T>
+static bool parseNumber(const string& s, T& out) {
+    if (s.empty() || (std::is_unsigned<T>::value && s[0] == '-')) return false;
+    try {
+        size_t used = 0;
+        if constexpr (std::is_floating_point<T>::value) {
+            out = static_cast<T>(std::stod(s, &used));
+        } else if constexpr (std::is_unsigned<T>::value) {
+            unsigned long long v = std::stoull(s, &used);
+            if (v > std::numeric_limits<T>::max()) return false;
+            out = static_cast<T>(v);
+        } else {
+            long long v = std::stoll(s, &used);
+            if (v < std::numeric_limits<T>::min() || v > std::numeric_limits<T>::max()) return false;
+            out = static_cast<T>(v);
+        }
+        return used == s.size();
+    } catch (const std::exception&) { // invalid_argument or out_of_range
+        return false;
+    }
+}
+
+static bool parseArgs(int argc, char** argv, BenchmarkOptions& opts) {
+    for (int i = 1; i < argc; ++i) {
+        string arg = argv[i];
+        auto next = [&]() -> string { return (i + 1 < argc) ? argv[++i] : ""; };
+        auto invalid = [&](const string& v) {
+            cerr << "Invalid number for " << arg << ": " << (v.empty() ? "(missing)" : v) << endl;
+            return false;
+        };
+        if (arg == "--sizes") {
+            opts.sizes.clear();
+            for (const string& v : splitList(next())) {
+                size_t n = 0;
+                if (!parseNumber(v, n)) return invalid(v);
+                opts.sizes.push_back(n);
+            }
+        } else if (arg == "--dists") {
+            opts.distributions.clear();
+            for (const string& v : splitList(next())) {
+                auto it = std::find(INPUT_DISTRIBUTION_NAMES.begin(), INPUT_DISTRIBUTION_NAMES.end(), v);
+                if (it == INPUT_DISTRIBUTION_NAMES.end()) { cerr << "Unknown distribution: " << v << endl; return false; }
+                opts.distributions.push_back(static_cast<InputDistribution>(it - INPUT_DISTRIBUTION_NAMES.begin()));
+            }
+        } else if (arg == "--degrees") {
+            opts.degrees.clear();
+            for (const string& v : splitList(next())) {
+                double degree = 0.0;
+                if (!parseNumber(v, degree)) return invalid(v);
+                opts.degrees.push_back(degree);
+            }
+        } else if (arg == "--threads") {
+            opts.threads.clear();
+            for (const string& v : splitList(next())) {
+                unsigned threads = 0;
+                if (!parseNumber(v, threads)) return invalid(v);
+                opts.threads.push_back(threads);
+            }
+        } else if (arg == "--algorithms") {
+            for (const string& v : splitList(next())) {
+                auto it = std::find(ALGORITHM_NAMES.begin(), ALGORITHM_NAMES.end(), v);
+                if (it == ALGORITHM_NAMES.end()) { cerr << "Unknown algorithm: " << v << endl; return false; }
+                opts.algorithms.push_back(static_cast<Algorithm>(it - ALGORITHM_NAMES.begin()));
+            }
+        } else if (arg == "--structures") {
+            for (const string& v : splitList(next())) {
+                auto it = std::find(DATA_STRUCTURE_NAMES.begin(), DATA_STRUCTURE_NAMES.end(), v);
+                if (it == DATA_STRUCTURE_NAMES.end()) { cerr << "Unknown structure: " << v << endl; return false; }
+                opts.structures.push_back(static_cast<DataStructure>(it - DATA_STRUCTURE_NAMES.begin()));
+            }
+        } else if (arg == "--variants") {
+            opts.variants = splitList(next());
+        } else if (arg == "--reps") {
+            string v = next();
+            if (!parseNumber(v, opts.repetitions)) return invalid(v);
+            opts.repetitions = std::max(1, opts.repetitions);
+        } else if (arg == "--warmup") {
+            string v = next();
+            if (!parseNumber(v, opts.warmup)) return invalid(v);
+            opts.warmup = std::max(0, opts.warmup);
+        } else if (arg == "--budget-ms") {
+            string v = next();
+            if (!parseNumber(v, opts.budgetMs)) return invalid(v);
+        } else if (arg == "--format") {
+            string v = next();
+            if (v != "csv" && v != "json") { cerr << "Unknown format: " << v << endl; return false; }
+            opts.json = v == "json";
+        } else {
+            cerr << "Unknown argument: " << arg << endl;
+            return false;
+        }
+    }
+    if (opts.algorithms.empty() && opts.structures.empty()) {
+        for (size_t i = 1; i < ALGORITHM_NAMES.size(); ++i) opts.algorithms.push_back(static_cast<Algorithm>(i));
+        opts.structures = benchmarkedStructures();
+    }
+    return true;
+}
+
+static BenchmarkRow measure(Workload& workload, const WorkloadSpec& spec, const BenchmarkOptions& opts) {
+    using Clock = std::chrono::steady_clock;
+    BenchmarkRow row;
+    row.supported = true;
+    workload.prepare(spec);
+    for (int i = 0; i < opts.warmup; ++i) {
+        workload.reset();
+        workload.run(nullptr);
+    }
+
+    vector<double> times;
+    for (int i = 0; i < opts.repetitions; ++i) {
+        workload.reset();
+        Clock::time_point start = Clock::now();
+        workload.run(nullptr);
+        times.push_back(std::chrono::duration<double, std::nano>(Clock::now() - start).count());
+        row.ok = row.ok && workload.verify();
+        if (times.back() > opts.budgetMs * 1e6) break; // One slow sample is enough
+    }
+    std::sort(times.begin(), times.end());
+    row.medianNs = times[times.size() / 2];
+
+    // Counters and allocations from one extra, untimed run
+    StepTrace counters(false);
+    workload.reset();
+    {
+        AllocationScope scope;
+        workload.run(&counters);
+        AllocationStats heap = scope.stats();
+        row.allocations = heap.allocations;
+        row.allocatedBytes = heap.bytesAllocated;
+        row.peakBytes = heap.peakBytes;
+    }
+    row.ok = row.ok && workload.verify();
+    row.comparisons = counters.getComparisons();
+    row.swaps = counters.getSwaps();
+    row.counters = workload.counterSummary();
+
+    row.elements = workload.elementCount();
+    if (row.elements > 0) row.nsPerElement = row.medianNs / static_cast<double>(row.elements);
+    if (row.medianNs > 0) row.elementsPerSec = static_cast<double>(row.elements) * 1e9 / row.medianNs;
+    return row;
+}
+
+static void printCsvHeader() {
+    cout << "benchmark,variant,distribution,degree,threads,n,supported,ok,elements,median_ns,ns_per_element,elements_per_sec,"
+            "comparisons,swaps,allocations,allocated_bytes,peak_bytes,counters\n";
+}
+
+static void printCsv(const BenchmarkRow& r) {
+    cout << '"' << r.benchmark << "\",\"" << r.variant << "\"," << r.distribution << ',' << r.degree << ',' << r.threads << ',' << r.n << ','
+         << (r.supported ? 1 : 0) << ',' << (r.ok ? 1 : 0) << ',' << r.elements << ','
+         << r.medianNs << ',' << r.nsPerElement << ',' << r.elementsPerSec << ','
+         << r.comparisons << ',' << r.swaps << ',' << r.allocations << ',' << r.allocatedBytes << ','
+         << r.peakBytes << ",\"" << r.counters << "\"\n";
+}
+
+static void printJson(const BenchmarkRow& r, bool first) {
+    cout << (first ? "  " : ",\n  ")
+         << "{\"benchmark\": \"" << r.benchmark << "\", \"variant\": \"" << r.variant
+         << "\", \"distribution\": \"" << r.distribution
+         << "\", \"degree\": " << r.degree << ", \"threads\": " << r.threads << ", \"n\": " << r.n
+         << ", \"supported\": " << (r.supported ? "true" : "false") << ", \"ok\": " << (r.ok ? "true" : "false")
+         << ", \"elements\": " << r.elements << ", \"median_ns\": " << r.medianNs
+         << ", \"ns_per_element\": " << r.nsPerElement << ", \"elements_per_sec\": " << r.elementsPerSec
+         << ", \"comparisons\": " << r.comparisons << ", \"swaps\": " << r.swaps
+         << ", \"allocations\": " << r.allocations << ", \"allocated_bytes\": " << r.allocatedBytes
+         << ", \"peak_bytes\": " << r.peakBytes << ", \"counters\": \"" << r.counters << "\"}";
+}
+
+int main(int argc, char** argv) {
+    BenchmarkOptions opts;
+    if (!parseArgs(argc, argv, opts)) return 2;
+
+    bool allOk = true;
+    bool firstRow = true;
+    auto emit = [&](const BenchmarkRow& row) {
+        allOk = allOk && row.ok;
+        if (opts.json) printJson(row, firstRow);
+        else printCsv(row);
+        firstRow = false;
+        cout.flush();
+    };
+
+    if (opts.json) cout << "[\n";
+    else printCsvHeader();
+
+    // Every variant, distribution, degree, thread count and size the workload reads
+    auto runAll = [&](const string& name, std::unique_ptr<Workload> workload) {
+        if (!workload) {
+            BenchmarkRow row;
+            row.benchmark = name;
+            row.distribution = "n/a";
+            emit(row);
+            return;
+        }
+        // Distributions only matter to value workloads, degrees only to graph workloads,
+        // thread counts only to parallel workloads
+        vector<InputDistribution> dists = workload->usesDistribution() ? opts.distributions
+                                                                       : vector<InputDistribution>{InputDistribution::Random};
+        vector<double> degrees = workload->usesDegree() ? opts.degrees : vector<double>{0.0};
+        vector<unsigned> threadCounts = workload->usesThreads() ? opts.threads : vector<unsigned>{1};
+        vector<string> variantNames = workload->variants();
+        if (variantNames.empty()) variantNames.push_back("");
+        for (size_t variant = 0; variant < variantNames.size(); ++variant) {
+            if (!variantNames[variant].empty() && !opts.variants.empty() &&
+                std::find(opts.variants.begin(), opts.variants.end(), variantNames[variant]) == opts.variants.end()) {
+                continue;
+            }
+            for (InputDistribution dist : dists) {
+                for (double degree : degrees) {
+                    for (unsigned threads : threadCounts) {
+                        for (size_t requested : opts.sizes) {
+                            size_t n = std::min(requested, workload->maxSize()); // Reported as run
+                            WorkloadSpec spec;
+                            spec.n = n;
+                            spec.distribution = dist;
+                            spec.averageDegree = degree;
+                            spec.threads = threads;
+                            spec.variant = variant;
+                            spec.seed = static_cast<uint32_t>(n * 31 + static_cast<size_t>(dist));
+                            BenchmarkRow row;
+                            try {
+                                row = measure(*workload, spec, opts);
+                            } catch (const std::bad_alloc&) { // Reported as unsupported; smaller sizes may still run
+                                row = BenchmarkRow();
+                                row.counters = "out_of_memory";
+                            }
+                            row.benchmark = name;
+                            row.variant = variantNames[variant];
+                            row.distribution = workload->usesDistribution() ? INPUT_DISTRIBUTION_NAMES[static_cast<int>(dist)] : "n/a";
+                            row.degree = degree;
+                            row.threads = threads;
+                            row.n = n;
+                            emit(row);
+                            if (row.medianNs > opts.budgetMs * 1e6) break; // Bigger n would only be slower
+                            if (n < requested) break;                      // Or the same row again
+                        }
+                    }
+                }
+            }
+        }
+    };
+    for (Algorithm alg : opts.algorithms) runAll(ALGORITHM_NAMES[static_cast<int>(alg)], makeWorkload(alg));
+    for (DataStructure ds : opts.structures) runAll(DATA_STRUCTURE_NAMES[static_cast<int>(ds)], makeWorkload(ds));
+
+    if (opts.json) cout << "\n]\n";
+    return allOk ? 0 : 1;
+}
@@ -0,0 +1,150 @@
+// data_structures/graphs/graph.cpp
+#include "graph.h"
+#include <algorithm>
+#include <random>
+
+using std::vector;
+using std::size_t;
+
+std::vector<Edge> Graph::edgeList() const {
+    vector<Edge> edges;
+    edges.reserve(directed ? arcCount() : arcCount() / 2);
+    for (VertexId u = 0; u < vertexCount(); ++u) {
+        NeighborRange range = neighbors(u);
+        for (size_t i = 0; i < range.size(); ++i) {
+            VertexId v = range.target(i);
+            if (directed || u < v) edges.push_back({u, v, range.weight(i)});
+        }
+    }
+    return edges;
+}
+
+Graph Graph::reversed() const {
+    if (!directed) return *this;
+    GraphBuilder builder(vertexCount(), true);
+    builder.reserveEdges(arcCount());
+    for (VertexId u = 0; u < vertexCount(); ++u) {
+        NeighborRange range = neighbors(u);
+        for (size_t i = 0; i < range.size(); ++i) builder.addEdge(range.target(i), u, range.weight(i));
+    }
+    return builder.freeze();
+}
+
+GraphBuilder::GraphBuilder(VertexId vertexCount, bool isDirected)
+    : vertices(vertexCount), directed(isDirected) {}
+
+VertexId GraphBuilder::addVertex() {
+    return vertices++;
+}
+
+void GraphBuilder::addEdge(VertexId from, VertexId to, Weight weight) {
+    if (from >= vertices || to >= vertices) return; // Ignore arcs to unknown vertices
+    pending.push_back({from, to, weight});
+}
+
+Graph GraphBuilder::freeze() const {
+    // Expand undirected edges into both arcs
+    vector<Edge> arcs;
+    arcs.reserve(directed ? pending.size() : pending.size() * 2);
+    for (const Edge& e : pending) {
+        arcs.push_back(e);
+        if (!directed && e.from != e.to) arcs.push_back({e.to, e.from, e.weight});
+    }
+
+    // Stable counting sort by target, then by source => ordered by (source, target)
+    vector<Edge> byTarget(arcs.size());
+    vector<size_t> counts(static_cast<size_t>(vertices) + 1, 0);
+    for (const Edge& e : arcs) ++counts[e.to + 1];
+    for (size_t v = 0; v < vertices; ++v) counts[v + 1] += counts[v];
+    for (const Edge& e : arcs) byTarget[counts[e.to]++] = e;
+
+    Graph g;
+    g.directed = directed;
+    g.offsetArray.assign(static_cast<size_t>(vertices) + 1, 0);
+    for (const Edge& e : byTarget) ++g.offsetArray[e.from + 1];
+    for (size_t v = 0; v < vertices; ++v) g.offsetArray[v + 1] += g.offsetArray[v];
+
+    g.targetArray.resize(byTarget.size());
+    g.weightArray.resize(byTarget.size());
+    vector<std::uint64_t> cursor(g.offsetArray.begin(), g.offsetArray.end() - 1);
+    for (const Edge& e : byTarget) {
+        std::uint64_t slot = cursor[e.from]++;
+        g.targetArray[slot] = e.to;
+        g.weightArray[slot] = e.weight;
+    }
+    return g;
+}
+
+Graph generateRandomGraph(VertexId n, double averageDegree, std::uint32_t seed, bool directed, Weight maxWeight) {
+    GraphBuilder builder(n, directed);
+    if (n < 2) return builder.freeze();
+    size_t edgeCount = static_cast<size_t>(static_cast<double>(n) * averageDegree / (directed ? 1.0 : 2.0));
+    builder.reserveEdges(edgeCount);
+
+    std::mt19937 rng(seed);
+    std::uniform_int_distribution<VertexId> pickVertex(0, n - 1);
+    std::uniform_int_distribution<Weight> pickWeight(1, maxWeight < 1 ? 1 : maxWeight);
+    for (size_t i = 0; i < edgeCount; ++i) {
+        VertexId u = pickVertex(rng), v = pickVertex(rng);
+        if (u == v) v = (v + 1) % n; // No self-loops
+        builder.addEdge(u, v, pickWeight(rng));
+    }
+    return builder.freeze();
+}
+
+Graph generateRMatGraph(VertexId n, double averageDegree, std::uint32_t seed, bool directed, Weight maxWeight) {
+    GraphBuilder builder(n, directed);
+    if (n < 2) return builder.freeze();
+    size_t edgeCount = static_cast<size_t>(static_cast<double>(n) * averageDegree / (directed ? 1.0 : 2.0));
+    builder.reserveEdges(edgeCount);
+
+    int scale = 0;
+    while ((std::uint64_t(1) << scale) < n) ++scale;
+    // Standard Graph500 quadrant probabilities a, b, c (d = 1 - a - b - c)
+    const double A = 0.57, B = 0.19, C = 0.19;
+    std::mt19937 rng(seed);
+    std::uniform_real_distribution<double> unit(0.0, 1.0);
+    std::uniform_int_distribution<Weight> pickWeight(1, maxWeight < 1 ? 1 : maxWeight);
+    // Random relabelling so the hubs are not all clustered at low ids
+    vector<VertexId> label(n);
+    for (VertexId v = 0; v < n; ++v) label[v] = v;
+    std::shuffle(label.begin(), label.end(), rng);
+
+    for (size_t i = 0; i < edgeCount;) {
+        std::uint64_t u = 0, v = 0;
+        for (int bit = 0; bit < scale; ++bit) {
+            double r = unit(rng);
+            u <<= 1;
+            v <<= 1;
+            if (r < A) {
+            } else if (r < A + B) {
+                v |= 1;
+            } else if (r < A + B + C) {
+                u |= 1;
+            } else {
+                u |= 1;
+                v |= 1;
+            }
+        }
+        if (u >= n || v >= n || u == v) continue; // Outside the padded square, or a self-loop
+        builder.addEdge(label[u], label[v], pickWeight(rng));
+        ++i;
+    }
+    return builder.freeze();
+}
+
+Graph generateGridGraph(VertexId rows, VertexId columns, std::uint32_t seed, double keepProbability, Weight maxWeight) {
+    GraphBuilder builder(rows * columns, false);
+    builder.reserveEdges(static_cast<size_t>(rows) * columns * 2);
+    std::mt19937 rng(seed);
+    std::bernoulli_distribution keep(keepProbability);
+    std::uniform_int_distribution<Weight> pickWeight(1, maxWeight < 1 ? 1 : maxWeight);
+    for (VertexId r = 0; r < rows; ++r) {
+        for (VertexId c = 0; c < columns; ++c) {
+            VertexId u = r * columns + c;
+            if (c + 1 < columns && keep(rng)) builder.addEdge(u, u + 1, pickWeight(rng));
+            if (r + 1 < rows && keep(rng)) builder.addEdge(u, u + columns, pickWeight(rng));
+        }
+    }
+    return builder.freeze();
+}
@@ -0,0 +1,104 @@
+// data_structures/graphs/graph.h
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+// Graphs are built with a mutable GraphBuilder and then frozen into an
+// immutable compressed-sparse-row (CSR) Graph: the out-arcs of vertex u are
+// the slice [offsets[u], offsets[u+1]) of the contiguous target/weight arrays,
+// so traversals stream through memory instead of chasing list nodes.
+
+using VertexId = std::uint32_t;
+using Weight = std::int32_t;
+using Distance = std::int64_t;
+
+constexpr VertexId NO_VERTEX = std::numeric_limits<VertexId>::max();
+constexpr Distance INF_DISTANCE = std::numeric_limits<Distance>::max();
+
+struct Edge {
+    VertexId from;
+    VertexId to;
+    Weight weight;
+};
+
+class Graph {
+public:
+    // Out-arcs of one vertex, iterable as targets with a parallel weight array
+    struct NeighborRange {
+        const VertexId* first;
+        const VertexId* last;
+        const Weight* weightsBegin;
+        const VertexId* begin() const { return first; }
+        const VertexId* end() const { return last; }
+        std::size_t size() const { return static_cast<std::size_t>(last - first); }
+        VertexId target(std::size_t i) const { return first[i]; }
+        Weight weight(std::size_t i) const { return weightsBegin[i]; }
+    };
+
+    Graph() = default;
+
+    VertexId vertexCount() const { return static_cast<VertexId>(offsetArray.empty() ? 0 : offsetArray.size() - 1); }
+    // Stored arcs; an undirected edge is stored once in each direction
+    std::size_t arcCount() const { return targetArray.size(); }
+    bool isDirected() const { return directed; }
+
+    NeighborRange neighbors(VertexId u) const {
+        std::uint64_t b = offsetArray[u], e = offsetArray[u + 1];
+        return {targetArray.data() + b, targetArray.data() + e, weightArray.data() + b};
+    }
+    std::size_t degree(VertexId u) const { return static_cast<std::size_t>(offsetArray[u + 1] - offsetArray[u]); }
+
+    const std::vector<std::uint64_t>& offsets() const { return offsetArray; }
+    const std::vector<VertexId>& targets() const { return targetArray; }
+    const std::vector<Weight>& weights() const { return weightArray; }
+
+    // Every edge once (undirected edges only as from < to), e.g. for Kruskal
+    std::vector<Edge> edgeList() const;
+    // Same vertices with every arc reversed (the graph itself when undirected)
+    Graph reversed() const;
+
+private:
+    friend class GraphBuilder;
+    std::vector<std::uint64_t> offsetArray; // vertexCount + 1 entries
+    std::vector<VertexId> targetArray;
+    std::vector<Weight> weightArray;
+    bool directed = false;
+};
+
+class GraphBuilder {
+public:
+    explicit GraphBuilder(VertexId vertexCount = 0, bool directed = false);
+
+    VertexId addVertex();
+    void addEdge(VertexId from, VertexId to, Weight weight = 1);
+    void reserveEdges(std::size_t count) { pending.reserve(count); }
+
+    VertexId vertexCount() const { return vertices; }
+    std::size_t edgeCount() const { return pending.size(); }
+
+    // Two stable counting-sort passes (by target, then source) in O(V + E):
+    // adjacency slices come out sorted by target, which keeps scans local.
+    Graph freeze() const;
+
+private:
+    std::vector<Edge> pending;
+    VertexId vertices;
+    bool directed;
+};
+
+// Uniform random G(n, m) graph with m = n * averageDegree / 2 undirected edges
+// (n * averageDegree arcs when directed) and weights in [1, maxWeight].
+Graph generateRandomGraph(VertexId n, double averageDegree, std::uint32_t seed,
+                          bool directed = false, Weight maxWeight = 100);
+
+// R-MAT graph with a skewed, power-law-like degree distribution (a few hubs and
+// a long tail), the shape of social-network snapshots. Same edge count as above.
+Graph generateRMatGraph(VertexId n, double averageDegree, std::uint32_t seed,
+                        bool directed = false, Weight maxWeight = 100);
+
+// Road-network-like graph: vertex r * columns + c sits on a grid and links to its
+// right and lower neighbours, each kept with probability keepProbability.
+Graph generateGridGraph(VertexId rows, VertexId columns, std::uint32_t seed,
+                        double keepProbability = 0.8, Weight maxWeight = 100);
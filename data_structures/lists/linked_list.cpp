@@ -0,0 +1,386 @@
+// data_structures/lists/linked_list.cpp
+#include "linked_list.h"
+#include "../../utilities/step_trace.h"
+#include <algorithm>
+#include <utility>
+
+using std::size_t;
+
+namespace {
+
+constexpr unsigned CACHE_LINE_SHIFT = 6;
+// Bin i holds runs of 2^i base runs, so this many cover any list that fits in memory
+constexpr size_t SORT_BINS = 64;
+
+// The cache line one walk through the list was last on
+struct Walk {
+    std::uintptr_t line;
+    explicit Walk(const void* node) : line(reinterpret_cast<std::uintptr_t>(node) >> CACHE_LINE_SHIFT) {}
+};
+
+void step(Walk& walk, const void* node, ListSortStats* stats) {
+    if (!stats) return;
+    ++stats->nodeHops;
+    std::uintptr_t line = reinterpret_cast<std::uintptr_t>(node) >> CACHE_LINE_SHIFT;
+    if (line != walk.line) {
+        ++stats->linesEntered;
+        walk.line = line;
+    }
+}
+
+} // namespace
+
+LinkedList::LinkedList(size_t elementsPerNode)
+    : nodeElements(std::clamp<size_t>(elementsPerNode, 1, MAX_NODE_ELEMENTS)),
+      stride(nodeElements == 1 ? 2 : nodeElements + 2), valueOffset(nodeElements == 1 ? 1 : 2) {}
+
+LinkedList::LinkedList(LinkedList&& other) noexcept
+    : words(std::move(other.words)), nodeElements(other.nodeElements), stride(other.stride),
+      valueOffset(other.valueOffset), head(other.head), tail(other.tail), freeList(other.freeList),
+      count(other.count), liveNodes(other.liveNodes) {
+    other.clear();
+}
+
+LinkedList& LinkedList::operator=(LinkedList&& other) noexcept {
+    if (this != &other) {
+        words = std::move(other.words);
+        nodeElements = other.nodeElements;
+        stride = other.stride;
+        valueOffset = other.valueOffset;
+        head = other.head;
+        tail = other.tail;
+        freeList = other.freeList;
+        count = other.count;
+        liveNodes = other.liveNodes;
+        other.clear();
+    }
+    return *this;
+}
+
+void LinkedList::pushFront(int value) {
+    std::uint32_t filled = head == NO_NODE ? nodeElements : countOf(head);
+    if (filled == nodeElements) {
+        NodeRef n = allocateNode();
+        setLink(n, head);
+        head = n;
+        if (tail == NO_NODE) tail = n;
+        filled = 0;
+    }
+    int* values = &valueAt(head, 0);
+    std::copy_backward(values, values + filled, values + filled + 1);
+    values[0] = value;
+    setCount(head, filled + 1);
+    ++count;
+}
+
+void LinkedList::pushBack(int value) {
+    std::uint32_t filled = tail == NO_NODE ? nodeElements : countOf(tail);
+    if (filled == nodeElements) {
+        NodeRef n = allocateNode();
+        if (tail != NO_NODE) setLink(tail, n);
+        else head = n;
+        tail = n;
+        filled = 0;
+    }
+    valueAt(tail, filled) = value;
+    setCount(tail, filled + 1);
+    ++count;
+}
+
+void LinkedList::popFront() {
+    std::uint32_t filled = countOf(head);
+    if (filled == 1) {
+        NodeRef old = head;
+        head = linkOf(old);
+        if (head == NO_NODE) tail = NO_NODE;
+        releaseNode(old);
+    } else {
+        int* values = &valueAt(head, 0);
+        std::copy(values + 1, values + filled, values);
+        setCount(head, filled - 1);
+    }
+    --count;
+}
+
+void LinkedList::clear() {
+    words.clear();
+    head = tail = freeList = NO_NODE;
+    count = liveNodes = 0;
+}
+
+LinkedList::NodeRef LinkedList::allocateNode() {
+    NodeRef n;
+    if (freeList != NO_NODE) {
+        n = freeList;
+        freeList = linkOf(n);
+    } else {
+        n = static_cast<NodeRef>(words.size() / stride);
+        words.resize(words.size() + stride);
+    }
+    setLink(n, NO_NODE);
+    setCount(n, 0);
+    ++liveNodes;
+    return n;
+}
+
+void LinkedList::releaseNode(NodeRef n) {
+    setLink(n, freeList);
+    freeList = n;
+    --liveNodes;
+}
+
+void LinkedList::sort(StepTrace* trace, ListSortStats* stats) {
+    if (count < 2) return;
+    // Enough for any merge: by the time one needs a fresh output node, all but
+    // two of the nodes it has filled were matched by input nodes it emptied
+    NodeRef spares = NO_NODE;
+    if (nodeElements > 1) {
+        for (int k = 0; k < 2; ++k) {
+            NodeRef n = allocateNode();
+            setLink(n, spares);
+            spares = n;
+        }
+    }
+    auto merge = [&](const Run& a, const Run& b) {
+        if (trace) trace->highlight(a.start, b.start + b.length - 1);
+        Run merged = concatenated(a, b, trace, stats);
+        if (merged.head == NO_NODE) {
+            merged = nodeElements == 1 ? mergeNodes(a, b, trace, stats) : mergeUnrolled(a, b, spares, trace, stats);
+        }
+        if (trace && trace->isRecording()) traceWrites(merged, trace);
+        return merged;
+    };
+
+    Run bins[SORT_BINS];
+    size_t used = 0;
+    size_t position = 0;
+    NodeRef n = head;
+    Walk walk(nodeAt(n));
+    while (position < count) {
+        NodeRef next = linkOf(n); // Read before merging relinks n
+        Run carry{n, n, position, countOf(n)};
+        if (nodeElements > 1) sortNode(n, position, trace, stats);
+        position += carry.length;
+        size_t i = 0;
+        for (; i < used && bins[i].length > 0; ++i) {
+            carry = merge(bins[i], carry);
+            bins[i].length = 0;
+        }
+        if (i == used) ++used;
+        bins[i] = carry;
+        if (next != NO_NODE) step(walk, nodeAt(next), stats);
+        n = next;
+    }
+    // The lowest bin holds the end of the list; each higher one comes before it
+    Run sorted{NO_NODE, NO_NODE, 0, 0};
+    for (size_t i = 0; i < used; ++i) {
+        if (bins[i].length == 0) continue;
+        sorted = sorted.length == 0 ? bins[i] : merge(bins[i], sorted);
+    }
+    head = sorted.head;
+    tail = sorted.tail;
+    setLink(tail, NO_NODE);
+    while (spares != NO_NODE) {
+        NodeRef next = linkOf(spares);
+        releaseNode(spares);
+        spares = next;
+    }
+}
+
+// Runs that don't interleave at all just link up, one after the other, as
+// alreadyMerged does for arrays: in order (a sorted stretch) or the wrong way
+// round (a reversed one). Returns a run with no head when they do interleave.
+LinkedList::Run LinkedList::concatenated(const Run& a, const Run& b, StepTrace* trace, ListSortStats* stats) {
+    int lastA = valueAt(a.tail, countOf(a.tail) - 1);
+    int firstB = valueAt(b.head, 0);
+    if (trace) trace->compare(a.start + a.length - 1, b.start);
+    if (stats) ++stats->comparisons;
+    Run joined{NO_NODE, NO_NODE, a.start, a.length + b.length};
+    if (lastA <= firstB) {
+        joined.head = a.head;
+        joined.tail = b.tail;
+        if (linkOf(a.tail) != b.head) {
+            setLink(a.tail, b.head);
+            if (stats) ++stats->linkWrites;
+        }
+        return joined;
+    }
+    int firstA = valueAt(a.head, 0);
+    int lastB = valueAt(b.tail, countOf(b.tail) - 1);
+    if (trace) trace->compare(a.start, b.start + b.length - 1);
+    if (stats) ++stats->comparisons;
+    if (lastB < firstA) { // Strictly, so equal values keep their order
+        joined.head = b.head;
+        joined.tail = a.tail;
+        setLink(b.tail, a.head);
+        if (stats) ++stats->linkWrites;
+    }
+    return joined;
+}
+
+// One value per node: relink. Each side is taken for as long as it wins, and
+// the link of its last node is only rewritten when the other side takes over.
+LinkedList::Run LinkedList::mergeNodes(const Run& a, const Run& b, StepTrace* trace, ListSortStats* stats) {
+    NodeRef x = a.head, y = b.head;
+    size_t leftA = a.length, leftB = b.length;
+    int vx = valueAt(x, 0), vy = valueAt(y, 0);
+    Walk walkA(nodeAt(x)), walkB(nodeAt(y));
+    auto bFirst = [&] {
+        if (trace) trace->compare(a.start + a.length - leftA, b.start + b.length - leftB);
+        if (stats) ++stats->comparisons;
+        return vy < vx; // Stable: ties take the earlier run
+    };
+    auto link = [&](NodeRef from, NodeRef to) {
+        if (linkOf(from) == to) return; // Already in order, as when the runs were adjacent
+        setLink(from, to);
+        if (stats) ++stats->linkWrites;
+    };
+
+    Run merged{NO_NODE, NO_NODE, a.start, a.length + b.length};
+    bool fromB = bFirst();
+    merged.head = fromB ? y : x;
+    for (;;) {
+        NodeRef last;
+        if (!fromB) {
+            do {
+                last = x;
+                if (--leftA == 0) {
+                    link(last, y);
+                    merged.tail = b.tail;
+                    return merged;
+                }
+                x = linkOf(x);
+                vx = valueAt(x, 0);
+                step(walkA, nodeAt(x), stats);
+            } while (!bFirst());
+            link(last, y);
+        } else {
+            do {
+                last = y;
+                if (--leftB == 0) {
+                    link(last, x);
+                    merged.tail = a.tail;
+                    return merged;
+                }
+                y = linkOf(y);
+                vy = valueAt(y, 0);
+                step(walkB, nodeAt(y), stats);
+            } while (bFirst());
+            link(last, x);
+        }
+        fromB = !fromB;
+    }
+}
+
+// Several values per node: values are copied into nodes packed full, each one
+// taken from the spares. A node joins the spares once its last value has been
+// read, so the output never overwrites anything still to be merged. When one
+// side runs out, the rest of the other is linked on whole.
+LinkedList::Run LinkedList::mergeUnrolled(const Run& a, const Run& b, NodeRef& spares, StepTrace* trace,
+                                          ListSortStats* stats) {
+    struct Reader {
+        NodeRef node;
+        const int* at; // Next value of node to read
+        const int* stop;
+        size_t left;   // Values of the run not read yet
+        Walk walk;
+    };
+    auto reader = [&](const Run& run) {
+        const int* first = &valueAt(run.head, 0);
+        return Reader{run.head, first, first + countOf(run.head), run.length, Walk(nodeAt(run.head))};
+    };
+    Reader ra = reader(a), rb = reader(b);
+    auto take = [&](Reader& r) {
+        int v = *r.at;
+        --r.left;
+        if (++r.at == r.stop) {
+            NodeRef next = linkOf(r.node);
+            setLink(r.node, spares);
+            spares = r.node;
+            if (stats) ++stats->linkWrites;
+            if (r.left > 0) {
+                r.node = next;
+                r.at = &valueAt(next, 0);
+                r.stop = r.at + countOf(next);
+                step(r.walk, nodeAt(next), stats);
+            }
+        }
+        return v;
+    };
+
+    NodeRef out = spares;
+    spares = linkOf(out);
+    int* outAt = &valueAt(out, 0);
+    int* outStop = outAt + nodeElements;
+    Walk walkOut(nodeAt(out));
+    auto emit = [&](int v) {
+        if (outAt == outStop) {
+            setCount(out, static_cast<std::uint32_t>(nodeElements));
+            NodeRef fresh = spares;
+            spares = linkOf(fresh);
+            setLink(out, fresh);
+            out = fresh;
+            outAt = &valueAt(out, 0);
+            outStop = outAt + nodeElements;
+            if (stats) ++stats->linkWrites;
+            step(walkOut, nodeAt(out), stats);
+        }
+        *outAt++ = v;
+        if (stats) ++stats->elementMoves;
+    };
+
+    Run merged{out, NO_NODE, a.start, a.length + b.length};
+    while (ra.left > 0 && rb.left > 0) {
+        if (trace) trace->compare(a.start + a.length - ra.left, b.start + b.length - rb.left);
+        if (stats) ++stats->comparisons;
+        emit(*rb.at < *ra.at ? take(rb) : take(ra)); // Stable: ties take the earlier run
+    }
+    Reader& rest = ra.left > 0 ? ra : rb;
+    while (rest.left > 0 && rest.at != &valueAt(rest.node, 0)) emit(take(rest));
+    setCount(out, static_cast<std::uint32_t>(nodeElements - (outStop - outAt)));
+    if (rest.left > 0) {
+        setLink(out, rest.node);
+        if (stats) ++stats->linkWrites;
+        merged.tail = &rest == &ra ? a.tail : b.tail;
+    } else {
+        merged.tail = out;
+    }
+    return merged;
+}
+
+// Insertion sort of one node's values, traced like insertionSortRange
+void LinkedList::sortNode(NodeRef n, size_t start, StepTrace* trace, ListSortStats* stats) {
+    int* values = &valueAt(n, 0);
+    std::uint32_t filled = countOf(n);
+    for (std::uint32_t i = 1; i < filled; ++i) {
+        int key = values[i];
+        std::uint32_t j = i;
+        while (j > 0) {
+            if (trace) trace->compare(start + j - 1, start + i);
+            if (stats) ++stats->comparisons;
+            if (values[j - 1] <= key) break;
+            values[j] = values[j - 1];
+            if (trace) trace->write(start + j, values[j]);
+            if (stats) ++stats->elementMoves;
+            --j;
+        }
+        if (j != i) {
+            values[j] = key;
+            if (trace) trace->write(start + j, key);
+            if (stats) ++stats->elementMoves;
+        }
+    }
+}
+
+// The merged run written out over its list positions, as copyBack does for arrays
+void LinkedList::traceWrites(const Run& run, StepTrace* trace) const {
+    NodeRef n = run.head;
+    std::uint32_t slot = 0;
+    for (size_t k = 0; k < run.length; ++k) {
+        trace->write(run.start + k, valueAt(n, slot));
+        if (++slot == countOf(n)) {
+            n = linkOf(n);
+            slot = 0;
+        }
+    }
+}
@@ -0,0 +1,145 @@
+// data_structures/lists/linked_list.h
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <vector>
+
+class StepTrace;
+
+// Memory traffic of one LinkedList::sort. A contiguous merge sort streams its
+// input a cache line at a time; a list pays a dependent load for every node it
+// steps to, and once merging has scattered the order those steps land on a new
+// line nearly every time.
+struct ListSortStats {
+    std::uint64_t comparisons = 0;
+    std::uint64_t nodeHops = 0;     // Steps from a node to its successor
+    std::uint64_t linesEntered = 0; // Steps onto a 64-byte line other than the walk's previous one
+    std::uint64_t linkWrites = 0;
+    std::uint64_t elementMoves = 0; // Values copied between nodes (unrolled lists only)
+};
+
+// Singly linked list of ints with a tail pointer. Nodes live in the list's own
+// arena and link by 32-bit index, like the binary trees' NodePool: pushing
+// allocates nothing once the arena has grown, a list built front to back lies
+// in memory in list order, and copying the list copies the arena. Popped
+// nodes go on a free list and are reused.
+//
+// Unrolled (elementsPerNode > 1), a node holds up to that many values behind
+// its link and count, so a walk does one dependent load per node rather than
+// per value; UNROLLED_NODE_ELEMENTS makes a node 64 bytes.
+class LinkedList {
+public:
+    using NodeRef = std::uint32_t;
+    static constexpr NodeRef NO_NODE = 0xFFFFFFFFu;
+    static constexpr std::size_t UNROLLED_NODE_ELEMENTS = 14;
+    static constexpr std::size_t MAX_NODE_ELEMENTS = 256;
+
+    class ConstIterator {
+    public:
+        using iterator_category = std::forward_iterator_tag;
+        using value_type = int;
+        using difference_type = std::ptrdiff_t;
+        using pointer = const int*;
+        using reference = const int&;
+
+        ConstIterator() = default;
+        ConstIterator(const LinkedList* l, NodeRef n) : list(l), node(n) {}
+        reference operator*() const { return list->valueAt(node, slot); }
+        ConstIterator& operator++() {
+            if (++slot == list->countOf(node)) {
+                node = list->linkOf(node);
+                slot = 0;
+            }
+            return *this;
+        }
+        bool operator==(const ConstIterator& other) const { return node == other.node && slot == other.slot; }
+        bool operator!=(const ConstIterator& other) const { return !(*this == other); }
+
+    private:
+        const LinkedList* list = nullptr;
+        NodeRef node = NO_NODE;
+        std::uint32_t slot = 0;
+    };
+
+    // elementsPerNode is clamped to [1, MAX_NODE_ELEMENTS]
+    explicit LinkedList(std::size_t elementsPerNode = 1);
+    LinkedList(const LinkedList&) = default;
+    LinkedList& operator=(const LinkedList&) = default;
+    LinkedList(LinkedList&& other) noexcept;
+    LinkedList& operator=(LinkedList&& other) noexcept;
+
+    void pushFront(int value);
+    void pushBack(int value);
+    void popFront(); // Precondition: !empty()
+    int front() const { return valueAt(head, 0); }
+    int back() const { return valueAt(tail, countOf(tail) - 1); }
+
+    std::size_t size() const { return count; }
+    bool empty() const { return count == 0; }
+    // Drops every node; the arena keeps its capacity
+    void clear();
+
+    // Stable merge sort, bottom up and without recursion. Runs wait in bins of
+    // doubling length and each new run merges into the bins like a carry, so a
+    // merge works on runs that were touched moments ago rather than sweeping the
+    // whole list once per level. Merging relinks nodes and allocates nothing; a
+    // link is only written where the merged order switches from one run to the
+    // other. An unrolled list sorts each node in place first and merges by
+    // copying values into nodes the merge has already emptied (plus two spares
+    // from the free list), packing the nodes full as it goes.
+    //
+    // The trace sees list positions, as if the list were an array being merge
+    // sorted: comparisons while a merge runs, then the merged range written out.
+    void sort(StepTrace* trace = nullptr, ListSortStats* stats = nullptr);
+
+    std::size_t elementsPerNode() const { return nodeElements; }
+    std::size_t nodeCount() const { return liveNodes; }
+    std::size_t memoryBytes() const { return words.capacity() * sizeof(std::uint32_t); }
+
+    ConstIterator begin() const { return ConstIterator(empty() ? nullptr : this, head); }
+    ConstIterator end() const { return ConstIterator(); }
+
+private:
+    // A node is `stride` words: its link, then (unrolled only) its count, then its values
+    std::vector<std::uint32_t> words;
+    std::size_t nodeElements;
+    std::size_t stride;
+    std::size_t valueOffset;
+    NodeRef head = NO_NODE;
+    NodeRef tail = NO_NODE;
+    NodeRef freeList = NO_NODE;
+    std::size_t count = 0;
+    std::size_t liveNodes = 0;
+
+    // A sorted stretch of the list: length values from head to tail, starting at
+    // list position start. The tail's link is not part of the run.
+    struct Run {
+        NodeRef head;
+        NodeRef tail;
+        std::size_t start;
+        std::size_t length;
+    };
+
+    std::uint32_t* nodeAt(NodeRef n) { return &words[n * stride]; }
+    const std::uint32_t* nodeAt(NodeRef n) const { return &words[n * stride]; }
+    NodeRef linkOf(NodeRef n) const { return words[n * stride]; }
+    void setLink(NodeRef n, NodeRef next) { words[n * stride] = next; }
+    std::uint32_t countOf(NodeRef n) const { return nodeElements == 1 ? 1 : words[n * stride + 1]; }
+    void setCount(NodeRef n, std::uint32_t c) {
+        if (nodeElements != 1) words[n * stride + 1] = c;
+    }
+    int& valueAt(NodeRef n, std::size_t slot) { return reinterpret_cast<int&>(words[n * stride + valueOffset + slot]); }
+    const int& valueAt(NodeRef n, std::size_t slot) const {
+        return reinterpret_cast<const int&>(words[n * stride + valueOffset + slot]);
+    }
+
+    NodeRef allocateNode();
+    void releaseNode(NodeRef n);
+
+    Run concatenated(const Run& a, const Run& b, StepTrace* trace, ListSortStats* stats);
+    Run mergeNodes(const Run& a, const Run& b, StepTrace* trace, ListSortStats* stats);
+    Run mergeUnrolled(const Run& a, const Run& b, NodeRef& spares, StepTrace* trace, ListSortStats* stats);
+    void sortNode(NodeRef n, std::size_t start, StepTrace* trace, ListSortStats* stats);
+    void traceWrites(const Run& run, StepTrace* trace) const;
+};
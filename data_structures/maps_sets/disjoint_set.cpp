@@ -0,0 +1,65 @@
+// data_structures/maps_sets/disjoint_set.cpp
+#include "disjoint_set.h"
+#include <utility>
+
+using std::uint32_t;
+
+DisjointSet::DisjointSet(uint32_t n) {
+    reset(n);
+}
+
+void DisjointSet::reset(uint32_t n) {
+    if (n != elements || !parent) parent.reset(new std::atomic<uint32_t>[n]);
+    for (uint32_t i = 0; i < n; ++i) parent[i].store(i, std::memory_order_relaxed);
+    rank.assign(n, 0);
+    elements = n;
+    sets.store(n, std::memory_order_relaxed);
+}
+
+uint32_t DisjointSet::find(uint32_t x) {
+    // Path halving: point every other node on the path at its grandparent
+    for (;;) {
+        uint32_t p = parent[x].load(std::memory_order_relaxed);
+        if (p == x) return x;
+        uint32_t gp = parent[p].load(std::memory_order_relaxed);
+        parent[x].store(gp, std::memory_order_relaxed);
+        x = gp;
+    }
+}
+
+bool DisjointSet::unite(uint32_t a, uint32_t b) {
+    a = find(a);
+    b = find(b);
+    if (a == b) return false;
+    if (rank[a] < rank[b]) std::swap(a, b);
+    parent[b].store(a, std::memory_order_relaxed);
+    if (rank[a] == rank[b]) ++rank[a];
+    sets.fetch_sub(1, std::memory_order_relaxed);
+    return true;
+}
+
+uint32_t DisjointSet::findConcurrent(uint32_t x) {
+    for (;;) {
+        uint32_t p = parent[x].load(std::memory_order_acquire);
+        if (p == x) return x;
+        uint32_t gp = parent[p].load(std::memory_order_acquire);
+        // Only ever moves x closer to its root, so a lost race is harmless
+        if (p != gp) parent[x].compare_exchange_weak(p, gp, std::memory_order_release, std::memory_order_relaxed);
+        x = gp;
+    }
+}
+
+bool DisjointSet::uniteConcurrent(uint32_t a, uint32_t b) {
+    for (;;) {
+        a = findConcurrent(a);
+        b = findConcurrent(b);
+        if (a == b) return false;
+        if (a < b) std::swap(a, b);
+        // a must still be a root; if another thread linked it meanwhile, retry from the new roots
+        uint32_t expected = a;
+        if (parent[a].compare_exchange_strong(expected, b, std::memory_order_acq_rel, std::memory_order_relaxed)) {
+            sets.fetch_sub(1, std::memory_order_relaxed);
+            return true;
+        }
+    }
+}
@@ -0,0 +1,41 @@
+// data_structures/maps_sets/disjoint_set.h
+#pragma once
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+// Union-find over elements [0, n) with parent and rank in flat arrays.
+//
+// Sequential mode (find/unite): union by rank with path halving, near-constant
+// amortized time per operation.
+// Concurrent mode (findConcurrent/uniteConcurrent): any number of threads may
+// call these at once. Roots are linked with a CAS, always the larger id under
+// the smaller so links can never form a cycle; path halving uses a CAS that is
+// simply skipped when another thread got there first.
+// Don't mix the two modes while threads are running.
+class DisjointSet {
+public:
+    explicit DisjointSet(std::uint32_t n = 0);
+
+    void reset(std::uint32_t n);
+
+    std::uint32_t find(std::uint32_t x);
+    // False when a and b were already in the same set
+    bool unite(std::uint32_t a, std::uint32_t b);
+    bool connected(std::uint32_t a, std::uint32_t b) { return find(a) == find(b); }
+
+    std::uint32_t findConcurrent(std::uint32_t x);
+    bool uniteConcurrent(std::uint32_t a, std::uint32_t b);
+
+    std::uint32_t size() const { return elements; }
+    std::uint32_t setCount() const { return sets.load(std::memory_order_relaxed); }
+
+private:
+    // Atomic so the concurrent mode can share them; relaxed accesses cost the same as plain ones
+    std::unique_ptr<std::atomic<std::uint32_t>[]> parent;
+    std::vector<std::uint8_t> rank; // Upper bound on tree height, < 32 for 32-bit ids
+    std::uint32_t elements = 0;
+    std::atomic<std::uint32_t> sets{0};
+};
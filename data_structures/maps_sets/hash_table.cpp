@@ -0,0 +1,5 @@
+// data_structures/maps_sets/hash_table.cpp
+#include "hash_table.h"
+
+// See ../trees/min_heap.cpp
+template class HashTable<int, int>;
@@ -0,0 +1,273 @@
+// data_structures/maps_sets/hash_table.h
+#pragma once
+#include "../../utilities/step_trace.h"
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+// Open-addressing hash map with Robin Hood linear probing. Every entry lives in
+// one flat slot array next to its probe distance, so a lookup reads one or two
+// cache lines and never follows a pointer. On insert, an entry that has probed
+// further than the resident takes its slot and the resident moves on, which
+// keeps probe lengths short and even. A lookup stops as soon as it meets an
+// entry closer to home than itself, so misses are as cheap as hits. Erase
+// shifts the following cluster back one slot instead of leaving a tombstone.
+//
+// The capacity is a power of two and the hash is spread with a Fibonacci
+// multiply, so std::hash's identity hash for integers still fills the table
+// evenly. The table doubles once size would exceed maxLoadFactor * capacity.
+
+struct HashTableStats {
+    std::uint64_t inserts = 0;       // New keys (overwrites are not counted)
+    std::uint64_t lookups = 0;       // find/contains calls
+    std::uint64_t erases = 0;        // Keys removed
+    std::uint64_t probes = 0;        // Slots examined by all operations
+    std::uint64_t displacements = 0; // Residents moved on by a poorer entry
+    std::uint64_t shifts = 0;        // Entries moved back by erase
+    std::uint64_t resizes = 0;       // Rehashes into a larger slot array
+    std::uint32_t maxProbe = 0;      // Longest distance from home at which an entry was placed
+};
+
+template <typename Key, typename Value, typename Hash = std::hash<Key>, typename KeyEqual = std::equal_to<Key>>
+class HashTable {
+public:
+    static constexpr float DEFAULT_MAX_LOAD_FACTOR = 0.875f;
+
+    explicit HashTable(float maxLoadFactor = DEFAULT_MAX_LOAD_FACTOR) { setMaxLoadFactor(maxLoadFactor); }
+
+    // Inserts key, or overwrites its value; true when the key is new
+    bool insert(const Key& key, const Value& value);
+    Value* find(const Key& key) {
+        std::size_t i = slotOf(key);
+        return i == NOT_FOUND ? nullptr : &slots[i].value;
+    }
+    const Value* find(const Key& key) const {
+        std::size_t i = slotOf(key);
+        return i == NOT_FOUND ? nullptr : &slots[i].value;
+    }
+    bool contains(const Key& key) const { return slotOf(key) != NOT_FOUND; }
+    // Slot holding key, or NOT_FOUND
+    std::size_t slotOf(const Key& key) const {
+        ++stats.lookups;
+        return locate(key);
+    }
+    bool erase(const Key& key);
+
+    // Room for n keys without a rehash
+    void reserve(std::size_t n);
+    // Removes every key but keeps the slot array
+    void clear();
+
+    std::size_t size() const { return count; }
+    bool empty() const { return count == 0; }
+    std::size_t capacity() const { return slots.size(); }
+    float loadFactor() const { return slots.empty() ? 0.f : static_cast<float>(count) / static_cast<float>(slots.size()); }
+    float maxLoadFactor() const { return maxLoad; }
+    // Clamped to [0.25, 0.95]; grows right away if the table is already over it
+    void setMaxLoadFactor(float f);
+
+    const HashTableStats& getStats() const { return stats; }
+    void resetStats() { stats = {}; }
+    // Longest distance from home among the entries stored right now
+    std::size_t longestProbe() const;
+
+    // Traced tables record every slot examined (compare), every slot written
+    // with the key now in it, 0 when emptied (write), and each rehash (resize)
+    void setTrace(StepTrace* t) { trace = t; }
+
+    static constexpr std::size_t NOT_FOUND = static_cast<std::size_t>(-1);
+
+private:
+    static constexpr std::size_t MIN_CAPACITY = 8;
+
+    // A 32-bit distance fits in the padding after it for 4-byte keys, and no
+    // hash, however bad, can push an entry 4G slots from home
+    struct Slot {
+        std::uint32_t distance = 0; // 0 = empty, otherwise 1 + slots from home
+        Key key{};
+        Value value{};
+    };
+
+    std::vector<Slot> slots;
+    std::size_t count = 0;
+    std::size_t mask = 0;
+    unsigned shift = 64; // 64 - log2(capacity): the top bits of the mixed hash pick the home slot
+    std::size_t growAt = 0;
+    float maxLoad = DEFAULT_MAX_LOAD_FACTOR;
+    mutable HashTableStats stats; // Lookups are counted from const members too
+    StepTrace* trace = nullptr;
+    Hash hasher;
+    KeyEqual equal;
+
+    std::size_t home(const Key& key) const {
+        std::uint64_t h = static_cast<std::uint64_t>(hasher(key)) * 0x9E3779B97F4A7C15ull;
+        return shift >= 64 ? 0 : static_cast<std::size_t>(h >> shift);
+    }
+    std::size_t locate(const Key& key) const;
+    // Robin Hood placement of entry starting from its home slot. With CheckExisting,
+    // stops and overwrites the value if the key is already present (returns false).
+    template <bool CheckExisting>
+    bool place(Slot entry);
+    void rehash(std::size_t newCapacity);
+    void noteDistance(std::uint32_t distance) { stats.maxProbe = std::max<std::uint32_t>(stats.maxProbe, distance - 1u); }
+    void traceProbe(std::size_t i) const {
+        if (trace) trace->compare(i, i);
+    }
+    void traceWrite(std::size_t i) const {
+        if (!trace) return;
+        if constexpr (std::is_integral<Key>::value) trace->write(i, slots[i].distance ? static_cast<int>(slots[i].key) : 0);
+        else trace->write(i, slots[i].distance ? 1 : 0);
+    }
+};
+
+template <typename Key, typename Value, typename Hash, typename KeyEqual>
+std::size_t HashTable<Key, Value, Hash, KeyEqual>::locate(const Key& key) const {
+    if (count == 0) return NOT_FOUND;
+    // Locals keep the hot loop in registers; the probes are counted and traced afterwards
+    const Slot* table = slots.data();
+    std::size_t start = home(key), i = start, found = NOT_FOUND;
+    std::uint32_t distance = 1;
+    for (;; ++distance, i = (i + 1) & mask) {
+        // An empty slot, or a resident closer to home than key would be: key is absent
+        if (table[i].distance < distance) break;
+        if (table[i].distance == distance && equal(table[i].key, key)) {
+            found = i;
+            break;
+        }
+    }
+    stats.probes += distance;
+    if (trace) {
+        for (std::uint32_t d = 0; d < distance; ++d) traceProbe((start + d) & mask);
+    }
+    return found;
+}
+
+template <typename Key, typename Value, typename Hash, typename KeyEqual>
+bool HashTable<Key, Value, Hash, KeyEqual>::insert(const Key& key, const Value& value) {
+    if (count + 1 > growAt) {
+        // At the threshold an existing key is overwritten in place; only a new one needs the room
+        std::size_t i = locate(key);
+        if (i != NOT_FOUND) {
+            slots[i].value = value;
+            return false;
+        }
+        rehash(std::max(MIN_CAPACITY, slots.size() * 2));
+    }
+    Slot entry;
+    entry.key = key;
+    entry.value = value;
+    if (!place<true>(std::move(entry))) return false;
+    ++stats.inserts;
+    return true;
+}
+
+template <typename Key, typename Value, typename Hash, typename KeyEqual>
+template <bool CheckExisting>
+bool HashTable<Key, Value, Hash, KeyEqual>::place(Slot entry) {
+    Slot* table = slots.data();
+    std::size_t i = home(entry.key);
+    entry.distance = 1;
+    bool original = CheckExisting; // Still carrying the caller's key, which may already be stored
+    for (;;) {
+        ++stats.probes;
+        traceProbe(i);
+        Slot& slot = table[i];
+        if (slot.distance == 0) {
+            slot = std::move(entry);
+            noteDistance(slot.distance);
+            traceWrite(i);
+            ++count;
+            return true;
+        }
+        // An existing copy of the key sits before the first resident poorer than it
+        if (original && slot.distance == entry.distance && equal(slot.key, entry.key)) {
+            slot.value = std::move(entry.value);
+            return false;
+        }
+        if (slot.distance < entry.distance) { // Take from the rich: the resident moves on
+            std::swap(slot, entry);
+            noteDistance(slot.distance);
+            traceWrite(i);
+            ++stats.displacements;
+            original = false;
+        }
+        ++entry.distance;
+        i = (i + 1) & mask;
+    }
+}
+
+template <typename Key, typename Value, typename Hash, typename KeyEqual>
+bool HashTable<Key, Value, Hash, KeyEqual>::erase(const Key& key) {
+    std::size_t i = locate(key);
+    if (i == NOT_FOUND) return false;
+    // Backward shift: pull the rest of the cluster one slot closer to home
+    std::size_t next = (i + 1) & mask;
+    for (;;) {
+        ++stats.probes;
+        if (slots[next].distance <= 1) break; // Empty, or already at home
+        slots[i] = std::move(slots[next]);
+        --slots[i].distance;
+        traceWrite(i);
+        ++stats.shifts;
+        i = next;
+        next = (next + 1) & mask;
+    }
+    slots[i] = Slot{};
+    traceWrite(i);
+    --count;
+    ++stats.erases;
+    return true;
+}
+
+template <typename Key, typename Value, typename Hash, typename KeyEqual>
+void HashTable<Key, Value, Hash, KeyEqual>::rehash(std::size_t newCapacity) {
+    std::vector<Slot> old(newCapacity);
+    old.swap(slots);
+    mask = newCapacity - 1;
+    shift = 64;
+    for (std::size_t c = newCapacity; c > 1; c >>= 1) --shift;
+    growAt = static_cast<std::size_t>(static_cast<double>(maxLoad) * static_cast<double>(newCapacity));
+    count = 0;
+    if (!old.empty()) ++stats.resizes;
+    if (trace) trace->resize(newCapacity);
+    for (Slot& slot : old) {
+        if (slot.distance) place<false>(std::move(slot));
+    }
+}
+
+template <typename Key, typename Value, typename Hash, typename KeyEqual>
+void HashTable<Key, Value, Hash, KeyEqual>::reserve(std::size_t n) {
+    std::size_t target = MIN_CAPACITY;
+    while (static_cast<double>(target) * static_cast<double>(maxLoad) < static_cast<double>(n)) target *= 2;
+    if (target > slots.size()) rehash(target);
+}
+
+template <typename Key, typename Value, typename Hash, typename KeyEqual>
+void HashTable<Key, Value, Hash, KeyEqual>::clear() {
+    for (std::size_t i = 0; i < slots.size(); ++i) {
+        if (!slots[i].distance) continue;
+        slots[i] = Slot{};
+        traceWrite(i);
+    }
+    count = 0;
+}
+
+template <typename Key, typename Value, typename Hash, typename KeyEqual>
+void HashTable<Key, Value, Hash, KeyEqual>::setMaxLoadFactor(float f) {
+    maxLoad = std::min(0.95f, std::max(0.25f, f));
+    growAt = static_cast<std::size_t>(static_cast<double>(maxLoad) * static_cast<double>(slots.size()));
+    if (count > growAt) reserve(count);
+}
+
+template <typename Key, typename Value, typename Hash, typename KeyEqual>
+std::size_t HashTable<Key, Value, Hash, KeyEqual>::longestProbe() const {
+    std::size_t longest = 0;
+    for (const Slot& slot : slots) {
+        if (slot.distance) longest = std::max<std::size_t>(longest, slot.distance - 1u);
+    }
+    return longest;
+}
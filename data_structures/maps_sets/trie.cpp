@@ -0,0 +1,454 @@
+// data_structures/maps_sets/trie.cpp
+#include "trie.h"
+#include <algorithm>
+#include <cstring>
+
+#if defined(__SSE2__)
+#include <immintrin.h>
+#endif
+
+using std::vector;
+using std::size_t;
+using std::string;
+using std::string_view;
+
+namespace {
+
+inline unsigned lowestBit(unsigned mask) {
+#if defined(__GNUC__) || defined(__clang__)
+    return static_cast<unsigned>(__builtin_ctz(mask));
+#else
+    unsigned bit = 0;
+    while (!(mask & 1)) { ++bit; mask >>= 1; }
+    return bit;
+#endif
+}
+
+// Position of c among the first count sorted keys, or count
+inline unsigned findKey16(const std::uint8_t* keys, unsigned count, unsigned char c) {
+#if defined(__SSE2__)
+    __m128i hits = _mm_cmpeq_epi8(_mm_set1_epi8(static_cast<char>(c)), _mm_loadu_si128(reinterpret_cast<const __m128i*>(keys)));
+    unsigned mask = static_cast<unsigned>(_mm_movemask_epi8(hits)) & ((1u << count) - 1);
+    return mask ? lowestBit(mask) : count;
+#else
+    unsigned i = 0;
+    while (i < count && keys[i] != c) ++i;
+    return i;
+#endif
+}
+
+inline size_t commonPrefix(string_view a, string_view b) {
+    size_t n = std::min(a.size(), b.size()), i = 0;
+    while (i < n && a[i] == b[i]) ++i;
+    return i;
+}
+
+} // namespace
+
+void Trie::clear() {
+    rootRef = NO_NODE;
+    words = 0;
+    leaves.clear();
+    nodes4.clear();
+    nodes16.clear();
+    nodes48.clear();
+    nodes256.clear();
+    labels.clear();
+}
+
+size_t Trie::memoryBytes() const {
+    return leaves.bytes() + nodes4.bytes() + nodes16.bytes() + nodes48.bytes() + nodes256.bytes() + labels.capacity();
+}
+
+TrieStats Trie::stats() const {
+    TrieStats s;
+    s.leaves = leaves.live();
+    s.node4 = nodes4.live();
+    s.node16 = nodes16.live();
+    s.node48 = nodes48.live();
+    s.node256 = nodes256.live();
+    s.labelBytes = labels.size();
+    return s;
+}
+
+Trie::Header& Trie::header(NodeRef n) {
+    switch (kindOf(n)) {
+        case Node4: return nodes4.items[indexOf(n)].header;
+        case Node16: return nodes16.items[indexOf(n)].header;
+        case Node48: return nodes48.items[indexOf(n)].header;
+        default: return nodes256.items[indexOf(n)].header;
+    }
+}
+
+string_view Trie::label(NodeRef n) const {
+    Label l = isLeaf(n) ? leaves.items[indexOf(n)].label : header(n).label;
+    return string_view(labels.data() + l.start, l.length);
+}
+
+Trie::NodeRef& Trie::at(Slot slot) {
+    if (slot.parent == NO_NODE) return rootRef;
+    std::uint32_t i = indexOf(slot.parent);
+    switch (kindOf(slot.parent)) {
+        case Node4: return nodes4.items[i].children[slot.position];
+        case Node16: return nodes16.items[i].children[slot.position];
+        case Node48: return nodes48.items[i].children[slot.position];
+        default: return nodes256.items[i].children[slot.position];
+    }
+}
+
+Trie::Label Trie::appendLabel(string_view bytes) {
+    Label l{static_cast<std::uint32_t>(labels.size()), static_cast<std::uint32_t>(bytes.size())};
+    labels.insert(labels.end(), bytes.begin(), bytes.end());
+    return l;
+}
+
+Trie::NodeRef Trie::newLeaf(string_view rest) {
+    Label l = appendLabel(rest);
+    std::uint32_t i = leaves.allocate();
+    leaves.items[i].label = l;
+    return makeRef(Leaf, i);
+}
+
+Trie::NodeRef Trie::newInner(Kind kind, Label label, bool isWord) {
+    NodeRef n;
+    switch (kind) {
+        case Node4: n = makeRef(Node4, nodes4.allocate()); break;
+        case Node16: n = makeRef(Node16, nodes16.allocate()); break;
+        case Node48: {
+            n = makeRef(Node48, nodes48.allocate());
+            std::memset(nodes48.items[indexOf(n)].slotOf, 0, 256);
+            break;
+        }
+        default: {
+            n = makeRef(Node256, nodes256.allocate());
+            std::fill(std::begin(nodes256.items[indexOf(n)].children), std::end(nodes256.items[indexOf(n)].children), NO_NODE);
+            break;
+        }
+    }
+    header(n) = Header{label, 0, static_cast<std::uint8_t>(isWord)};
+    return n;
+}
+
+void Trie::release(NodeRef n) {
+    switch (kindOf(n)) {
+        case Leaf: leaves.release(indexOf(n)); break;
+        case Node4: nodes4.release(indexOf(n)); break;
+        case Node16: nodes16.release(indexOf(n)); break;
+        case Node48: nodes48.release(indexOf(n)); break;
+        case Node256: nodes256.release(indexOf(n)); break;
+    }
+}
+
+bool Trie::findSlot(NodeRef n, unsigned char c, Slot& slot) const {
+    std::uint32_t i = indexOf(n);
+    unsigned position;
+    switch (kindOf(n)) {
+        case Leaf: return false;
+        case Node4: {
+            const Inner4& node = nodes4.items[i];
+            for (position = 0; position < node.header.count && node.keys[position] != c; ++position) {}
+            if (position == node.header.count) return false;
+            break;
+        }
+        case Node16: {
+            const Inner16& node = nodes16.items[i];
+            position = findKey16(node.keys, node.header.count, c);
+            if (position == node.header.count) return false;
+            break;
+        }
+        case Node48: {
+            position = nodes48.items[i].slotOf[c];
+            if (position == 0) return false;
+            --position;
+            break;
+        }
+        default: {
+            if (nodes256.items[i].children[c] == NO_NODE) return false;
+            position = c;
+            break;
+        }
+    }
+    slot = Slot{n, position};
+    return true;
+}
+
+Trie::NodeRef Trie::findChild(NodeRef n, unsigned char c) const {
+    Slot slot;
+    if (!findSlot(n, c, slot)) return NO_NODE;
+    return const_cast<Trie*>(this)->at(slot);
+}
+
+// Copies a full node into the next size up and releases it
+Trie::NodeRef Trie::grow(NodeRef n) {
+    std::uint32_t i = indexOf(n);
+    NodeRef bigger;
+    switch (kindOf(n)) {
+        case Node4: {
+            bigger = newInner(Node16, header(n).label, header(n).isWord);
+            const Inner4& from = nodes4.items[i];
+            Inner16& to = nodes16.items[indexOf(bigger)];
+            std::copy(from.keys, from.keys + from.header.count, to.keys);
+            std::copy(from.children, from.children + from.header.count, to.children);
+            to.header.count = from.header.count;
+            break;
+        }
+        case Node16: {
+            bigger = newInner(Node48, header(n).label, header(n).isWord);
+            const Inner16& from = nodes16.items[i];
+            Inner48& to = nodes48.items[indexOf(bigger)];
+            for (unsigned k = 0; k < from.header.count; ++k) {
+                to.slotOf[from.keys[k]] = static_cast<std::uint8_t>(k + 1);
+                to.children[k] = from.children[k];
+            }
+            to.header.count = from.header.count;
+            break;
+        }
+        default: { // Node48
+            bigger = newInner(Node256, header(n).label, header(n).isWord);
+            const Inner48& from = nodes48.items[i];
+            Inner256& to = nodes256.items[indexOf(bigger)];
+            for (unsigned c = 0; c < 256; ++c) {
+                if (from.slotOf[c]) to.children[c] = from.children[from.slotOf[c] - 1];
+            }
+            to.header.count = from.header.count;
+            break;
+        }
+    }
+    release(n);
+    return bigger;
+}
+
+void Trie::addChild(Slot slot, unsigned char c, NodeRef child) {
+    NodeRef n = at(slot);
+    static constexpr std::uint16_t CAPACITY[] = {0, 4, 16, 48, 256};
+    if (header(n).count == CAPACITY[kindOf(n)]) {
+        n = grow(n);
+        at(slot) = n;
+    }
+    std::uint32_t i = indexOf(n);
+    switch (kindOf(n)) {
+        case Node4:
+        case Node16: {
+            // Keep the keys sorted: shift the larger ones up one place
+            std::uint8_t* keys = kindOf(n) == Node4 ? nodes4.items[i].keys : nodes16.items[i].keys;
+            NodeRef* children = kindOf(n) == Node4 ? nodes4.items[i].children : nodes16.items[i].children;
+            unsigned count = header(n).count, position = count;
+            while (position > 0 && keys[position - 1] > c) {
+                keys[position] = keys[position - 1];
+                children[position] = children[position - 1];
+                --position;
+            }
+            keys[position] = c;
+            children[position] = child;
+            break;
+        }
+        case Node48: {
+            Inner48& node = nodes48.items[i];
+            node.children[node.header.count] = child; // No erase, so the children array has no holes
+            node.slotOf[c] = static_cast<std::uint8_t>(node.header.count + 1);
+            break;
+        }
+        default: nodes256.items[i].children[c] = child; break;
+    }
+    ++header(n).count;
+}
+
+std::uint32_t Trie::nextChild(NodeRef n, std::uint32_t cursor, NodeRef& child) const {
+    std::uint32_t i = indexOf(n);
+    switch (kindOf(n)) {
+        case Leaf: return 0;
+        case Node4:
+        case Node16: {
+            const std::uint8_t* keys = kindOf(n) == Node4 ? nodes4.items[i].keys : nodes16.items[i].keys;
+            const NodeRef* children = kindOf(n) == Node4 ? nodes4.items[i].children : nodes16.items[i].children;
+            for (unsigned k = 0, count = header(n).count; k < count; ++k) {
+                if (keys[k] < cursor) continue;
+                child = children[k];
+                return keys[k] + 1u;
+            }
+            return 0;
+        }
+        case Node48: {
+            const Inner48& node = nodes48.items[i];
+            for (std::uint32_t c = cursor; c < 256; ++c) {
+                if (!node.slotOf[c]) continue;
+                child = node.children[node.slotOf[c] - 1];
+                return c + 1;
+            }
+            return 0;
+        }
+        default: {
+            const Inner256& node = nodes256.items[i];
+            for (std::uint32_t c = cursor; c < 256; ++c) {
+                if (node.children[c] == NO_NODE) continue;
+                child = node.children[c];
+                return c + 1;
+            }
+            return 0;
+        }
+    }
+}
+
+bool Trie::contains(string_view word) const {
+    NodeRef n = rootRef;
+    size_t depth = 0;
+    while (n != NO_NODE) {
+        string_view l = label(n);
+        if (word.size() - depth < l.size() || word.compare(depth, l.size(), l) != 0) return false;
+        depth += l.size();
+        if (depth == word.size()) return isWord(n);
+        n = findChild(n, static_cast<unsigned char>(word[depth]));
+        ++depth;
+    }
+    return false;
+}
+
+bool Trie::insert(string_view word) {
+    Slot slot{NO_NODE, 0};
+    NodeRef n = rootRef;
+    size_t depth = 0;
+    if (n == NO_NODE) {
+        rootRef = newLeaf(word);
+        ++words;
+        return true;
+    }
+    for (;;) {
+        string_view l = label(n);
+        size_t matched = commonPrefix(l, word.substr(depth));
+        if (matched < l.size()) {
+            // The word leaves n's label part way: a node4 holding the shared part
+            // takes n's place, and n keeps the bytes after the branch
+            unsigned char branch = static_cast<unsigned char>(l[matched]);
+            Label& old = labelOf(n);
+            Label shared{old.start, static_cast<std::uint32_t>(matched)};
+            old.start += static_cast<std::uint32_t>(matched + 1);
+            old.length -= static_cast<std::uint32_t>(matched + 1);
+            bool endsHere = depth + matched == word.size();
+            NodeRef split = newInner(Node4, shared, endsHere);
+            at(slot) = split;
+            addChild(slot, branch, n);
+            if (!endsHere) addChild(slot, static_cast<unsigned char>(word[depth + matched]), newLeaf(word.substr(depth + matched + 1)));
+            ++words;
+            return true;
+        }
+        depth += matched;
+        if (depth == word.size()) {
+            if (isWord(n)) return false;
+            header(n).isWord = 1;
+            ++words;
+            return true;
+        }
+        unsigned char c = static_cast<unsigned char>(word[depth]);
+        if (isLeaf(n)) {
+            // A longer word runs through the leaf: it becomes a node4 that ends a word
+            NodeRef inner = newInner(Node4, labelOf(n), true);
+            release(n);
+            at(slot) = inner;
+            addChild(slot, c, newLeaf(word.substr(depth + 1)));
+            ++words;
+            return true;
+        }
+        Slot next;
+        if (!findSlot(n, c, next)) {
+            NodeRef leaf = newLeaf(word.substr(depth + 1));
+            addChild(slot, c, leaf);
+            ++words;
+            return true;
+        }
+        slot = next;
+        n = at(slot);
+        ++depth;
+    }
+}
+
+void Trie::bulkLoad(const vector<string>& sorted) {
+    clear();
+    if (sorted.empty()) return;
+    // Words [first, last) share their first depth bytes and hang from slot
+    struct Task {
+        size_t first, last, depth;
+        Slot slot;
+    };
+    vector<Task> tasks = {{0, sorted.size(), 0, Slot{NO_NODE, 0}}};
+    vector<size_t> groupStarts;
+    while (!tasks.empty()) {
+        Task t = tasks.back();
+        tasks.pop_back();
+        const string& lowest = sorted[t.first];
+        const string& highest = sorted[t.last - 1];
+        if (lowest == highest) { // One word, perhaps repeated
+            at(t.slot) = newLeaf(string_view(lowest).substr(t.depth));
+            ++words;
+            continue;
+        }
+        // Sorted, so the first and last words bound what the whole range shares
+        size_t shared = commonPrefix(string_view(lowest).substr(t.depth), string_view(highest).substr(t.depth));
+        size_t end = t.depth + shared;
+        size_t first = t.first;
+        bool endsHere = lowest.size() == end; // The shortest sorts first
+        while (first < t.last && sorted[first].size() == end) ++first;
+        groupStarts.clear();
+        for (size_t i = first; i < t.last; ++i) {
+            if (i == first || sorted[i][end] != sorted[i - 1][end]) groupStarts.push_back(i);
+        }
+        size_t groups = groupStarts.size();
+        Kind kind = groups <= 4 ? Node4 : groups <= 16 ? Node16 : groups <= 48 ? Node48 : Node256;
+        NodeRef n = newInner(kind, appendLabel(string_view(lowest).substr(t.depth, shared)), endsHere);
+        at(t.slot) = n;
+        if (endsHere) ++words;
+        // Placeholders in byte order, each filled in by its group's task. Those
+        // are pushed last group first, so children are built (and allocated) in order.
+        for (size_t g = 0; g < groups; ++g) addChild(t.slot, static_cast<unsigned char>(sorted[groupStarts[g]][end]), NO_NODE);
+        for (size_t g = groups; g-- > 0;) {
+            unsigned char c = static_cast<unsigned char>(sorted[groupStarts[g]][end]);
+            size_t groupEnd = g + 1 < groups ? groupStarts[g + 1] : t.last;
+            tasks.push_back({groupStarts[g], groupEnd, end + 1, Slot{n, kind == Node256 ? c : static_cast<std::uint32_t>(g)}});
+        }
+    }
+}
+
+Trie::PrefixIterator::PrefixIterator(const Trie* trie, string_view prefix) : owner(trie) {
+    // Find the node whose subtree holds every word starting with prefix; the
+    // prefix may end part way through its label
+    stack.reserve(INITIAL_STACK);
+    NodeRef n = trie->rootRef;
+    size_t depth = 0;
+    while (n != NO_NODE) {
+        string_view l = trie->label(n);
+        size_t compared = std::min(l.size(), prefix.size() - depth);
+        if (prefix.compare(depth, compared, l.substr(0, compared)) != 0) return;
+        if (depth + compared == prefix.size()) {
+            word.assign(prefix.substr(0, depth));
+            enter(n);
+            if (!trie->isWord(n)) advance();
+            return;
+        }
+        depth += l.size();
+        n = trie->findChild(n, static_cast<unsigned char>(prefix[depth]));
+        ++depth;
+    }
+}
+
+// word holds everything before n's label
+void Trie::PrefixIterator::enter(NodeRef n) {
+    word.append(owner->label(n));
+    stack.push_back(Frame{n, 0, word.size()});
+}
+
+void Trie::PrefixIterator::advance() {
+    while (!stack.empty()) {
+        Frame& top = stack.back();
+        NodeRef child;
+        std::uint32_t next = owner->nextChild(top.node, top.cursor, child);
+        if (next == 0) {
+            stack.pop_back();
+            continue;
+        }
+        top.cursor = next;
+        word.resize(top.length);
+        word.push_back(static_cast<char>(next - 1));
+        enter(child);
+        if (owner->isWord(child)) return;
+    }
+    word.clear();
+}
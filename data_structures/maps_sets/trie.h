@@ -0,0 +1,229 @@
+// data_structures/maps_sets/trie.h
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <string>
+#include <string_view>
+#include <vector>
+
+// Set of byte strings as a compressed, adaptive radix tree (ART style). A chain
+// of single-child nodes collapses into one node whose label holds the bytes of
+// the whole chain, and every word that shares no further branch ends in a leaf
+// holding the rest of the word. Inner nodes come in four sizes and grow into the
+// next one when full:
+//   node4    up to 4 children, keys and children side by side (32 bytes)
+//   node16   up to 16, keys compared 16 at a time with SSE2 where available
+//   node48   a 256-entry byte index into 48 children
+//   node256  one child per byte value
+// so a node pays for the children it has rather than for a whole alphabet,
+// the way a 26-pointer-per-node trie does. Children are kept in byte order,
+// which makes every walk below a node lexicographic.
+//
+// Each kind of node lives in its own contiguous arena and links by 32-bit index,
+// like the binary trees' NodePool; labels are offsets into one shared byte arena,
+// so splitting a label only moves an offset. Nodes outgrown by insert go on a
+// free list per kind and are reused. Nothing recurses, so keys of any length are
+// safe; the label arena is addressed with 32 bits and holds up to 4 GiB.
+
+struct TrieStats {
+    std::size_t leaves = 0;
+    std::size_t node4 = 0;
+    std::size_t node16 = 0;
+    std::size_t node48 = 0;
+    std::size_t node256 = 0;
+    std::size_t labelBytes = 0; // Bytes of the label arena in use
+};
+
+class Trie {
+public:
+    using NodeRef = std::uint32_t;
+    static constexpr NodeRef NO_NODE = 0xFFFFFFFFu;
+
+    // False when word was already present
+    bool insert(std::string_view word);
+    bool contains(std::string_view word) const;
+    // Replaces the contents with the words of a sorted list (duplicates are
+    // dropped) in time linear in their total length. Each node is built at its
+    // final size and nodes and labels are laid out in pre-order, so a lookup or
+    // a prefix walk moves forward through the arenas.
+    void bulkLoad(const std::vector<std::string>& sorted);
+
+    std::size_t size() const { return words; }
+    bool empty() const { return words == 0; }
+    void clear();
+    std::size_t memoryBytes() const;
+    TrieStats stats() const;
+
+    // Lazy walk over the words starting with a prefix, in lexicographic order.
+    // Each increment does only the work needed to reach the next word, so taking
+    // the first k completions costs about k words however many there are. The
+    // word is rebuilt in one buffer and stays valid until the next increment.
+    // Don't modify the trie while iterating.
+    class PrefixIterator {
+    public:
+        using iterator_category = std::input_iterator_tag;
+        using value_type = std::string;
+        using difference_type = std::ptrdiff_t;
+        using pointer = const std::string*;
+        using reference = const std::string&;
+
+        PrefixIterator() = default; // The end of every walk
+        PrefixIterator(const Trie* trie, std::string_view prefix);
+        reference operator*() const { return word; }
+        pointer operator->() const { return &word; }
+        PrefixIterator& operator++() {
+            advance();
+            return *this;
+        }
+        // Single pass: only the test against end() is meaningful
+        bool operator==(const PrefixIterator& other) const { return stack.empty() == other.stack.empty(); }
+        bool operator!=(const PrefixIterator& other) const { return !(*this == other); }
+
+    private:
+        static constexpr std::size_t INITIAL_STACK = 16; // Deeper than most words' branch points
+
+        struct Frame {
+            NodeRef node;
+            std::uint32_t cursor; // Where the search for the next child resumes
+            std::size_t length;   // Length of word up to the end of node's label
+        };
+        const Trie* owner = nullptr;
+        std::string word;
+        std::vector<Frame> stack;
+
+        void enter(NodeRef n);
+        void advance();
+    };
+
+    class PrefixRange {
+    public:
+        PrefixRange(const Trie* trie, std::string_view prefixKey) : owner(trie), prefix(prefixKey) {}
+        PrefixIterator begin() const { return PrefixIterator(owner, prefix); }
+        PrefixIterator end() const { return PrefixIterator(); }
+
+    private:
+        const Trie* owner;
+        std::string prefix;
+    };
+
+    PrefixRange withPrefix(std::string_view prefix) const { return PrefixRange(this, prefix); }
+
+    // Read-only access to the node structure, for drawing it. A node's label is
+    // the bytes after the edge byte that leads to it; the root has no edge byte.
+    NodeRef root() const { return rootRef; }
+    bool isLeaf(NodeRef n) const { return kindOf(n) == Leaf; }
+    bool isWord(NodeRef n) const { return isLeaf(n) || header(n).isWord; }
+    std::string_view label(NodeRef n) const;
+    // Calls visit(byte, child) for each child of n in byte order
+    template<typename Visit>
+    void forEachChild(NodeRef n, Visit visit) const {
+        NodeRef child;
+        for (std::uint32_t cursor = 0; (cursor = nextChild(n, cursor, child)) != 0;) {
+            visit(static_cast<unsigned char>(cursor - 1), child);
+        }
+    }
+
+private:
+    enum Kind : std::uint32_t { Leaf, Node4, Node16, Node48, Node256 };
+    static constexpr unsigned KIND_SHIFT = 29;
+    static constexpr NodeRef INDEX_MASK = (NodeRef(1) << KIND_SHIFT) - 1;
+
+    struct Label {
+        std::uint32_t start;
+        std::uint32_t length;
+    };
+    struct Header {
+        Label label;
+        std::uint16_t count; // Children
+        std::uint8_t isWord; // A word ends after this node's label
+    };
+    struct LeafNode {
+        Label label; // The rest of the word
+    };
+    struct Inner4 {
+        Header header;
+        std::uint8_t keys[4];
+        NodeRef children[4];
+    };
+    struct Inner16 {
+        Header header;
+        std::uint8_t keys[16];
+        NodeRef children[16];
+    };
+    struct Inner48 {
+        Header header;
+        std::uint8_t slotOf[256]; // 0 = no child, otherwise 1 + index into children
+        NodeRef children[48];
+    };
+    struct Inner256 {
+        Header header;
+        NodeRef children[256];
+    };
+
+    // One arena per kind of node; freed slots are handed out again first
+    template<typename T>
+    struct Arena {
+        std::vector<T> items;
+        std::vector<std::uint32_t> freeSlots;
+        std::uint32_t allocate() {
+            if (!freeSlots.empty()) {
+                std::uint32_t i = freeSlots.back();
+                freeSlots.pop_back();
+                return i;
+            }
+            items.emplace_back();
+            return static_cast<std::uint32_t>(items.size() - 1);
+        }
+        void release(std::uint32_t i) { freeSlots.push_back(i); }
+        void clear() {
+            items.clear();
+            freeSlots.clear();
+        }
+        std::size_t live() const { return items.size() - freeSlots.size(); }
+        std::size_t bytes() const {
+            return items.capacity() * sizeof(T) + freeSlots.capacity() * sizeof(std::uint32_t);
+        }
+    };
+
+    // Where a node is linked from: child slot `position` of parent, or the root
+    // when parent is NO_NODE. Stays valid while the arenas grow, unlike a pointer.
+    struct Slot {
+        NodeRef parent;
+        std::uint32_t position;
+    };
+
+    NodeRef rootRef = NO_NODE;
+    std::size_t words = 0;
+    Arena<LeafNode> leaves;
+    Arena<Inner4> nodes4;
+    Arena<Inner16> nodes16;
+    Arena<Inner48> nodes48;
+    Arena<Inner256> nodes256;
+    std::vector<char> labels;
+
+    static Kind kindOf(NodeRef n) { return static_cast<Kind>(n >> KIND_SHIFT); }
+    static std::uint32_t indexOf(NodeRef n) { return n & INDEX_MASK; }
+    static NodeRef makeRef(Kind kind, std::uint32_t index) { return (NodeRef(kind) << KIND_SHIFT) | index; }
+
+    // Precondition: n is not a leaf
+    Header& header(NodeRef n);
+    const Header& header(NodeRef n) const { return const_cast<Trie*>(this)->header(n); }
+    Label& labelOf(NodeRef n) { return isLeaf(n) ? leaves.items[indexOf(n)].label : header(n).label; }
+    NodeRef& at(Slot slot);
+    Label appendLabel(std::string_view bytes);
+    NodeRef newLeaf(std::string_view rest);
+    NodeRef newInner(Kind kind, Label label, bool isWord);
+
+    // Child of n under byte c, or NO_NODE; findSlot also says where it is linked
+    NodeRef findChild(NodeRef n, unsigned char c) const;
+    bool findSlot(NodeRef n, unsigned char c, Slot& slot) const;
+    // Links child under byte c of the node at slot, first growing that node
+    // into the next size (and relinking it) when it is full
+    void addChild(Slot slot, unsigned char c, NodeRef child);
+    NodeRef grow(NodeRef n);
+    void release(NodeRef n);
+    // Next child at or after cursor in byte order: stores it in child and
+    // returns 1 + its byte, or 0 when there is none. Leaves have no children.
+    std::uint32_t nextChild(NodeRef n, std::uint32_t cursor, NodeRef& child) const;
+};
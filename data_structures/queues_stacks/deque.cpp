@@ -0,0 +1,5 @@
+// data_structures/queues_stacks/deque.cpp
+#include "deque.h"
+
+// See ../trees/min_heap.cpp
+template class Deque<int>;
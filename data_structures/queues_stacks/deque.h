@@ -0,0 +1,170 @@
+// data_structures/queues_stacks/deque.h
+#pragma once
+#include <cstddef>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+// Double-ended queue in fixed-size blocks of BLOCK_SIZE elements. The blocks
+// sit in a ring of block pointers and elements run round it from `start`, so
+// both ends push and pop in O(1) with no per-element allocation, and elements
+// never move once placed (references stay valid until the element is popped).
+//
+// A block is allocated the first time an element lands in it and is kept when
+// it empties: a queue whose length stays bounded slides round the same blocks
+// and stops allocating once warm, where std::deque frees and reallocates a
+// block every BLOCK_SIZE pops. The ring doubles when the elements would need
+// all of it; shrinkToFit() hands unused blocks back.
+template<typename T>
+class Deque {
+public:
+    // About 4 KiB per block, rounded down to a power of two elements and never fewer than 16
+    static constexpr std::size_t BLOCK_SIZE = [] {
+        std::size_t elements = 16;
+        while (elements * 2 * sizeof(T) <= 4096) elements *= 2;
+        return elements;
+    }();
+
+    Deque() = default;
+    ~Deque() { clear(); }
+    Deque(const Deque&) = delete;
+    Deque& operator=(const Deque&) = delete;
+    Deque(Deque&& other) noexcept
+        : blocks(std::move(other.blocks)), start(other.start), count(other.count), mask(other.mask), limit(other.limit) {
+        other.blocks.clear();
+        other.start = other.count = other.mask = other.limit = 0;
+    }
+    Deque& operator=(Deque&& other) noexcept {
+        if (this != &other) {
+            clear();
+            blocks = std::move(other.blocks);
+            start = other.start;
+            count = other.count;
+            mask = other.mask;
+            limit = other.limit;
+            other.blocks.clear();
+            other.start = other.count = other.mask = other.limit = 0;
+        }
+        return *this;
+    }
+
+    void pushBack(const T& value) { emplaceBack(value); }
+    void pushBack(T&& value) { emplaceBack(std::move(value)); }
+    void pushFront(const T& value) { emplaceFront(value); }
+    void pushFront(T&& value) { emplaceFront(std::move(value)); }
+
+    template<typename... Args>
+    T& emplaceBack(Args&&... args) {
+        makeRoom();
+        T* p = new (place(start + count)) T(std::forward<Args>(args)...);
+        ++count;
+        return *p;
+    }
+    template<typename... Args>
+    T& emplaceFront(Args&&... args) {
+        makeRoom();
+        std::size_t first = (start - 1) & mask;
+        T* p = new (place(first)) T(std::forward<Args>(args)...);
+        start = first;
+        ++count;
+        return *p;
+    }
+
+    // Preconditions: not empty
+    void popFront() {
+        front().~T();
+        start = (start + 1) & mask;
+        --count;
+    }
+    void popBack() {
+        back().~T();
+        --count;
+    }
+
+    T& front() { return (*this)[0]; }
+    const T& front() const { return (*this)[0]; }
+    T& back() { return (*this)[count - 1]; }
+    const T& back() const { return (*this)[count - 1]; }
+    T& operator[](std::size_t i) { return *address(start + i); }
+    const T& operator[](std::size_t i) const { return *const_cast<Deque*>(this)->address(start + i); }
+
+    std::size_t size() const { return count; }
+    bool empty() const { return count == 0; }
+    // Destroys the elements; the blocks stay for reuse
+    void clear() {
+        while (count > 0) popBack();
+        start = 0;
+    }
+    // Frees the blocks no element is using
+    void shrinkToFit();
+
+    std::size_t blockCount() const;
+    std::size_t memoryBytes() const {
+        return blockCount() * BLOCK_SIZE * sizeof(T) + blocks.capacity() * sizeof(blocks[0]);
+    }
+
+private:
+    static_assert((BLOCK_SIZE & (BLOCK_SIZE - 1)) == 0, "BLOCK_SIZE must be a power of two");
+    static constexpr unsigned BLOCK_SHIFT = [] {
+        unsigned shift = 0;
+        while ((std::size_t(1) << shift) < BLOCK_SIZE) ++shift;
+        return shift;
+    }();
+
+    using Storage = std::aligned_storage_t<sizeof(T), alignof(T)>;
+
+    // Ring of blocks, a power of two long (or empty); unused ones may be null
+    std::vector<std::unique_ptr<Storage[]>> blocks;
+    std::size_t start = 0; // Position of the front element in the ring
+    std::size_t count = 0;
+    std::size_t mask = 0;  // Positions in the ring, minus one
+    std::size_t limit = 0; // Elements that fit while one block stays free
+
+    T* address(std::size_t position) {
+        position &= mask;
+        return std::launder(reinterpret_cast<T*>(&blocks[position >> BLOCK_SHIFT][position & (BLOCK_SIZE - 1)]));
+    }
+    // Storage for an element at position, allocating its block if this is the block's first use
+    void* place(std::size_t position) {
+        position &= mask;
+        std::unique_ptr<Storage[]>& block = blocks[position >> BLOCK_SHIFT];
+        if (!block) block.reset(new Storage[BLOCK_SIZE]);
+        return &block[position & (BLOCK_SIZE - 1)];
+    }
+    // Keeps one block free, so the elements never wrap round into the block the
+    // front is in; growing can then lay the blocks out again front first
+    void makeRoom() {
+        if (count < limit) return;
+        std::size_t oldSize = blocks.size();
+        std::vector<std::unique_ptr<Storage[]>> grown(oldSize == 0 ? 2 : oldSize * 2);
+        std::size_t first = start >> BLOCK_SHIFT;
+        for (std::size_t k = 0; k < oldSize; ++k) grown[k] = std::move(blocks[(first + k) & (oldSize - 1)]);
+        blocks = std::move(grown);
+        start &= BLOCK_SIZE - 1;
+        mask = blocks.size() * BLOCK_SIZE - 1;
+        limit = (blocks.size() - 1) * BLOCK_SIZE;
+    }
+};
+
+template<typename T>
+void Deque<T>::shrinkToFit() {
+    if (blocks.empty()) return;
+    // Blocks holding elements run on from the front's block
+    std::size_t first = start >> BLOCK_SHIFT;
+    std::size_t used = count == 0 ? 0 : ((start & (BLOCK_SIZE - 1)) + count + BLOCK_SIZE - 1) >> BLOCK_SHIFT;
+    for (std::size_t k = used; k < blocks.size(); ++k) blocks[(first + k) & (blocks.size() - 1)].reset();
+    if (count == 0) {
+        blocks.clear();
+        blocks.shrink_to_fit();
+        start = mask = limit = 0;
+    }
+}
+
+template<typename T>
+std::size_t Deque<T>::blockCount() const {
+    std::size_t allocated = 0;
+    for (const auto& block : blocks) allocated += block != nullptr;
+    return allocated;
+}
@@ -0,0 +1,334 @@
+// data_structures/queues_stacks/priority_queue.h
+#pragma once
+#include "../trees/min_heap.h"
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <limits>
+#include <queue>
+#include <string>
+#include <utility>
+#include <vector>
+
+// Min-priority queues over item ids [0, n), all with the same interface so
+// Dijkstra and Prim can be instantiated with any of them:
+//
+//   reset(n)          empty the queue for ids [0, n)
+//   update(id, key)   insert id, or lower its key if it is queued with a larger one
+//   pop(item)         remove the smallest live item; false when the queue is empty
+//   getStats()        operation counts since the last reset
+//
+// Updates to an id that was already popped are ignored.
+
+enum class PriorityQueueKind { LazyBinary, IndexedDary, Pairing, Radix, MinHeap };
+
+inline const std::vector<std::string> PRIORITY_QUEUE_NAMES = {
+    "binary-lazy", "4-ary-indexed", "pairing", "radix", "minheap-lazy"
+};
+
+struct PriorityQueueStats {
+    std::uint64_t pushes = 0;       // Entries physically inserted
+    std::uint64_t pops = 0;         // Entries physically removed, stale ones included
+    std::uint64_t decreaseKeys = 0; // update() calls that lowered a queued id's key
+    std::uint64_t stalePops = 0;    // Outdated duplicates discarded by lazy deletion
+};
+
+struct QueueItem {
+    std::int64_t key;
+    std::uint32_t id;
+};
+
+// --- Lazy deletion ----------------------------------------------------------
+// Heaps without decrease-key push a duplicate instead and drop the outdated
+// copy when it surfaces. best[id] tracks the live key of every queued id.
+
+template <typename Heap>
+class LazyDeletionQueue {
+public:
+    void reset(std::uint32_t n) {
+        heap.clear();
+        best.assign(n, NOT_QUEUED);
+        stats = {};
+    }
+    void update(std::uint32_t id, std::int64_t key) {
+        if (key >= best[id]) return; // Not an improvement, or already popped (POPPED is the minimum)
+        if (best[id] != NOT_QUEUED) ++stats.decreaseKeys;
+        best[id] = key;
+        heap.push(key, id);
+        ++stats.pushes;
+    }
+    bool pop(QueueItem& item) {
+        while (!heap.empty()) {
+            item = heap.pop();
+            ++stats.pops;
+            if (item.key == best[item.id]) {
+                best[item.id] = POPPED;
+                return true;
+            }
+            ++stats.stalePops;
+        }
+        return false;
+    }
+    const PriorityQueueStats& getStats() const { return stats; }
+
+private:
+    static constexpr std::int64_t NOT_QUEUED = std::numeric_limits<std::int64_t>::max();
+    static constexpr std::int64_t POPPED = std::numeric_limits<std::int64_t>::min();
+    Heap heap;
+    std::vector<std::int64_t> best;
+    PriorityQueueStats stats;
+};
+
+// std::priority_queue as a min-heap of items
+class StdBinaryHeap {
+public:
+    void push(std::int64_t key, std::uint32_t id) { heap.push({key, id}); }
+    QueueItem pop() {
+        QueueItem top = heap.top();
+        heap.pop();
+        return top;
+    }
+    bool empty() const { return heap.empty(); }
+    void clear() { heap = {}; }
+
+private:
+    struct Greater {
+        bool operator()(const QueueItem& a, const QueueItem& b) const { return a.key > b.key; }
+    };
+    std::priority_queue<QueueItem, std::vector<QueueItem>, Greater> heap;
+};
+
+// The data-structure MinHeap (4-ary) behind the same adapter
+class MinHeapAdapter {
+public:
+    void push(std::int64_t key, std::uint32_t id) { heap.push({key, id}); }
+    QueueItem pop() { return heap.pop(); }
+    bool empty() const { return heap.empty(); }
+    void clear() { heap.clear(); }
+
+private:
+    struct KeyLess {
+        bool operator()(const QueueItem& a, const QueueItem& b) const { return a.key < b.key; }
+    };
+    MinHeap<QueueItem, KeyLess> heap;
+};
+
+// Monotone radix heap for non-negative integer keys: every push must be >= the
+// last popped key (true for Dijkstra). Bucket b > 0 holds keys whose highest bit
+// differing from the last popped key is bit b-1, so each entry moves down at most
+// 64 times in total and pop is amortized O(log C) without comparisons between entries.
+class RadixHeap {
+public:
+    void push(std::int64_t key, std::uint32_t id) {
+        buckets[bucketOf(static_cast<std::uint64_t>(key))].push_back({key, id});
+        ++count;
+    }
+    QueueItem pop() {
+        if (buckets[0].empty()) {
+            std::size_t b = 1;
+            while (buckets[b].empty()) ++b;
+            // The new minimum becomes the reference point; the rest of the bucket splits lower
+            std::uint64_t newLast = std::numeric_limits<std::uint64_t>::max();
+            for (const QueueItem& item : buckets[b]) newLast = std::min(newLast, static_cast<std::uint64_t>(item.key));
+            last = newLast;
+            for (const QueueItem& item : buckets[b]) buckets[bucketOf(static_cast<std::uint64_t>(item.key))].push_back(item);
+            buckets[b].clear();
+        }
+        QueueItem item = buckets[0].back();
+        buckets[0].pop_back();
+        --count;
+        return item;
+    }
+    bool empty() const { return count == 0; }
+    void clear() {
+        for (std::vector<QueueItem>& bucket : buckets) bucket.clear();
+        last = 0;
+        count = 0;
+    }
+
+private:
+    std::vector<QueueItem> buckets[65];
+    std::uint64_t last = 0;
+    std::size_t count = 0;
+
+    std::size_t bucketOf(std::uint64_t key) const {
+        std::uint64_t diff = key ^ last;
+        if (diff == 0) return 0;
+#if defined(__GNUC__) || defined(__clang__)
+        return static_cast<std::size_t>(64 - __builtin_clzll(diff));
+#else
+        std::size_t bits = 0;
+        while (diff) { ++bits; diff >>= 1; }
+        return bits;
+#endif
+    }
+};
+
+// --- Indexed d-ary heap -----------------------------------------------------
+// Real decrease-key: position[id] locates the entry so it can sift up in place.
+// A wider node makes the tree shallower, trading a few more compares per
+// sift-down for fewer cache misses.
+
+template <unsigned D = 4>
+class IndexedDaryHeap {
+public:
+    void reset(std::uint32_t n) {
+        heap.clear();
+        position.assign(n, NOT_QUEUED);
+        stats = {};
+    }
+    void update(std::uint32_t id, std::int64_t key) {
+        std::uint32_t pos = position[id];
+        if (pos == POPPED) return;
+        if (pos == NOT_QUEUED) {
+            heap.push_back({key, id});
+            siftUp(heap.size() - 1);
+            ++stats.pushes;
+        } else if (key < heap[pos].key) {
+            heap[pos].key = key;
+            siftUp(pos);
+            ++stats.decreaseKeys;
+        }
+    }
+    bool pop(QueueItem& item) {
+        if (heap.empty()) return false;
+        item = heap.front();
+        position[item.id] = POPPED;
+        QueueItem last = heap.back();
+        heap.pop_back();
+        if (!heap.empty()) siftDown(last);
+        ++stats.pops;
+        return true;
+    }
+    const PriorityQueueStats& getStats() const { return stats; }
+
+private:
+    static constexpr std::uint32_t NOT_QUEUED = std::numeric_limits<std::uint32_t>::max();
+    static constexpr std::uint32_t POPPED = NOT_QUEUED - 1;
+    std::vector<QueueItem> heap;       // Keys stored inline so sifting never leaves the array
+    std::vector<std::uint32_t> position;
+    PriorityQueueStats stats;
+
+    void place(std::size_t i, const QueueItem& item) {
+        heap[i] = item;
+        position[item.id] = static_cast<std::uint32_t>(i);
+    }
+    void siftUp(std::size_t i) {
+        QueueItem item = heap[i];
+        while (i > 0) {
+            std::size_t parent = (i - 1) / D;
+            if (heap[parent].key <= item.key) break;
+            place(i, heap[parent]);
+            i = parent;
+        }
+        place(i, item);
+    }
+    // Fills the hole at the root with item
+    void siftDown(const QueueItem& item) {
+        std::size_t i = 0, n = heap.size();
+        for (;;) {
+            std::size_t first = i * D + 1;
+            if (first >= n) break;
+            std::size_t best = first, end = std::min(first + D, n);
+            for (std::size_t c = first + 1; c < end; ++c) {
+                if (heap[c].key < heap[best].key) best = c;
+            }
+            if (item.key <= heap[best].key) break;
+            place(i, heap[best]);
+            i = best;
+        }
+        place(i, item);
+    }
+};
+
+// --- Pairing heap -----------------------------------------------------------
+// Multiway tree with O(1) insert and meld and cheap decrease-key (cut the
+// subtree, meld it with the root); pop pairs up the root's children in two
+// passes. Nodes live in one array indexed by id and link by 32-bit index.
+
+class PairingHeap {
+public:
+    void reset(std::uint32_t n) {
+        nodes.assign(n, Node{});
+        root = NIL;
+        stats = {};
+    }
+    void update(std::uint32_t id, std::int64_t key) {
+        Node& node = nodes[id];
+        if (node.state == Popped) return;
+        if (node.state == Idle) {
+            node = Node{key, NIL, NIL, NIL, Queued};
+            root = root == NIL ? id : meld(root, id);
+            ++stats.pushes;
+        } else if (key < node.key) {
+            node.key = key;
+            if (id != root) {
+                detach(id);
+                root = meld(root, id);
+            }
+            ++stats.decreaseKeys;
+        }
+    }
+    bool pop(QueueItem& item) {
+        if (root == NIL) return false;
+        item = {nodes[root].key, root};
+        nodes[root].state = Popped;
+        root = mergeChildren(nodes[root].child);
+        ++stats.pops;
+        return true;
+    }
+    const PriorityQueueStats& getStats() const { return stats; }
+
+private:
+    static constexpr std::uint32_t NIL = std::numeric_limits<std::uint32_t>::max();
+    enum State : std::uint8_t { Idle, Queued, Popped };
+    struct Node {
+        std::int64_t key = 0;
+        std::uint32_t child = NIL;
+        std::uint32_t sibling = NIL;
+        std::uint32_t prev = NIL; // Parent when leftmost child, otherwise left sibling
+        State state = Idle;
+    };
+    std::vector<Node> nodes;
+    std::vector<std::uint32_t> scratch;
+    std::uint32_t root = NIL;
+    PriorityQueueStats stats;
+
+    // Both arguments are roots; the larger key becomes the leftmost child of the smaller
+    std::uint32_t meld(std::uint32_t a, std::uint32_t b) {
+        if (nodes[b].key < nodes[a].key) std::swap(a, b);
+        Node& top = nodes[a];
+        Node& sub = nodes[b];
+        sub.sibling = top.child;
+        if (top.child != NIL) nodes[top.child].prev = b;
+        sub.prev = a;
+        top.child = b;
+        return a;
+    }
+    void detach(std::uint32_t id) {
+        Node& node = nodes[id];
+        Node& prev = nodes[node.prev];
+        if (prev.child == id) prev.child = node.sibling;
+        else prev.sibling = node.sibling;
+        if (node.sibling != NIL) nodes[node.sibling].prev = node.prev;
+        node.sibling = node.prev = NIL;
+    }
+    // Two-pass pairing: meld neighbours left to right, then fold the pairs right to left
+    std::uint32_t mergeChildren(std::uint32_t first) {
+        scratch.clear();
+        for (std::uint32_t c = first; c != NIL;) {
+            std::uint32_t next = nodes[c].sibling;
+            nodes[c].sibling = nodes[c].prev = NIL;
+            scratch.push_back(c);
+            c = next;
+        }
+        if (scratch.empty()) return NIL;
+        std::size_t pairs = 0;
+        for (std::size_t i = 0; i + 1 < scratch.size(); i += 2) scratch[pairs++] = meld(scratch[i], scratch[i + 1]);
+        if (scratch.size() % 2) scratch[pairs++] = scratch.back();
+        std::uint32_t result = scratch[pairs - 1];
+        for (std::size_t i = pairs - 1; i-- > 0;) result = meld(scratch[i], result);
+        return result;
+    }
+};
@@ -0,0 +1,9 @@
+// data_structures/queues_stacks/queue.cpp
+#include "queue.h"
+#include "../../utilities/step_trace.h"
+
+// See ../trees/min_heap.cpp
+template class Queue<int>;
+template class SpscRing<TraceEvent>;
+template class MpmcRing<TraceEvent>;
+template class MutexQueue<TraceEvent>;
@@ -0,0 +1,215 @@
+// data_structures/queues_stacks/queue.h
+#pragma once
+#include "deque.h"
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <type_traits>
+#include <utility>
+
+// FIFO queue: the back of a Deque in, the front out
+template<typename T>
+class Queue {
+public:
+    void push(const T& value) { items.pushBack(value); }
+    void push(T&& value) { items.pushBack(std::move(value)); }
+    template<typename... Args>
+    T& emplace(Args&&... args) { return items.emplaceBack(std::forward<Args>(args)...); }
+    // Precondition: not empty
+    void pop() { items.popFront(); }
+
+    T& front() { return items.front(); }
+    const T& front() const { return items.front(); }
+    T& back() { return items.back(); }
+    const T& back() const { return items.back(); }
+    std::size_t size() const { return items.size(); }
+    bool empty() const { return items.empty(); }
+    void clear() { items.clear(); }
+
+private:
+    Deque<T> items;
+};
+
+// --- Bounded lock-free rings --------------------------------------------------
+// Fixed-capacity queues for handing items between threads (e.g. step events
+// from an algorithm's workers to the render thread) without a lock. Capacity
+// is rounded up to a power of two; tryPush fails when the ring is full and
+// tryPop when it is empty, and the caller decides whether to spin, yield or
+// drop. Slots are assigned rather than constructed, so T must be
+// default-constructible and movable.
+//
+// Each side's index has a cache line of its own: were the producer's and the
+// consumer's on one line, every push would evict the consumer's copy and every
+// pop the producer's, even with no item contended.
+
+constexpr std::size_t CACHE_LINE = 64;
+
+// One producer thread, one consumer thread. Each side also keeps a cached
+// copy of the other's index and only rereads the shared one when the cache
+// says the ring is full (or empty), so in the steady state a push or pop
+// touches no line the other thread writes except the slot itself.
+template<typename T>
+class SpscRing {
+public:
+    explicit SpscRing(std::size_t capacity) : mask(roundUp(capacity) - 1), slots(new T[mask + 1]) {}
+    SpscRing(const SpscRing&) = delete;
+    SpscRing& operator=(const SpscRing&) = delete;
+
+    // Producer thread only
+    template<typename U>
+    bool tryPush(U&& value) {
+        std::size_t tail = producer.tail.load(std::memory_order_relaxed);
+        if (tail - producer.cachedHead > mask) {
+            producer.cachedHead = consumer.head.load(std::memory_order_acquire);
+            if (tail - producer.cachedHead > mask) return false;
+        }
+        slots[tail & mask] = std::forward<U>(value);
+        producer.tail.store(tail + 1, std::memory_order_release);
+        return true;
+    }
+    // Consumer thread only
+    bool tryPop(T& out) {
+        std::size_t head = consumer.head.load(std::memory_order_relaxed);
+        if (head == consumer.cachedTail) {
+            consumer.cachedTail = producer.tail.load(std::memory_order_acquire);
+            if (head == consumer.cachedTail) return false;
+        }
+        out = std::move(slots[head & mask]);
+        consumer.head.store(head + 1, std::memory_order_release);
+        return true;
+    }
+
+    std::size_t capacity() const { return mask + 1; }
+    // Exact only when neither side is running
+    std::size_t sizeApprox() const {
+        return producer.tail.load(std::memory_order_acquire) - consumer.head.load(std::memory_order_acquire);
+    }
+
+private:
+    struct alignas(CACHE_LINE) ProducerSide {
+        std::atomic<std::size_t> tail{0};
+        std::size_t cachedHead = 0;
+    };
+    struct alignas(CACHE_LINE) ConsumerSide {
+        std::atomic<std::size_t> head{0};
+        std::size_t cachedTail = 0;
+    };
+
+    static std::size_t roundUp(std::size_t capacity) {
+        std::size_t rounded = 2;
+        while (rounded < capacity) rounded *= 2;
+        return rounded;
+    }
+
+    // Read-only after construction: shared freely by both sides
+    const std::size_t mask;
+    const std::unique_ptr<T[]> slots;
+    ProducerSide producer;
+    ConsumerSide consumer;
+};
+
+// Any number of producers and consumers (Vyukov's bounded queue). Each slot
+// carries a sequence number saying whose turn it is: pos when free for the
+// push that claims ticket pos, pos + 1 once filled for the pop with ticket
+// pos. A thread claims a ticket with one compare-and-swap on its side's index
+// and then owns the slot, so contention is one CAS per operation and a slow
+// thread delays only the slot it holds.
+template<typename T>
+class MpmcRing {
+public:
+    explicit MpmcRing(std::size_t capacity) : mask(roundUp(capacity) - 1), cells(new Cell[mask + 1]) {
+        for (std::size_t i = 0; i <= mask; ++i) cells[i].sequence.store(i, std::memory_order_relaxed);
+    }
+    MpmcRing(const MpmcRing&) = delete;
+    MpmcRing& operator=(const MpmcRing&) = delete;
+
+    template<typename U>
+    bool tryPush(U&& value) {
+        std::size_t pos = enqueue.position.load(std::memory_order_relaxed);
+        Cell* cell;
+        for (;;) {
+            cell = &cells[pos & mask];
+            std::size_t sequence = cell->sequence.load(std::memory_order_acquire);
+            std::ptrdiff_t turn = static_cast<std::ptrdiff_t>(sequence - pos);
+            if (turn == 0) {
+                if (enqueue.position.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) break;
+            } else if (turn < 0) {
+                return false; // The slot still holds the item from one lap ago: full
+            } else {
+                pos = enqueue.position.load(std::memory_order_relaxed);
+            }
+        }
+        cell->value = std::forward<U>(value);
+        cell->sequence.store(pos + 1, std::memory_order_release);
+        return true;
+    }
+    bool tryPop(T& out) {
+        std::size_t pos = dequeue.position.load(std::memory_order_relaxed);
+        Cell* cell;
+        for (;;) {
+            cell = &cells[pos & mask];
+            std::size_t sequence = cell->sequence.load(std::memory_order_acquire);
+            std::ptrdiff_t turn = static_cast<std::ptrdiff_t>(sequence - (pos + 1));
+            if (turn == 0) {
+                if (dequeue.position.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) break;
+            } else if (turn < 0) {
+                return false; // Not filled yet: empty
+            } else {
+                pos = dequeue.position.load(std::memory_order_relaxed);
+            }
+        }
+        out = std::move(cell->value);
+        cell->sequence.store(pos + mask + 1, std::memory_order_release); // Free for the push one lap on
+        return true;
+    }
+
+    std::size_t capacity() const { return mask + 1; }
+
+private:
+    struct Cell {
+        std::atomic<std::size_t> sequence;
+        T value;
+    };
+    struct alignas(CACHE_LINE) Index {
+        std::atomic<std::size_t> position{0};
+    };
+
+    static std::size_t roundUp(std::size_t capacity) {
+        std::size_t rounded = 2;
+        while (rounded < capacity) rounded *= 2;
+        return rounded;
+    }
+
+    const std::size_t mask;
+    const std::unique_ptr<Cell[]> cells;
+    Index enqueue;
+    Index dequeue;
+};
+
+// Unbounded Queue behind one mutex, the baseline the rings are measured against
+template<typename T>
+class MutexQueue {
+public:
+    template<typename U>
+    void push(U&& value) {
+        std::lock_guard<std::mutex> lock(mutex);
+        items.push(std::forward<U>(value));
+    }
+    bool tryPop(T& out) {
+        std::lock_guard<std::mutex> lock(mutex);
+        if (items.empty()) return false;
+        out = std::move(items.front());
+        items.pop();
+        return true;
+    }
+    std::size_t size() const {
+        std::lock_guard<std::mutex> lock(mutex);
+        return items.size();
+    }
+
+private:
+    mutable std::mutex mutex;
+    Queue<T> items;
+};
@@ -0,0 +1,5 @@
+// data_structures/queues_stacks/stack.cpp
+#include "stack.h"
+
+// See ../trees/min_heap.cpp
+template class Stack<int>;
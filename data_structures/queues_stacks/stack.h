@@ -0,0 +1,27 @@
+// data_structures/queues_stacks/stack.h
+#pragma once
+#include "deque.h"
+#include <cstddef>
+#include <utility>
+
+// LIFO stack on the back of a Deque. Unlike a vector it never copies its
+// elements to grow, so references to them stay valid while it does.
+template<typename T>
+class Stack {
+public:
+    void push(const T& value) { items.pushBack(value); }
+    void push(T&& value) { items.pushBack(std::move(value)); }
+    template<typename... Args>
+    T& emplace(Args&&... args) { return items.emplaceBack(std::forward<Args>(args)...); }
+    // Precondition: not empty
+    void pop() { items.popBack(); }
+
+    T& top() { return items.back(); }
+    const T& top() const { return items.back(); }
+    std::size_t size() const { return items.size(); }
+    bool empty() const { return items.empty(); }
+    void clear() { items.clear(); }
+
+private:
+    Deque<T> items;
+};
@@ -0,0 +1,112 @@
+// data_structures/trees/avl_tree.cpp
+#include "avl_tree.h"
+#include <algorithm>
+
+bool AVLTree::insert(int key) {
+    if (pool.full()) return false;
+    bool added = false;
+    retrace = false;
+    rootIndex = insertAt(rootIndex, key, added);
+    return added;
+}
+
+bool AVLTree::erase(int key) {
+    bool removed = false;
+    retrace = false;
+    rootIndex = eraseAt(rootIndex, key, removed);
+    return removed;
+}
+
+void AVLTree::updateHeight(NodeIndex n) {
+    int h = 1 + std::max(heightOf(pool[n].left()), heightOf(pool[n].right()));
+    pool[n].setMeta(static_cast<std::uint8_t>(h));
+}
+
+NodeIndex AVLTree::rebalance(NodeIndex n) {
+    updateHeight(n);
+    int balance = heightOf(pool[n].left()) - heightOf(pool[n].right());
+    if (balance > 1) {
+        NodeIndex l = pool[n].left();
+        if (heightOf(pool[l].left()) < heightOf(pool[l].right())) { // Left-right: straighten first
+            pool[n].setLeft(rotateLeft(l));
+            updateHeight(l);
+        }
+        NodeIndex top = rotateRight(n);
+        updateHeight(n);
+        updateHeight(top);
+        return top;
+    }
+    if (balance < -1) {
+        NodeIndex r = pool[n].right();
+        if (heightOf(pool[r].right()) < heightOf(pool[r].left())) { // Right-left
+            pool[n].setRight(rotateRight(r));
+            updateHeight(r);
+        }
+        NodeIndex top = rotateLeft(n);
+        updateHeight(n);
+        updateHeight(top);
+        return top;
+    }
+    return n;
+}
+
+NodeIndex AVLTree::insertAt(NodeIndex n, int key, bool& added) {
+    if (n == NIL_NODE) {
+        added = true;
+        retrace = true;
+        return pool.allocate(key, 1);
+    }
+    if (key == pool[n].key) return n;
+    // Index the pool again after the call: allocate() may have moved it
+    if (key < pool[n].key) {
+        NodeIndex child = insertAt(pool[n].left(), key, added);
+        pool[n].setLeft(child);
+    } else {
+        NodeIndex child = insertAt(pool[n].right(), key, added);
+        pool[n].setRight(child);
+    }
+    return retrace ? retraced(n) : n;
+}
+
+// Rebalances n; once a subtree comes out as tall as it went in, nothing above
+// it can change, so the ancestors stop looking at their other child
+NodeIndex AVLTree::retraced(NodeIndex n) {
+    std::uint8_t before = pool[n].meta();
+    NodeIndex top = rebalance(n);
+    if (pool[top].meta() == before) retrace = false;
+    return top;
+}
+
+NodeIndex AVLTree::eraseAt(NodeIndex n, int key, bool& removed) {
+    if (n == NIL_NODE) return NIL_NODE;
+    if (key < pool[n].key) {
+        pool[n].setLeft(eraseAt(pool[n].left(), key, removed));
+    } else if (key > pool[n].key) {
+        pool[n].setRight(eraseAt(pool[n].right(), key, removed));
+    } else {
+        removed = true;
+        retrace = true;
+        NodeIndex l = pool[n].left(), r = pool[n].right();
+        std::uint8_t height = pool[n].meta();
+        pool.release(n);
+        if (l == NIL_NODE) return r;
+        if (r == NIL_NODE) return l;
+        // Two children: the successor takes this node's place
+        NodeIndex successor;
+        NodeIndex rest = detachMin(r, &successor);
+        pool[successor].setLeft(l);
+        pool[successor].setRight(rest);
+        pool[successor].setMeta(height); // Its height before the erase, for retraced()
+        n = successor;
+    }
+    return retrace ? retraced(n) : n;
+}
+
+NodeIndex AVLTree::detachMin(NodeIndex n, NodeIndex* minimum) {
+    if (pool[n].left() == NIL_NODE) {
+        *minimum = n;
+        return pool[n].right();
+    }
+    pool[n].setLeft(detachMin(pool[n].left(), minimum));
+    return rebalance(n);
+}
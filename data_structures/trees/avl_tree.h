@@ -0,0 +1,29 @@
+// data_structures/trees/avl_tree.h
+#pragma once
+#include "binary_search_tree.h"
+
+// Height-balanced search tree: the two subtrees of every node differ in height
+// by at most one, so height stays below 1.45 log2(n). Each node's height lives
+// in its packed meta byte. Insert and erase recurse along one root-to-leaf path
+// (at most ~40 levels for the 2^28 nodes a pool can hold) and rebalance on the
+// way back up with single or double rotations.
+class AVLTree : public BinarySearchTree {
+public:
+    bool insert(int key) override;
+    bool erase(int key) override;
+    // Inherited bulk load: a minimum-height tree is height-balanced, and it
+    // already records subtree heights
+    using BinarySearchTree::bulkLoad;
+
+private:
+    bool retrace = false; // Set while an insert or erase may still change subtree heights on its way up
+
+    int heightOf(NodeIndex n) const { return n == NIL_NODE ? 0 : pool[n].meta(); }
+    void updateHeight(NodeIndex n);
+    NodeIndex rebalance(NodeIndex n);
+    NodeIndex retraced(NodeIndex n);
+    NodeIndex insertAt(NodeIndex n, int key, bool& added);
+    NodeIndex eraseAt(NodeIndex n, int key, bool& removed);
+    // Unlinks the smallest node of the subtree into *minimum
+    NodeIndex detachMin(NodeIndex n, NodeIndex* minimum);
+};
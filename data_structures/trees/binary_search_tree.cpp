@@ -0,0 +1,77 @@
+// data_structures/trees/binary_search_tree.cpp
+#include "binary_search_tree.h"
+#include <algorithm>
+
+using std::vector;
+using std::size_t;
+
+bool BinarySearchTree::insert(int key) {
+    if (pool.full()) return false;
+    NodeIndex parent = NIL_NODE, n = rootIndex;
+    while (n != NIL_NODE) {
+        if (key == pool[n].key) return false;
+        parent = n;
+        n = key < pool[n].key ? pool[n].left() : pool[n].right();
+    }
+    NodeIndex added = pool.allocate(key);
+    if (parent == NIL_NODE) rootIndex = added;
+    else if (key < pool[parent].key) pool[parent].setLeft(added);
+    else pool[parent].setRight(added);
+    return true;
+}
+
+bool BinarySearchTree::erase(int key) {
+    NodeIndex parent = NIL_NODE, n = rootIndex;
+    while (n != NIL_NODE && pool[n].key != key) {
+        parent = n;
+        n = key < pool[n].key ? pool[n].left() : pool[n].right();
+    }
+    if (n == NIL_NODE) return false;
+    if (pool[n].left() != NIL_NODE && pool[n].right() != NIL_NODE) {
+        // Two children: take the successor's key, then unlink the successor, which has no left child
+        parent = n;
+        NodeIndex successor = pool[n].right();
+        while (pool[successor].left() != NIL_NODE) {
+            parent = successor;
+            successor = pool[successor].left();
+        }
+        pool[n].key = pool[successor].key;
+        n = successor;
+    }
+    NodeIndex child = pool[n].left() != NIL_NODE ? pool[n].left() : pool[n].right();
+    if (parent == NIL_NODE) rootIndex = child;
+    else if (pool[parent].left() == n) pool[parent].setLeft(child);
+    else pool[parent].setRight(child);
+    pool.release(n);
+    return true;
+}
+
+void BinarySearchTree::bulkLoad(const vector<int>& sorted) {
+    vector<int> keys = distinctSorted(sorted);
+    clear();
+    pool.reserve(keys.size());
+    rootIndex = buildBalanced(keys.data(), keys.size());
+}
+
+NodeIndex BinarySearchTree::buildBalanced(const int* first, size_t count) {
+    if (count == 0) return NIL_NODE;
+    size_t mid = count / 2;
+    size_t height = 0;
+    for (size_t c = count; c; c >>= 1) ++height;
+    NodeIndex n = pool.allocate(first[mid], static_cast<std::uint8_t>(height));
+    NodeIndex l = buildBalanced(first, mid);
+    NodeIndex r = buildBalanced(first + mid + 1, count - mid - 1);
+    pool[n].setLeft(l);
+    pool[n].setRight(r);
+    return n;
+}
+
+vector<int> BinarySearchTree::distinctSorted(const vector<int>& sorted) {
+    vector<int> keys;
+    keys.reserve(std::min<size_t>(sorted.size(), NIL_NODE));
+    for (int k : sorted) {
+        if (keys.size() == NIL_NODE) break;
+        if (keys.empty() || keys.back() != k) keys.push_back(k);
+    }
+    return keys;
+}
@@ -0,0 +1,36 @@
+// data_structures/trees/binary_search_tree.h
+#pragma once
+#include "binary_tree.h"
+#include <vector>
+
+// Unbalanced binary search tree over distinct int keys: smaller keys to the
+// left, larger to the right. Insert and erase walk iteratively, so even a tree
+// built from sorted keys, one long path, never overflows the stack. AVLTree and
+// RedBlackTree override insert/erase/bulkLoad to keep themselves balanced;
+// lookups are the same for all three.
+class BinarySearchTree : public BinaryTree {
+public:
+    // False when key was already present, or when the pool is full (NIL_NODE nodes)
+    virtual bool insert(int key);
+    // False when key was absent
+    virtual bool erase(int key);
+    // Replaces the contents with the keys of a sorted vector (duplicates are
+    // dropped) in O(n), as a tree of minimum height. Nodes are allocated in
+    // pre-order, so every descent walks forward through the pool.
+    virtual void bulkLoad(const std::vector<int>& sorted);
+
+    bool contains(int key) const { return find(key) != NIL_NODE; }
+    // Node holding key, or NIL_NODE
+    NodeIndex find(int key) const {
+        NodeIndex n = rootIndex;
+        while (n != NIL_NODE && pool[n].key != key) n = key < pool[n].key ? pool[n].left() : pool[n].right();
+        return n;
+    }
+
+protected:
+    // Sorted keys in [first, first + count) become a minimum-height subtree.
+    // Each node's meta gets its subtree height, which is what AVLTree keeps there.
+    // Recursion depth is log2(count).
+    NodeIndex buildBalanced(const int* first, std::size_t count);
+    static std::vector<int> distinctSorted(const std::vector<int>& sorted);
+};
@@ -0,0 +1,69 @@
+// data_structures/trees/binary_tree.cpp
+#include "binary_tree.h"
+#include <algorithm>
+#include <utility>
+
+using std::vector;
+using std::size_t;
+
+void BinaryTree::clear() {
+    pool.clear();
+    rootIndex = NIL_NODE;
+    rotations = 0;
+}
+
+size_t BinaryTree::height() const {
+    if (rootIndex == NIL_NODE) return 0;
+    size_t best = 0;
+    vector<std::pair<NodeIndex, size_t>> stack = {{rootIndex, 1}};
+    while (!stack.empty()) {
+        auto [n, depth] = stack.back();
+        stack.pop_back();
+        best = std::max(best, depth);
+        if (pool[n].left() != NIL_NODE) stack.push_back({pool[n].left(), depth + 1});
+        if (pool[n].right() != NIL_NODE) stack.push_back({pool[n].right(), depth + 1});
+    }
+    return best;
+}
+
+void BinaryTree::buildLevelOrder(const vector<int>& values) {
+    clear();
+    size_t n = std::min<size_t>(values.size(), NIL_NODE);
+    pool.reserve(n);
+    // Allocated in order, so node i sits at pool index i
+    for (size_t i = 0; i < n; ++i) pool.allocate(values[i]);
+    for (size_t i = 0; i < n; ++i) {
+        if (2 * i + 1 < n) pool[static_cast<NodeIndex>(i)].setLeft(static_cast<NodeIndex>(2 * i + 1));
+        if (2 * i + 2 < n) pool[static_cast<NodeIndex>(i)].setRight(static_cast<NodeIndex>(2 * i + 2));
+    }
+    rootIndex = n > 0 ? 0 : NIL_NODE;
+}
+
+void BinaryTree::buildPath(const vector<int>& values, bool leftward) {
+    clear();
+    size_t n = std::min<size_t>(values.size(), NIL_NODE);
+    pool.reserve(n);
+    for (size_t i = 0; i < n; ++i) pool.allocate(values[i]);
+    for (size_t i = 0; i + 1 < n; ++i) {
+        NodeIndex child = static_cast<NodeIndex>(i + 1);
+        if (leftward) pool[static_cast<NodeIndex>(i)].setLeft(child);
+        else pool[static_cast<NodeIndex>(i)].setRight(child);
+    }
+    rootIndex = n > 0 ? 0 : NIL_NODE;
+}
+
+NodeIndex BinaryTree::rotateLeft(NodeIndex n) {
+    NodeIndex r = pool[n].right();
+    pool[n].setRight(pool[r].left());
+    pool[r].setLeft(n);
+    ++rotations;
+    return r;
+}
+
+NodeIndex BinaryTree::rotateRight(NodeIndex n) {
+    NodeIndex l = pool[n].left();
+    pool[n].setLeft(pool[l].right());
+    pool[l].setRight(n);
+    ++rotations;
+    return l;
+}
@@ -0,0 +1,51 @@
+// data_structures/trees/binary_tree.h
+#pragma once
+#include "../../utilities/node.h"
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// Binary tree of int keys whose nodes come from the tree's own NodePool and
+// link by 32-bit index (NIL_NODE for no child). The search trees derive from
+// it; on its own it holds any shape, e.g. a complete tree in level order for
+// the BFS/DFS views. Nothing here recurses, so degenerate trees of any depth
+// are safe.
+class BinaryTree {
+public:
+    virtual ~BinaryTree() = default;
+
+    NodeIndex root() const { return rootIndex; }
+    int key(NodeIndex n) const { return pool[n].key; }
+    NodeIndex left(NodeIndex n) const { return pool[n].left(); }
+    NodeIndex right(NodeIndex n) const { return pool[n].right(); }
+
+    std::size_t size() const { return pool.size(); }
+    bool empty() const { return rootIndex == NIL_NODE; }
+    void clear();
+    void reserve(std::size_t n) { pool.reserve(n); }
+    // Levels on the longest root-to-leaf path (0 when empty)
+    std::size_t height() const;
+    std::size_t memoryBytes() const { return pool.memoryBytes(); }
+
+    // Replaces the contents with a complete tree holding values in level order:
+    // values[i] gets children values[2i+1] and values[2i+2]
+    void buildLevelOrder(const std::vector<int>& values);
+    // Replaces the contents with a single path: values[0] at the root and each
+    // value the right (or left) child of the one before. This is the shape a
+    // search tree takes when keys arrive sorted, built here in O(n).
+    void buildPath(const std::vector<int>& values, bool leftward = false);
+
+    // Rotations performed since the tree was created or cleared
+    std::uint64_t getRotations() const { return rotations; }
+
+protected:
+    friend class TreeTraversal; // Morris traversal threads the tree and restores it
+
+    NodePool pool;
+    NodeIndex rootIndex = NIL_NODE;
+    std::uint64_t rotations = 0;
+
+    // Both return the subtree's new root; the caller relinks it
+    NodeIndex rotateLeft(NodeIndex n);
+    NodeIndex rotateRight(NodeIndex n);
+};
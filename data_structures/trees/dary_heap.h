@@ -0,0 +1,148 @@
+// data_structures/trees/dary_heap.h
+#pragma once
+#include <algorithm>
+#include <cstddef>
+#include <functional>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+// Array-backed d-ary heap shared by MinHeap and MaxHeap. Compare(a, b) is true
+// when a belongs above b, so std::less gives a min-heap. Node i's children are
+// D*i+1 .. D*i+D; a wider node makes the heap shallower, and with D = 4 and
+// small elements a node's children share one cache line.
+//
+// The heapBuild/heapSiftDown/heapSiftUp functions work on any array, which is
+// how heap sort reuses them in place. An observer hears about every compare and
+// store, by index, so traced callers can replay them; the default does nothing.
+
+struct NullHeapObserver {
+    void compare(std::size_t, std::size_t) {}
+    template <typename T> void write(std::size_t, const T&) {}
+};
+
+// Moves parents down until value fits, then stores it in the hole
+template <unsigned D, typename T, typename Compare, typename Observer = NullHeapObserver>
+void heapSiftUp(T* a, std::size_t hole, T value, Compare comp, Observer&& obs = Observer()) {
+    while (hole > 0) {
+        std::size_t parent = (hole - 1) / D;
+        obs.compare(parent, hole);
+        if (!comp(value, a[parent])) break;
+        a[hole] = std::move(a[parent]);
+        obs.write(hole, a[hole]);
+        hole = parent;
+    }
+    a[hole] = std::move(value);
+    obs.write(hole, a[hole]);
+}
+
+// Highest-priority child of a full group a[first, first + D). Small trivially
+// copyable elements are tracked by value so the compiler emits conditional moves:
+// which child wins is a coin flip, and a mispredicted branch per level costs more
+// than the select.
+template <unsigned D, typename T, typename Compare, typename Observer>
+std::size_t heapBestChild(const T* a, std::size_t first, Compare comp, Observer& obs) {
+    std::size_t best = first;
+    if constexpr (std::is_trivially_copyable<T>::value && sizeof(T) <= 16) {
+        T bestValue = a[first];
+        for (unsigned k = 1; k < D; ++k) {
+            obs.compare(first + k, best);
+            T value = a[first + k];
+            bool better = comp(value, bestValue);
+            best = better ? first + k : best;
+            bestValue = better ? value : bestValue;
+        }
+    } else {
+        for (unsigned k = 1; k < D; ++k) {
+            obs.compare(first + k, best);
+            if (comp(a[first + k], a[best])) best = first + k;
+        }
+    }
+    return best;
+}
+
+// Fills the hole at `hole` of a[0, n) with value. Bottom-up: the hole first
+// follows the best child all the way to a leaf, then value sifts back up, but
+// never above where it started. Values refilled from the end of a heap belong
+// near the bottom, so this saves the compare against value on every level down.
+template <unsigned D, typename T, typename Compare, typename Observer = NullHeapObserver>
+void heapSiftDown(T* a, std::size_t n, std::size_t hole, T value, Compare comp, Observer&& obs = Observer()) {
+    std::size_t top = hole;
+    for (std::size_t first = hole * D + 1; first < n; first = hole * D + 1) {
+#if defined(__GNUC__) || defined(__clang__)
+        // The grandchildren are contiguous (D*D elements, one cache line for a 4-ary
+        // heap of ints), so one prefetch covers whichever child wins below
+        if (first * D + 1 < n) __builtin_prefetch(a + first * D + 1);
+#endif
+        std::size_t best = first;
+        if (first + D <= n) best = heapBestChild<D>(a, first, comp, obs);
+        else for (std::size_t c = first + 1; c < n; ++c) {
+            obs.compare(c, best);
+            if (comp(a[c], a[best])) best = c;
+        }
+        a[hole] = std::move(a[best]);
+        obs.write(hole, a[hole]);
+        hole = best;
+    }
+    while (hole > top) {
+        std::size_t parent = (hole - 1) / D;
+        obs.compare(parent, hole);
+        if (!comp(value, a[parent])) break;
+        a[hole] = std::move(a[parent]);
+        obs.write(hole, a[hole]);
+        hole = parent;
+    }
+    a[hole] = std::move(value);
+    obs.write(hole, a[hole]);
+}
+
+// Floyd's construction: sift down every internal node, last first. O(n), since
+// most nodes sit near the bottom and only move a level or two.
+template <unsigned D, typename T, typename Compare, typename Observer = NullHeapObserver>
+void heapBuild(T* a, std::size_t n, Compare comp, Observer&& obs = Observer()) {
+    if (n < 2) return;
+    for (std::size_t i = (n - 2) / D + 1; i-- > 0;) {
+        T value = std::move(a[i]);
+        heapSiftDown<D>(a, n, i, std::move(value), comp, obs);
+    }
+}
+
+template <typename T, typename Compare, unsigned D = 4>
+class DaryHeap {
+    static_assert(D >= 2, "a heap node needs at least two children");
+
+public:
+    explicit DaryHeap(Compare c = Compare()) : comp(c) {}
+    // Takes items and heapifies them in O(n)
+    explicit DaryHeap(std::vector<T> items, Compare c = Compare()) : heap(std::move(items)), comp(c) {
+        heapBuild<D>(heap.data(), heap.size(), comp);
+    }
+    void assign(std::vector<T> items) {
+        heap = std::move(items);
+        heapBuild<D>(heap.data(), heap.size(), comp);
+    }
+
+    void push(T value) {
+        heap.emplace_back();
+        heapSiftUp<D>(heap.data(), heap.size() - 1, std::move(value), comp);
+    }
+    T pop() { // Precondition: !empty()
+        T result = std::move(heap.front());
+        T last = std::move(heap.back());
+        heap.pop_back();
+        if (!heap.empty()) heapSiftDown<D>(heap.data(), heap.size(), 0, std::move(last), comp);
+        return result;
+    }
+    const T& top() const { return heap.front(); }
+
+    bool empty() const { return heap.empty(); }
+    std::size_t size() const { return heap.size(); }
+    void clear() { heap.clear(); }
+    void reserve(std::size_t n) { heap.reserve(n); }
+    // Heap-ordered contents, for drawing the tree
+    const std::vector<T>& data() const { return heap; }
+
+private:
+    std::vector<T> heap;
+    Compare comp;
+};
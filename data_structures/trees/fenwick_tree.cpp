@@ -0,0 +1,52 @@
+// data_structures/trees/fenwick_tree.cpp
+#include "fenwick_tree.h"
+
+using std::vector;
+using std::size_t;
+using std::int64_t;
+
+void FenwickTree::build(const vector<int64_t>& values) {
+    size_t n = values.size();
+    tree.assign(n + 1, 0);
+    for (size_t i = 1; i <= n; ++i) {
+        tree[i] += values[i - 1];
+        size_t parent = i + (i & (0 - i));
+        if (parent <= n) tree[parent] += tree[i];
+    }
+}
+
+size_t FenwickTree::lowerBound(int64_t target, StepTrace* trace) const {
+    if (target <= 0) return 0;
+    size_t n = size();
+    size_t step = 1;
+    while (step * 2 <= n) step *= 2;
+    // Invariant: prefixSum(pos) < target, and target has been reduced by it
+    size_t pos = 0;
+    for (; step > 0; step /= 2) {
+        size_t next = pos + step;
+        if (next > n) continue;
+        if (trace) trace->compare(next - 1, next - 1);
+        if (tree[next] < target) {
+            pos = next;
+            target -= tree[next];
+        }
+    }
+    return pos + 1;
+}
+
+void RangeFenwickTree::build(const vector<int64_t>& values) {
+    size_t n = values.size();
+    tree.assign(n + 1, Cell{0, 0});
+    int64_t previous = 0;
+    for (size_t i = 1; i <= n; ++i) {
+        int64_t d = values[i - 1] - previous;
+        previous = values[i - 1];
+        tree[i].base += d;
+        tree[i].scaled += d * static_cast<int64_t>(i - 1);
+        size_t parent = i + (i & (0 - i));
+        if (parent <= n) {
+            tree[parent].base += tree[i].base;
+            tree[parent].scaled += tree[i].scaled;
+        }
+    }
+}
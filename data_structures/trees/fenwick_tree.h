@@ -0,0 +1,89 @@
+// data_structures/trees/fenwick_tree.h
+#pragma once
+#include "../../utilities/step_trace.h"
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// Binary indexed tree over int64 values: point add and prefix sum in O(log n)
+// with one flat array and no per-node bookkeeping. Cell i (1-based) holds the
+// sum of the i & -i values ending at i. Building from a whole array is O(n):
+// each cell passes its total up to the one cell that covers it next.
+class FenwickTree {
+public:
+    FenwickTree() = default;
+    explicit FenwickTree(std::size_t n) : tree(n + 1, 0) {}
+    explicit FenwickTree(const std::vector<std::int64_t>& values) { build(values); }
+
+    void build(const std::vector<std::int64_t>& values);
+    std::size_t size() const { return tree.empty() ? 0 : tree.size() - 1; }
+
+    void add(std::size_t i, std::int64_t delta) {
+        for (std::size_t k = i + 1; k < tree.size(); k += k & (0 - k)) tree[k] += delta;
+    }
+    // Sum of the first count values
+    std::int64_t prefixSum(std::size_t count) const {
+        std::int64_t sum = 0;
+        for (std::size_t k = count; k > 0; k &= k - 1) sum += tree[k];
+        return sum;
+    }
+    // Sum of values [first, last)
+    std::int64_t rangeSum(std::size_t first, std::size_t last) const { return prefixSum(last) - prefixSum(first); }
+    std::int64_t value(std::size_t i) const { return rangeSum(i, i + 1); }
+
+    // Smallest count with prefixSum(count) >= target (size() + 1 when the total
+    // falls short), in one top-down pass over the cells instead of a binary
+    // search of prefix sums. Needs non-negative values. A trace sees each cell
+    // probed as compare(cell - 1, cell - 1).
+    std::size_t lowerBound(std::int64_t target, StepTrace* trace = nullptr) const;
+
+    // Raw cells, tree[0] unused; the visualizer draws them
+    const std::vector<std::int64_t>& cells() const { return tree; }
+
+private:
+    std::vector<std::int64_t> tree;
+};
+
+// Range add and range sum, both O(log n), from two Fenwick trees over the
+// differences d[i] = v[i] - v[i-1]: the sum of the first c values is
+// c * sum(d[i]) - sum(d[i] * i) over i < c. The two trees are interleaved, so
+// each step of an update or query touches one 16-byte cell rather than two arrays.
+class RangeFenwickTree {
+public:
+    RangeFenwickTree() = default;
+    explicit RangeFenwickTree(std::size_t n) : tree(n + 1, Cell{0, 0}) {}
+    explicit RangeFenwickTree(const std::vector<std::int64_t>& values) { build(values); }
+
+    void build(const std::vector<std::int64_t>& values);
+    std::size_t size() const { return tree.empty() ? 0 : tree.size() - 1; }
+
+    // Adds delta to every value in [first, last)
+    void add(std::size_t first, std::size_t last, std::int64_t delta) {
+        addDifference(first, delta);
+        addDifference(last, -delta);
+    }
+    std::int64_t prefixSum(std::size_t count) const {
+        std::int64_t base = 0, scaled = 0;
+        for (std::size_t k = count; k > 0; k &= k - 1) {
+            base += tree[k].base;
+            scaled += tree[k].scaled;
+        }
+        return static_cast<std::int64_t>(count) * base - scaled;
+    }
+    std::int64_t rangeSum(std::size_t first, std::size_t last) const { return prefixSum(last) - prefixSum(first); }
+
+private:
+    struct Cell {
+        std::int64_t base;   // Sum of d[i]
+        std::int64_t scaled; // Sum of d[i] * i
+    };
+    std::vector<Cell> tree;
+
+    void addDifference(std::size_t i, std::int64_t delta) {
+        std::int64_t scaledDelta = delta * static_cast<std::int64_t>(i);
+        for (std::size_t k = i + 1; k < tree.size(); k += k & (0 - k)) {
+            tree[k].base += delta;
+            tree[k].scaled += scaledDelta;
+        }
+    }
+};
@@ -0,0 +1,5 @@
+// data_structures/trees/max_heap.cpp
+#include "max_heap.h"
+
+// See min_heap.cpp
+template class DaryHeap<int, ReverseOrder<std::less<int>>, 4>;
@@ -0,0 +1,15 @@
+// data_structures/trees/max_heap.h
+#pragma once
+#include "dary_heap.h"
+
+// Flips a strict weak order, so the largest element rises to the top
+template <typename Compare>
+struct ReverseOrder {
+    Compare comp;
+    template <typename T>
+    bool operator()(const T& a, const T& b) const { return comp(b, a); }
+};
+
+// Largest element (under Compare) on top
+template <typename T, typename Compare = std::less<T>, unsigned D = 4>
+using MaxHeap = DaryHeap<T, ReverseOrder<Compare>, D>;
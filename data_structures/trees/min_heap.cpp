@@ -0,0 +1,6 @@
+// data_structures/trees/min_heap.cpp
+#include "min_heap.h"
+
+// The heap is header-only; instantiating the common case here makes template
+// errors show up when the library builds rather than at the first user.
+template class DaryHeap<int, std::less<int>, 4>;
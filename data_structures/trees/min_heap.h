@@ -0,0 +1,7 @@
+// data_structures/trees/min_heap.h
+#pragma once
+#include "dary_heap.h"
+
+// Smallest element (under Compare) on top
+template <typename T, typename Compare = std::less<T>, unsigned D = 4>
+using MinHeap = DaryHeap<T, Compare, D>;
@@ -0,0 +1,191 @@
+// data_structures/trees/red_black_tree.cpp
+#include "red_black_tree.h"
+
+using std::vector;
+using std::size_t;
+
+namespace {
+
+// Most keys a 2-3 tree of the given height can hold: 3^height - 1
+std::uint64_t maxKeys23(unsigned height) {
+    std::uint64_t power = 1;
+    for (unsigned i = 0; i < height; ++i) power *= 3;
+    return power - 1;
+}
+
+} // namespace
+
+bool RedBlackTree::insert(int key) {
+    if (pool.full()) return false;
+    bool added = false;
+    rootIndex = insertAt(rootIndex, key, added);
+    setRed(rootIndex, false);
+    return added;
+}
+
+bool RedBlackTree::erase(int key) {
+    if (!contains(key)) return false;
+    // The descent needs the current node or one of its children to be red
+    if (!isRed(pool[rootIndex].left()) && !isRed(pool[rootIndex].right())) setRed(rootIndex, true);
+    rootIndex = eraseAt(rootIndex, key);
+    if (rootIndex != NIL_NODE) setRed(rootIndex, false);
+    return true;
+}
+
+// A rotation hands the old top's color to the new top and turns the old top red
+NodeIndex RedBlackTree::rotateLeftColored(NodeIndex n) {
+    NodeIndex top = rotateLeft(n);
+    setRed(top, isRed(n));
+    setRed(n, true);
+    return top;
+}
+
+NodeIndex RedBlackTree::rotateRightColored(NodeIndex n) {
+    NodeIndex top = rotateRight(n);
+    setRed(top, isRed(n));
+    setRed(n, true);
+    return top;
+}
+
+void RedBlackTree::flipColors(NodeIndex n) {
+    setRed(n, !isRed(n));
+    setRed(pool[n].left(), !isRed(pool[n].left()));
+    setRed(pool[n].right(), !isRed(pool[n].right()));
+}
+
+// Makes n's left child or one of its children red before erase descends left
+NodeIndex RedBlackTree::moveRedLeft(NodeIndex n) {
+    flipColors(n);
+    NodeIndex r = pool[n].right();
+    if (isRed(pool[r].left())) {
+        pool[n].setRight(rotateRightColored(r));
+        n = rotateLeftColored(n);
+        flipColors(n);
+    }
+    return n;
+}
+
+NodeIndex RedBlackTree::moveRedRight(NodeIndex n) {
+    flipColors(n);
+    if (isRed(pool[pool[n].left()].left())) {
+        n = rotateRightColored(n);
+        flipColors(n);
+    }
+    return n;
+}
+
+// Restores left-leaning reds and splits temporary 4-nodes on the way up
+NodeIndex RedBlackTree::fixUp(NodeIndex n) {
+    if (isRed(pool[n].right()) && !isRed(pool[n].left())) n = rotateLeftColored(n);
+    if (isRed(pool[n].left()) && isRed(pool[pool[n].left()].left())) n = rotateRightColored(n);
+    if (isRed(pool[n].left()) && isRed(pool[n].right())) flipColors(n);
+    return n;
+}
+
+NodeIndex RedBlackTree::insertAt(NodeIndex n, int key, bool& added) {
+    if (n == NIL_NODE) {
+        added = true;
+        return pool.allocate(key, RED);
+    }
+    if (key == pool[n].key) return n;
+    // Index the pool again after the call: allocate() may have moved it
+    if (key < pool[n].key) {
+        NodeIndex child = insertAt(pool[n].left(), key, added);
+        pool[n].setLeft(child);
+    } else {
+        NodeIndex child = insertAt(pool[n].right(), key, added);
+        pool[n].setRight(child);
+    }
+    return fixUp(n);
+}
+
+NodeIndex RedBlackTree::eraseMin(NodeIndex n) {
+    if (pool[n].left() == NIL_NODE) {
+        pool.release(n);
+        return NIL_NODE;
+    }
+    if (!isRed(pool[n].left()) && !isRed(pool[pool[n].left()].left())) n = moveRedLeft(n);
+    pool[n].setLeft(eraseMin(pool[n].left()));
+    return fixUp(n);
+}
+
+// Precondition: key is in the subtree
+NodeIndex RedBlackTree::eraseAt(NodeIndex n, int key) {
+    if (key < pool[n].key) {
+        if (!isRed(pool[n].left()) && !isRed(pool[pool[n].left()].left())) n = moveRedLeft(n);
+        pool[n].setLeft(eraseAt(pool[n].left(), key));
+    } else {
+        if (isRed(pool[n].left())) n = rotateRightColored(n);
+        if (key == pool[n].key && pool[n].right() == NIL_NODE) {
+            pool.release(n);
+            return NIL_NODE;
+        }
+        NodeIndex r = pool[n].right();
+        if (!isRed(r) && !isRed(pool[r].left())) n = moveRedRight(n);
+        if (key == pool[n].key) {
+            // Take the successor's key, then remove the successor
+            NodeIndex successor = pool[n].right();
+            while (pool[successor].left() != NIL_NODE) successor = pool[successor].left();
+            pool[n].key = pool[successor].key;
+            pool[n].setRight(eraseMin(pool[n].right()));
+        } else {
+            pool[n].setRight(eraseAt(pool[n].right(), key));
+        }
+    }
+    return fixUp(n);
+}
+
+void RedBlackTree::bulkLoad(const vector<int>& sorted) {
+    vector<int> keys = distinctSorted(sorted);
+    clear();
+    pool.reserve(keys.size());
+    unsigned height = 0;
+    while (maxKeys23(height) < keys.size()) ++height;
+    rootIndex = build23(keys.data(), keys.size(), height);
+    if (rootIndex != NIL_NODE) setRed(rootIndex, false);
+}
+
+// count keys as a 2-3 tree with every leaf at depth height. A 2-3 tree of that
+// height holds between 2^height - 1 and 3^height - 1 keys, so each node takes
+// one key when the rest fits under two children, otherwise two, and the rest is
+// split as evenly as possible. A 2-node is a black node; a 3-node (a, b) is a
+// black b with a red left child a.
+NodeIndex RedBlackTree::build23(const int* first, size_t count, unsigned height) {
+    if (count == 0) return NIL_NODE;
+    std::uint64_t childMax = maxKeys23(height - 1);
+    if (count - 1 <= 2 * childMax) {
+        size_t leftCount = (count - 1) / 2;
+        NodeIndex n = pool.allocate(first[leftCount]);
+        NodeIndex l = build23(first, leftCount, height - 1);
+        NodeIndex r = build23(first + leftCount + 1, count - 1 - leftCount, height - 1);
+        pool[n].setLeft(l);
+        pool[n].setRight(r);
+        return n;
+    }
+    size_t rest = count - 2;
+    size_t c0 = rest / 3, c1 = (rest + 1) / 3, c2 = rest - c0 - c1;
+    NodeIndex b = pool.allocate(first[c0 + 1 + c1]);
+    NodeIndex a = pool.allocate(first[c0], RED);
+    NodeIndex t0 = build23(first, c0, height - 1);
+    NodeIndex t1 = build23(first + c0 + 1, c1, height - 1);
+    NodeIndex t2 = build23(first + c0 + 1 + c1 + 1, c2, height - 1);
+    pool[a].setLeft(t0);
+    pool[a].setRight(t1);
+    pool[b].setLeft(a);
+    pool[b].setRight(t2);
+    return b;
+}
+
+int RedBlackTree::blackHeight() const {
+    if (isRed(rootIndex)) return -1;
+    return blackHeightOf(rootIndex);
+}
+
+int RedBlackTree::blackHeightOf(NodeIndex n) const {
+    if (n == NIL_NODE) return 0;
+    if (isRed(pool[n].right())) return -1; // Reds lean left
+    if (isRed(n) && isRed(pool[n].left())) return -1; // No red node has a red child
+    int l = blackHeightOf(pool[n].left()), r = blackHeightOf(pool[n].right());
+    if (l < 0 || l != r) return -1;
+    return l + (isRed(n) ? 0 : 1);
+}
@@ -0,0 +1,40 @@
+// data_structures/trees/red_black_tree.h
+#pragma once
+#include "binary_search_tree.h"
+#include <cstddef>
+#include <cstdint>
+
+// Left-leaning red-black tree (Sedgewick): a red node is always a left child
+// and glues itself to its parent as one 3-node of a 2-3 tree, so every path
+// from the root down crosses the same number of black nodes and the height
+// stays below 2 log2(n). The color is one bit of the packed meta byte. Insert
+// and erase recurse along one path (at most ~56 levels for a full pool) and
+// restore the invariants on the way back up.
+class RedBlackTree : public BinarySearchTree {
+public:
+    bool insert(int key) override;
+    bool erase(int key) override;
+    // Builds a 2-3 tree of the smallest possible height directly from the
+    // sorted keys in O(n), then reads it as red-black nodes
+    void bulkLoad(const std::vector<int>& sorted) override;
+
+    // Black nodes on every root-to-leaf path, or -1 if the invariants are broken
+    int blackHeight() const;
+
+private:
+    static constexpr std::uint8_t RED = 1;
+
+    bool isRed(NodeIndex n) const { return n != NIL_NODE && (pool[n].meta() & RED); }
+    void setRed(NodeIndex n, bool red) { pool[n].setMeta(red ? RED : 0); }
+    NodeIndex rotateLeftColored(NodeIndex n);
+    NodeIndex rotateRightColored(NodeIndex n);
+    void flipColors(NodeIndex n);
+    NodeIndex moveRedLeft(NodeIndex n);
+    NodeIndex moveRedRight(NodeIndex n);
+    NodeIndex fixUp(NodeIndex n);
+    NodeIndex insertAt(NodeIndex n, int key, bool& added);
+    NodeIndex eraseAt(NodeIndex n, int key);
+    NodeIndex eraseMin(NodeIndex n);
+    NodeIndex build23(const int* first, std::size_t count, unsigned height);
+    int blackHeightOf(NodeIndex n) const;
+};
@@ -0,0 +1,7 @@
+// data_structures/trees/segment_tree.cpp
+#include "segment_tree.h"
+
+// See min_heap.cpp
+template class SegmentTree<SumMonoid>;
+template class SegmentTree<MinMonoid>;
+template class SegmentTree<MaxMonoid>;
@@ -0,0 +1,260 @@
+// data_structures/trees/segment_tree.h
+#pragma once
+#include "../../utilities/step_trace.h"
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+// Monoids for SegmentTree. Besides the associative combine and its identity,
+// each says what adding delta to every one of count elements does to their
+// summary, which is what lets a range update stop at O(log n) covering nodes.
+struct SumMonoid {
+    using Value = std::int64_t;
+    static Value identity() { return 0; }
+    static Value combine(Value a, Value b) { return a + b; }
+    static Value addToAll(Value summary, Value delta, std::size_t count) {
+        return summary + delta * static_cast<Value>(count);
+    }
+};
+
+struct MinMonoid {
+    using Value = std::int64_t;
+    static Value identity() { return std::numeric_limits<Value>::max(); }
+    static Value combine(Value a, Value b) { return std::min(a, b); }
+    static Value addToAll(Value summary, Value delta, std::size_t) { return summary + delta; }
+};
+
+struct MaxMonoid {
+    using Value = std::int64_t;
+    static Value identity() { return std::numeric_limits<Value>::min(); }
+    static Value combine(Value a, Value b) { return std::max(a, b); }
+    static Value addToAll(Value summary, Value delta, std::size_t) { return summary + delta; }
+};
+
+// Half-open range [first, last) of a batched query
+struct RangeQuery {
+    std::size_t first;
+    std::size_t last;
+};
+
+// Iterative segment tree with lazy range add. Nodes live in one array in heap
+// order (root 1, children 2k and 2k+1, leaves from `leaves` on, padded to a
+// power of two), and every operation walks up or down that array in loops:
+// no recursion, no per-node pointers.
+//
+// A range add stops at the O(log n) nodes covering the range and stays there:
+// each node keeps the add owed to its whole subtree next to its summary, and a
+// summary includes the adds of its own subtree but not those of its ancestors.
+// Tags are not pushed down on the way, so an update writes only the covering
+// nodes and the two boundary paths, and a query only reads: it folds bottom-up
+// and picks up each ancestor's add as it climbs.
+template<typename Monoid>
+class SegmentTree {
+public:
+    using Value = typename Monoid::Value;
+
+    SegmentTree() = default;
+    explicit SegmentTree(const std::vector<Value>& values) { build(values); }
+
+    // O(n): leaves first, then each level from the one below
+    void build(const std::vector<Value>& values) {
+        n = values.size();
+        levels = 0;
+        while ((std::size_t(1) << levels) < std::max<std::size_t>(n, 1)) ++levels;
+        leaves = std::size_t(1) << levels;
+        node.assign(2 * leaves, Node{Monoid::identity(), 0});
+        tagsPending = false;
+        for (std::size_t i = 0; i < n; ++i) node[leaves + i].value = values[i];
+        for (std::size_t k = leaves - 1; k > 0; --k) {
+            node[k].value = Monoid::combine(node[2 * k].value, node[2 * k + 1].value);
+        }
+    }
+
+    std::size_t size() const { return n; }
+
+    Value get(std::size_t i) const {
+        std::size_t k = i + leaves;
+        Value value = node[k].value;
+        for (k >>= 1; k > 0; k >>= 1) value = Monoid::addToAll(value, node[k].added, 1);
+        return value;
+    }
+    void set(std::size_t i, Value value) { add(i, i + 1, value - get(i)); }
+
+    // Adds delta to every element of [first, last)
+    void add(std::size_t first, std::size_t last, Value delta) {
+        if (first >= last) return;
+        std::size_t l = first + leaves, r = last + leaves;
+        for (std::size_t count = 1; l < r; l >>= 1, r >>= 1, count <<= 1) {
+            if (l & 1) apply(l++, delta, count);
+            if (r & 1) apply(--r, delta, count);
+        }
+        rebuildPath(first + leaves);
+        rebuildPath(last - 1 + leaves);
+        tagsPending = true;
+    }
+
+    // Combined value of [first, last); the identity for an empty range
+    Value query(std::size_t first, std::size_t last) const {
+        if (first >= last) return Monoid::identity();
+        Fold f = startFold(first, last);
+        while (f.l < f.r) step(f);
+        return finishFold(f);
+    }
+    Value queryAll() const { return node[1].value; }
+
+    // results[q] = query(queries[q].first, queries[q].last) for q < count.
+    // A batch big enough to repay an O(n) sweep first pushes every add down to
+    // the leaves; until the next add() the tree is then plain sums of its
+    // leaves, and each query scans leaves up to the nearest SCAN_BLOCK boundary
+    // and folds the whole blocks between from the small, cache-resident levels
+    // above them. Smaller batches (and the order they come in) go one query at a time.
+    void queryBatch(const RangeQuery* queries, std::size_t count, Value* results) {
+        if (tagsPending && count * PUSH_ALL_RATIO >= leaves) pushAll();
+        for (std::size_t q = 0; q < count; ++q) {
+            results[q] = tagsPending ? query(queries[q].first, queries[q].last)
+                                     : queryPushed(queries[q].first, queries[q].last);
+        }
+    }
+
+    // Smallest count whose prefix [0, count) combines to at least target, or
+    // size() + 1 when even the whole array falls short. Meaningful for
+    // SumMonoid over non-negative values (the depth at which an order book
+    // fills a given quantity). A trace sees each node probed as compare(k - 1, k - 1).
+    std::size_t lowerBound(Value target, StepTrace* trace = nullptr) const {
+        if (target <= 0) return 0;
+        if (node[1].value < target) return n + 1;
+        std::size_t k = 1, count = leaves;
+        Value owed = 0; // Adds of k and its ancestors, which its children's summaries leave out
+        while (k < leaves) {
+            owed += node[k].added;
+            count >>= 1;
+            k <<= 1;
+            if (trace) trace->compare(k - 1, k - 1);
+            Value leftPart = Monoid::addToAll(node[k].value, owed, count);
+            if (leftPart < target) {
+                target -= leftPart;
+                ++k;
+            }
+        }
+        return k - leaves + 1;
+    }
+
+    // Node k's summary in heap order (1 is the root), leaving out its ancestors'
+    // adds; the visualizer draws them
+    Value nodeValue(std::size_t k) const { return node[k].value; }
+    std::size_t nodeCount() const { return node.size(); }
+
+private:
+    // Leaves per block of a pushed-down query, and the level holding the blocks
+    static constexpr unsigned SCAN_LEVELS = 4;
+    static constexpr std::size_t SCAN_BLOCK = std::size_t(1) << SCAN_LEVELS;
+    // queryBatch pushes everything down when count * PUSH_ALL_RATIO >= leaves.
+    // The sweep costs several ns per node and a pushed-down query saves one or
+    // two hundred once the tree is out of cache, so the batch must be a
+    // sizeable fraction of n before the sweep pays.
+    static constexpr std::size_t PUSH_ALL_RATIO = 16;
+
+    struct Node {
+        Value value;
+        Value added; // Owed to every element below; always 0 on leaves
+    };
+
+    // A bottom-up fold in progress. The nodes folded into left all sit under
+    // node l - 1 of the current level, those in right under node r.
+    struct Fold {
+        std::size_t l, r;
+        Value left, right;
+        std::size_t leftCount, rightCount; // Elements folded into each side
+        std::size_t count;                 // Elements under a node of the current level
+    };
+
+    std::size_t n = 0;
+    std::size_t leaves = 1;
+    unsigned levels = 0;
+    std::vector<Node> node;
+    bool tagsPending = false; // Some add() not pushed down since build() or the last pushAll()
+
+    void apply(std::size_t k, Value delta, std::size_t count) {
+        node[k].value = Monoid::addToAll(node[k].value, delta, count);
+        if (k < leaves) node[k].added += delta;
+    }
+    // Recomputes every ancestor of a leaf from its children and its own add
+    void rebuildPath(std::size_t k) {
+        for (std::size_t count = 2; k > 1; count <<= 1) {
+            k >>= 1;
+            Value children = Monoid::combine(node[2 * k].value, node[2 * k + 1].value);
+            node[k].value = Monoid::addToAll(children, node[k].added, count);
+        }
+    }
+
+    // Top-down, so each node has everything owed from above before passing it on
+    void pushAll() {
+        std::size_t childCount = leaves;
+        for (std::size_t levelStart = 1; levelStart < leaves; levelStart <<= 1) {
+            childCount >>= 1;
+            for (std::size_t k = levelStart; k < 2 * levelStart; ++k) {
+                Value delta = node[k].added;
+                if (delta == 0) continue;
+                apply(2 * k, delta, childCount);
+                apply(2 * k + 1, delta, childCount);
+                node[k].added = 0;
+            }
+        }
+        tagsPending = false;
+    }
+    // query() for a tree with no adds left above the leaves
+    Value queryPushed(std::size_t first, std::size_t last) const {
+        if (first >= last) return Monoid::identity();
+        if (levels < SCAN_LEVELS || last - first < 2 * SCAN_BLOCK) return scanLeaves(first, last);
+        std::size_t headEnd = (first + SCAN_BLOCK - 1) & ~(SCAN_BLOCK - 1);
+        std::size_t tailStart = last & ~(SCAN_BLOCK - 1);
+        std::size_t blocks = leaves >> SCAN_LEVELS; // Index of the first block node
+        Value middle = Monoid::identity(), right = Monoid::identity();
+        for (std::size_t l = blocks + headEnd / SCAN_BLOCK, r = blocks + tailStart / SCAN_BLOCK; l < r; l >>= 1, r >>= 1) {
+            if (l & 1) middle = Monoid::combine(middle, node[l++].value);
+            if (r & 1) right = Monoid::combine(node[--r].value, right);
+        }
+        Value head = Monoid::combine(scanLeaves(first, headEnd), Monoid::combine(middle, right));
+        return Monoid::combine(head, scanLeaves(tailStart, last));
+    }
+    Value scanLeaves(std::size_t first, std::size_t last) const {
+        Value acc = Monoid::identity();
+        for (const Node* leaf = node.data() + leaves + first, *end = node.data() + leaves + last; leaf < end; ++leaf) {
+            acc = Monoid::combine(acc, leaf->value);
+        }
+        return acc;
+    }
+
+    Fold startFold(std::size_t first, std::size_t last) const {
+        return Fold{first + leaves, last + leaves, Monoid::identity(), Monoid::identity(), 0, 0, 1};
+    }
+    // Folds this level's boundary nodes, climbs one level and charges each side
+    // the add of the node it now sits under
+    void step(Fold& f) const {
+        if (f.l & 1) {
+            f.left = Monoid::combine(f.left, node[f.l++].value);
+            f.leftCount += f.count;
+        }
+        if (f.r & 1) {
+            f.right = Monoid::combine(node[--f.r].value, f.right);
+            f.rightCount += f.count;
+        }
+        f.l >>= 1;
+        f.r >>= 1;
+        f.count <<= 1;
+        if (f.leftCount) f.left = Monoid::addToAll(f.left, node[f.l - 1].added, f.leftCount);
+        if (f.rightCount) f.right = Monoid::addToAll(f.right, node[f.r].added, f.rightCount);
+    }
+    // Above the point where the two sides met, each still owes its remaining ancestors' adds
+    Value finishFold(Fold& f) const {
+        if (f.leftCount) {
+            for (std::size_t k = (f.l - 1) >> 1; k > 0; k >>= 1) f.left = Monoid::addToAll(f.left, node[k].added, f.leftCount);
+        }
+        if (f.rightCount) {
+            for (std::size_t k = f.r >> 1; k > 0; k >>= 1) f.right = Monoid::addToAll(f.right, node[k].added, f.rightCount);
+        }
+        return Monoid::combine(f.left, f.right);
+    }
+};
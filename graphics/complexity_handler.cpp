@@ -35,12 +35,16 @@ void ComplexityHandler::initializeComplexities() {
     complexitiesMap[Algorithm::Kruskal] = {"O(E log E)", "O(V+E)"};
     complexitiesMap[Algorithm::Prim] = {"O(E log V)", "O(V+E)"};
 
-    complexitiesMap[Algorithm::InOrder] = {"O(n)", "O(h)"};
-    complexitiesMap[Algorithm::PostOrder] = {"O(n)", "O(h)"};
-    complexitiesMap[Algorithm::PreOrder] = {"O(n)", "O(h)"};
+    complexitiesMap[Algorithm::InOrder] = {"O(n)", "O(h), Morris O(1)"};
+    complexitiesMap[Algorithm::PostOrder] = {"O(n)", "O(h), Morris O(1)"};
+    complexitiesMap[Algorithm::PreOrder] = {"O(n)", "O(h), Morris O(1)"};
 
     complexitiesMap[Algorithm::HuffmanEncoding] = {"O(n log n)", "O(n)"};
     complexitiesMap[Algorithm::None] = {"N/A", "N/A"};
+
+    // Finer bounds than the plotted classes, shown as a note under them
+    detailsMap.clear();
+    detailsMap[Algorithm::HuffmanEncoding] = "n bytes, k symbols: O(n + k log k) time, O(k) space";
 }
 
 // Return type uses std::pair
@@ -52,3 +56,35 @@ std::pair<string, string> ComplexityHandler::getComplexity(Algorithm alg) const
     }
     return {"N/A", "N/A"};
 }
+
+string ComplexityHandler::getComplexityDetail(Algorithm alg) const {
+    auto it = detailsMap.find(alg);
+    return it != detailsMap.end() ? it->second : "";
+}
+
+void ComplexityHandler::setEmpiricalMode(bool enabled) {
+    empiricalMode = enabled;
+    if (!enabled) profiler.stop(); // Don't keep a core busy measuring nobody is looking at
+}
+
+bool ComplexityHandler::isEmpiricalMode() const {
+    return empiricalMode;
+}
+
+const EmpiricalResult& ComplexityHandler::getEmpiricalResult(Algorithm alg) {
+    profiler.request(alg);
+    std::uint64_t latest = profiler.getVersion();
+    if (latest != empiricalVersion) {
+        empiricalResult = profiler.snapshot();
+        empiricalVersion = latest;
+    }
+    return empiricalResult;
+}
+
+std::uint64_t ComplexityHandler::getEmpiricalVersion() const {
+    return profiler.getVersion();
+}
+
+bool ComplexityHandler::isMeasuring() const {
+    return profiler.isRunning();
+}
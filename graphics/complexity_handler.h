@@ -1,6 +1,7 @@
 // graphics/complexity_handler.h
 #pragma once
 #include "../utilities/types.h" // Includes global enums
+#include "empirical_profiler.h"
 #include <string>
 #include <utility> // For std::pair
 #include <map>
@@ -11,8 +12,24 @@ class ComplexityHandler {
 public:
     ComplexityHandler();
     std::pair<std::string, std::string> getComplexity(Algorithm alg) const;
+    // Tighter bound than the plotted class, or "" when there is none
+    std::string getComplexityDetail(Algorithm alg) const;
+
+    // Empirical mode: measured runtime/space curves next to the static table
+    void setEmpiricalMode(bool enabled);
+    bool isEmpiricalMode() const;
+    // Starts measuring alg if needed; the returned copy is refreshed only when new samples land
+    const EmpiricalResult& getEmpiricalResult(Algorithm alg);
+    std::uint64_t getEmpiricalVersion() const;
+    bool isMeasuring() const;
 
 private:
     std::map<Algorithm, std::pair<std::string, std::string>> complexitiesMap; // Renamed to avoid conflict
+    std::map<Algorithm, std::string> detailsMap;
     void initializeComplexities();
+
+    bool empiricalMode = false;
+    EmpiricalProfiler profiler;
+    EmpiricalResult empiricalResult;
+    std::uint64_t empiricalVersion = 0;
 };
@@ -0,0 +1,108 @@
+// graphics/empirical_profiler.cpp
+#include "empirical_profiler.h"
+#include "../algorithms/workloads.h"
+#include "../utilities/alloc_tracker.h"
+#include <algorithm>
+#include <chrono>
+
+using std::vector;
+using std::size_t;
+
+EmpiricalProfiler::~EmpiricalProfiler() {
+    stop();
+}
+
+void EmpiricalProfiler::stop() {
+    cancelRequested = true;
+    if (worker.joinable()) worker.join();
+    cancelRequested = false;
+}
+
+void EmpiricalProfiler::request(Algorithm alg) {
+    if (alg == requested && worker.joinable()) return;
+    stop();
+    requested = alg;
+    {
+        std::lock_guard<std::mutex> lock(resultMutex);
+        result = EmpiricalResult();
+        result.alg = alg;
+    }
+    version.fetch_add(1, std::memory_order_release);
+    running = true;
+    worker = std::thread(&EmpiricalProfiler::measure, this, alg);
+}
+
+EmpiricalResult EmpiricalProfiler::snapshot() const {
+    std::lock_guard<std::mutex> lock(resultMutex);
+    return result;
+}
+
+void EmpiricalProfiler::measure(Algorithm alg) {
+    using Clock = std::chrono::steady_clock;
+    std::unique_ptr<Workload> workload = makeWorkload(alg);
+    if (!workload) {
+        std::lock_guard<std::mutex> lock(resultMutex);
+        result.complete = true;
+        version.fetch_add(1, std::memory_order_release); // Before running drops, see GUI::isMeasuring
+        running = false;
+        return;
+    }
+    {
+        std::lock_guard<std::mutex> lock(resultMutex);
+        result.supported = true;
+    }
+
+    size_t largest = std::min(MAX_N, workload->maxSize());
+    for (size_t n = MIN_N; n <= largest && !cancelRequested; n *= 2) {
+        Clock::time_point sizeStart = Clock::now();
+        WorkloadSpec spec;
+        spec.n = n;
+        spec.seed = static_cast<uint32_t>(n);
+        workload->prepare(spec);
+
+        for (int i = 0; i < WARMUP_RUNS; ++i) {
+            workload->reset();
+            workload->run(nullptr);
+        }
+        vector<double> times;
+        for (int i = 0; i < REPETITIONS && !cancelRequested; ++i) {
+            workload->reset();
+            Clock::time_point start = Clock::now();
+            workload->run(nullptr);
+            times.push_back(std::chrono::duration<double, std::micro>(Clock::now() - start).count());
+        }
+        if (cancelRequested) break;
+        std::nth_element(times.begin(), times.begin() + times.size() / 2, times.end());
+        double median = times[times.size() / 2];
+
+        // Counters and heap use come from one extra, untimed run
+        StepTrace counters(false);
+        workload->reset();
+        AllocationStats heap;
+        {
+            AllocationScope scope;
+            workload->run(&counters);
+            heap = scope.stats();
+        }
+
+        {
+            std::lock_guard<std::mutex> lock(resultMutex);
+            result.ns.push_back(static_cast<double>(n));
+            result.microsPerRun.push_back(median);
+            result.peakBytes.push_back(static_cast<double>(heap.peakBytes));
+            result.comparisons.push_back(static_cast<double>(counters.getComparisons()));
+            result.swaps.push_back(static_cast<double>(counters.getSwaps()));
+            result.timeFit = fitComplexity(result.ns, result.microsPerRun);
+            result.spaceFit = fitComplexity(result.ns, result.peakBytes);
+        }
+        version.fetch_add(1, std::memory_order_release);
+
+        double sizeMs = std::chrono::duration<double, std::milli>(Clock::now() - sizeStart).count();
+        if (sizeMs > SIZE_BUDGET_MS) break;
+    }
+
+    std::lock_guard<std::mutex> lock(resultMutex);
+    result.complete = !cancelRequested;
+    version.fetch_add(1, std::memory_order_release); // Before running drops, see GUI::isMeasuring
+    running = false;
+}
@@ -0,0 +1,58 @@
+// graphics/empirical_profiler.h
+#pragma once
+#include "../utilities/types.h"
+#include <atomic>
+#include <cstdint>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// Measured counterpart of the static Big-O table: runs the real algorithm
+// over doubling n on a background thread and fits a complexity class.
+// Samples are stored as parallel arrays so the GUI can plot them directly.
+struct EmpiricalResult {
+    Algorithm alg = Algorithm::None;
+    bool supported = false;   // False when the algorithm has no headless workload
+    bool complete = false;
+    std::vector<double> ns;
+    std::vector<double> microsPerRun; // Median wall time of the timed repetitions
+    std::vector<double> peakBytes;    // Peak live heap bytes during one run
+    std::vector<double> comparisons;
+    std::vector<double> swaps;
+    ComplexityClass timeFit = ComplexityClass::Unknown;
+    ComplexityClass spaceFit = ComplexityClass::Unknown;
+};
+
+class EmpiricalProfiler {
+public:
+    EmpiricalProfiler() = default;
+    ~EmpiricalProfiler();
+    EmpiricalProfiler(const EmpiricalProfiler&) = delete;
+    EmpiricalProfiler& operator=(const EmpiricalProfiler&) = delete;
+
+    // Starts measuring alg, cancelling any measurement of a different algorithm
+    void request(Algorithm alg);
+    void stop();
+
+    // Bumped whenever new samples land, so readers can skip unchanged snapshots
+    std::uint64_t getVersion() const { return version.load(std::memory_order_acquire); }
+    EmpiricalResult snapshot() const;
+    bool isRunning() const { return running.load(std::memory_order_acquire); }
+
+private:
+    const int WARMUP_RUNS = 1;
+    const int REPETITIONS = 5;
+    const double SIZE_BUDGET_MS = 250.0; // Stop growing n once one size costs this much
+    const std::size_t MIN_N = 16;
+    const std::size_t MAX_N = std::size_t(1) << 20;
+
+    std::thread worker;
+    std::atomic<bool> cancelRequested{false};
+    std::atomic<std::uint64_t> version{0};
+    std::atomic<bool> running{false};
+    mutable std::mutex resultMutex;
+    EmpiricalResult result;
+    Algorithm requested = Algorithm::None;
+
+    void measure(Algorithm alg);
+};
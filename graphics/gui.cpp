@@ -21,6 +21,7 @@ GUI::GUI(sf::RenderWindow& win_, Renderer& r_,
 
     populateAlgorithmCheckboxes();
     updateSliderKnobPositionFromSpeed();
+    createPaneTextures();
 }
 
 void GUI::initializeLayout(unsigned int windowWidth, unsigned int windowHeight) {
@@ -72,6 +73,9 @@ void GUI::initializeLayout(unsigned int windowWidth, unsigned int windowHeight)
                                 complexityPaneRect.width - 2 * PADDING,
                                 max(60.f, availableGraphHeight)};
 
+    empiricalToggleRect = {complexityPaneRect.left + complexityPaneRect.width - 105.f, complexityPaneRect.top + 6.f,
+                           95.f, CHECKBOX_ITEM_HEIGHT};
+
     algListVisibleHeight = algorithmPaneRect.height - TITLE_AREA_HEIGHT - PADDING;
     algScrollbarBack.setSize({12.f, algListVisibleHeight}); // Slightly wider scrollbar
     algScrollbarBack.setFillColor(Renderer::SECONDARY_UI_COLOR);
@@ -97,8 +101,7 @@ void GUI::populateDSCheckboxes() {
         if (displayedNames.find(name) == displayedNames.end() || name == ARRAY_VECTOR_DISPLAY_NAME) {
              if (name == ARRAY_VECTOR_DISPLAY_NAME && displayedNames.count(name)) continue;
             displayedNames.insert(name);
-            sf::Text tempText(name, appFont, CHECKBOX_FONT_SIZE);
-            float textWidth = tempText.getLocalBounds().width;
+            float textWidth = renderer.measureText(name, CHECKBOX_FONT_SIZE).width;
             float itemWidth = CHECKBOX_SQUARE_SIZE + CHECKBOX_TEXT_OFFSET_X + textWidth + PADDING * 1.8f; // Increased item padding
             itemWidth = max(itemWidth, DS_ITEM_MIN_WIDTH);
             dsCheckboxItems.push_back({
@@ -117,8 +120,7 @@ void GUI::layoutDSCheckboxes() {
     float currentX = topBarRect.left + PADDING - dsListScrollOffset;
 
     for (CheckboxUIData& cb : dsCheckboxItems) {
-        sf::Text tempText(cb.label, appFont, CHECKBOX_FONT_SIZE);
-        float textWidth = tempText.getLocalBounds().width;
+        float textWidth = renderer.measureText(cb.label, CHECKBOX_FONT_SIZE).width;
         float itemWidth = CHECKBOX_SQUARE_SIZE + CHECKBOX_TEXT_OFFSET_X + textWidth + PADDING * 1.8f;
         itemWidth = max(itemWidth, DS_ITEM_MIN_WIDTH);
 
@@ -227,7 +229,13 @@ void GUI::updateSpeedFromSliderKnobPosition() {
 }
 
 void GUI::handleEvent(const sf::Event& e) {
+    sf::Vector2f previousMousePos = mousePos;
     mousePos = static_cast<sf::Vector2f>(sf::Mouse::getPosition(window));
+    if (e.type == sf::Event::MouseMoved || e.type == sf::Event::MouseWheelScrolled) {
+        markHoverDirty(previousMousePos, mousePos);
+    } else {
+        markAllDirty(); // Clicks, resizes, focus changes: rare enough to just redraw everything
+    }
 
     if (e.type == sf::Event::MouseButtonPressed) {
         if (e.mouseButton.button == sf::Mouse::Left) {
@@ -239,6 +247,10 @@ void GUI::handleEvent(const sf::Event& e) {
                     return;
                 }
             }
+            if (empiricalToggleRect.contains(mousePos)) {
+                compHandler.setEmpiricalMode(!compHandler.isEmpiricalMode());
+                return;
+            }
             // DS Slider Drag Start
             sf::FloatRect dsSliderKnobRect = {dsSliderKnobX, dsSliderTrackRect.top, dsSliderKnobWidth, dsSliderTrackRect.height * DS_SLIDER_KNOB_HEIGHT_FACTOR};
             if (dsSliderTrackRect.contains(mousePos) || dsSliderKnobRect.contains(mousePos)) { // Click on track or knob
@@ -293,6 +305,7 @@ void GUI::handleEvent(const sf::Event& e) {
                  dsListScrollOffset = clickRatio * (dsListTotalWidth - dsListVisibleWidth);
                  updateDSSliderKnobPositionFromScrollOffset(); // This updates dsSliderKnobX
                  layoutDSCheckboxes(); // Update checkbox positions
+                 markDirty(Pane::TopBar);
             }
         }
         else if (isDraggingSpeedSlider) { /* ... same as before ... */ 
@@ -300,6 +313,7 @@ void GUI::handleEvent(const sf::Event& e) {
             float maxXTrack = speedSliderPaneRect.left + speedSliderPaneRect.width - PADDING - 10.f;
             speedSliderKnobX = std::clamp(mousePos.x, minXTrack, maxXTrack);
             updateSpeedFromSliderKnobPosition();
+            markDirty(Pane::Speed);
         }
         else if (isDraggingAlgScrollbar) { /* ... same as before ... */ 
             float mouseYRelToScrollbarBack = mousePos.y - algScrollbarBack.getPosition().y;
@@ -308,6 +322,7 @@ void GUI::handleEvent(const sf::Event& e) {
             float maxScroll = algListTotalHeight - algListVisibleHeight;
             algListScrollOffset = thumbRatio * max(0.f, maxScroll);
             layoutAlgorithmCheckboxes();
+            markDirty(Pane::Algorithms);
         }
     }
     if (e.type == sf::Event::MouseWheelScrolled) {
@@ -327,11 +342,108 @@ void GUI::handleEvent(const sf::Event& e) {
 }
 
 void GUI::draw() {
+    // Panes that change without input: trace playback and background measurements
+    if (visHandler.hasPendingChanges() || visHandler.getCurrentAlgorithm() != lastDrawnAlgorithm) markDirty(Pane::Visualization);
+    // One read: samples landing after it are caught by the next needsRedraw()
+    std::uint64_t empiricalVersion = compHandler.getEmpiricalVersion();
+    if (compHandler.isEmpiricalMode() && empiricalVersion != lastDrawnEmpiricalVersion) markDirty(Pane::Complexity);
+    lastDrawnAlgorithm = visHandler.getCurrentAlgorithm();
+    lastDrawnEmpiricalVersion = empiricalVersion;
+
+    for (int i = 0; i < PANE_COUNT; ++i) {
+        Pane pane = static_cast<Pane>(i);
+        if (!paneCacheReady) { // No render-texture support: draw straight to the window every frame
+            drawPane(pane);
+            continue;
+        }
+        if (paneDirty[i]) {
+            sf::RenderTexture& tex = paneTextures[i];
+            tex.setView(sf::View(paneCacheArea(pane)));
+            tex.clear(Renderer::BACKGROUND_COLOR);
+            renderer.setTarget(tex);
+            drawPane(pane);
+            renderer.resetTarget();
+            tex.display();
+            paneDirty[i] = false;
+        }
+        sf::FloatRect area = paneCacheArea(pane);
+        sf::Sprite sprite(paneTextures[i].getTexture());
+        sprite.setPosition(area.left, area.top);
+        window.draw(sprite);
+    }
+}
+
+bool GUI::needsRedraw() const {
+    for (bool dirty : paneDirty) if (dirty) return true;
+    if (visHandler.isAnimating()) return true;
+    return compHandler.isEmpiricalMode() && compHandler.getEmpiricalVersion() != lastDrawnEmpiricalVersion;
+}
+
+// The profiler bumps its version before it stops running, so reading this
+// before needsRedraw() can't miss the last samples
+bool GUI::isMeasuring() const {
+    return compHandler.isEmpiricalMode() && compHandler.isMeasuring();
+}
+
+void GUI::markDirty(Pane pane) {
+    paneDirty[static_cast<int>(pane)] = true;
+}
+
+void GUI::markAllDirty() {
+    for (bool& dirty : paneDirty) dirty = true;
+}
+
+sf::FloatRect GUI::paneRect(Pane pane) const {
+    switch (pane) {
+        case Pane::TopBar: return topBarRect;
+        case Pane::Algorithms: return algorithmPaneRect;
+        case Pane::Speed: return speedSliderPaneRect;
+        case Pane::Complexity: return complexityPaneRect;
+        case Pane::Visualization: return visualizationPaneRect;
+    }
+    return {};
+}
+
+// Pane rect grown by a couple of pixels so panel outlines land inside the cached texture
+sf::FloatRect GUI::paneCacheArea(Pane pane) const {
+    sf::FloatRect r = paneRect(pane);
+    return {std::floor(r.left) - 2.f, std::floor(r.top) - 2.f, std::ceil(r.width) + 4.f, std::ceil(r.height) + 4.f};
+}
+
+void GUI::createPaneTextures() {
+    paneCacheReady = true;
+    for (int i = 0; i < PANE_COUNT; ++i) {
+        sf::FloatRect area = paneCacheArea(static_cast<Pane>(i));
+        if (!paneTextures[i].create(static_cast<unsigned>(area.width), static_cast<unsigned>(area.height))) {
+            paneCacheReady = false;
+        }
+    }
+    markAllDirty();
+}
+
+// Marks whichever panes the mouse entered or left so hover highlights stay correct
+void GUI::markHoverDirty(const sf::Vector2f& oldPos, const sf::Vector2f& newPos) {
+    for (int i = 0; i < PANE_COUNT; ++i) {
+        sf::FloatRect r = paneRect(static_cast<Pane>(i));
+        if (r.contains(oldPos) || r.contains(newPos)) paneDirty[i] = true;
+    }
+}
+
+void GUI::drawPane(Pane pane) {
+    switch (pane) {
+        case Pane::TopBar: drawTopBarPane(); break;
+        case Pane::Algorithms: drawAlgorithmPane(); break;
+        case Pane::Speed: drawSpeedPane(); break;
+        case Pane::Complexity:
+            renderer.drawPanel(complexityPaneRect, "Complexity Analysis", 16);
+            drawComplexityGraphs();
+            break;
+        case Pane::Visualization: drawVisualizationPane(); break;
+    }
+}
+
+void GUI::drawTopBarPane() {
     renderer.drawPanel(topBarRect, "Data Structure", 18);
-    renderer.drawPanel(visualizationPaneRect, "Visualization", 18);
-    renderer.drawPanel(algorithmPaneRect, "Algorithms", 16);
-    renderer.drawPanel(speedSliderPaneRect, "Speed", 16);
-    renderer.drawPanel(complexityPaneRect, "Complexity Analysis", 16);
 
     // Draw DS Checkboxes (clipped by visibility logic)
     for (const auto& cb : dsCheckboxItems) {
@@ -365,7 +477,10 @@ void GUI::draw() {
     if (dsListTotalWidth > dsListVisibleWidth) {
         renderer.drawHorizontalSlider(dsSliderTrackRect, dsSliderKnobX, dsSliderKnobWidth, dsSliderTrackRect.height * DS_SLIDER_KNOB_HEIGHT_FACTOR);
     }
+}
 
+void GUI::drawAlgorithmPane() {
+    renderer.drawPanel(algorithmPaneRect, "Algorithms", 16);
 
     // Draw Algorithm Checkboxes & Scrollbar (same as before, with minor style consistency)
     if (algCheckboxItems.empty()) { /* ... */ 
@@ -382,8 +497,12 @@ void GUI::draw() {
         }
     }
     if (algListTotalHeight > algListVisibleHeight && !algCheckboxItems.empty()) { /* ... */ 
-        window.draw(algScrollbarBack); window.draw(algScrollbarThumb);
+        renderer.getTarget().draw(algScrollbarBack); renderer.getTarget().draw(algScrollbarThumb);
     }
+}
+
+void GUI::drawSpeedPane() {
+    renderer.drawPanel(speedSliderPaneRect, "Speed", 16);
 
     // Draw Speed Slider (label within panel)
     // renderer.drawText("Speed:", {speedSliderPaneRect.left + PADDING, speedSliderPaneRect.top + TITLE_AREA_HEIGHT - 20.f}, 14, Renderer::TEXT_COLOR);
@@ -391,15 +510,10 @@ void GUI::draw() {
     float sliderTrackWidth = speedSliderPaneRect.width - 2 * (PADDING + 10.f);
     sf::FloatRect sliderActualTrack = {speedSliderPaneRect.left + PADDING + 10.f, sliderTrackY, sliderTrackWidth, 0.f};
     renderer.drawSlider(sliderActualTrack, speedSliderKnobX, 9.f); // Slightly larger knob
-    
-    // Draw Complexity Info & Graphs
-    std::pair<string, string> complexity = compHandler.getComplexity(visHandler.getCurrentAlgorithm());
-    renderer.drawFunctionGraph(timeComplexityGraphRect, complexity.first, Renderer::COMPLEXITY_TIME_COLOR, "Time");
-    renderer.drawFunctionGraph(spaceComplexityGraphRect, complexity.second, Renderer::COMPLEXITY_SPACE_COLOR, "Space");
-    
-    float textComplexityY = spaceComplexityGraphRect.top + spaceComplexityGraphRect.height + PADDING / 2.f;
-    renderer.drawText("Time: " + complexity.first, {complexityPaneRect.left + PADDING, textComplexityY}, 14, Renderer::TEXT_COLOR);
-    renderer.drawText("Space: " + complexity.second, {complexityPaneRect.left + PADDING, textComplexityY + 18.f}, 14, Renderer::TEXT_COLOR);
+}
+
+void GUI::drawVisualizationPane() {
+    renderer.drawPanel(visualizationPaneRect, "Visualization", 18);
 
     // Visualization Pane Content (same as before)
     if (visHandler.getCurrentAlgorithm() == Algorithm::None && !algCheckboxItems.empty()) { /* ... */ 
@@ -407,7 +521,11 @@ void GUI::draw() {
     } else { /* ... */ 
         sf::FloatRect actualVizArea = {visualizationPaneRect.left + PADDING/2.f, visualizationPaneRect.top + TITLE_AREA_HEIGHT - PADDING/2.f,
                                    visualizationPaneRect.width - PADDING, visualizationPaneRect.height - TITLE_AREA_HEIGHT + PADDING/2.f};
-        visHandler.drawCurrentVisualization(renderer, actualVizArea);
+        if (visHandler.hasVisualization()) {
+            visHandler.drawCurrentVisualization(renderer, actualVizArea);
+            renderer.drawDynamicText(visHandler.getPlaybackStatus(), {visualizationPaneRect.left + 150.f, visualizationPaneRect.top + 10.f}, 13, Renderer::TEXT_MUTED_COLOR);
+            return;
+        }
         string dsName = visHandler.getCurrentDataStructureDisplayName();
         string algName = (visHandler.getCurrentAlgorithm() != Algorithm::None && static_cast<size_t>(visHandler.getCurrentAlgorithm()) < ALGORITHM_NAMES.size()) ? ALGORITHM_NAMES[static_cast<int>(visHandler.getCurrentAlgorithm())] : "";
         string vizText = dsName;
@@ -417,3 +535,44 @@ void GUI::draw() {
         renderer.drawTextCentered(actualVizArea, vizText, 20, Renderer::TEXT_MUTED_COLOR);
     }
 }
+
+void GUI::drawComplexityGraphs() {
+    renderer.drawCheckbox(empiricalToggleRect, "Measured", compHandler.isEmpiricalMode(), empiricalToggleRect.contains(mousePos),
+                          14.f, 14.f + 6.f, 13);
+
+    Algorithm alg = visHandler.getCurrentAlgorithm();
+    std::pair<string, string> complexity = compHandler.getComplexity(alg);
+    float textComplexityY = spaceComplexityGraphRect.top + spaceComplexityGraphRect.height + PADDING / 2.f;
+
+    if (compHandler.isEmpiricalMode() && alg != Algorithm::None) {
+        const EmpiricalResult& measured = compHandler.getEmpiricalResult(alg);
+        if (measured.supported) {
+            string status = measured.complete ? "" : " ...";
+            renderer.drawMeasuredGraph(timeComplexityGraphRect, measured.ns, measured.microsPerRun, complexity.first,
+                                       Renderer::COMPLEXITY_TIME_COLOR, "Time (us)" + status);
+            renderer.drawMeasuredGraph(spaceComplexityGraphRect, measured.ns, measured.peakBytes, complexity.second,
+                                       Renderer::COMPLEXITY_SPACE_COLOR, "Peak heap (bytes)" + status);
+
+            renderer.drawText("Time: " + complexity.first + "  measured " + complexityNotation(measured.timeFit),
+                              {complexityPaneRect.left + PADDING, textComplexityY}, 14, Renderer::TEXT_COLOR);
+            renderer.drawText("Space: " + complexity.second + "  measured " + complexityNotation(measured.spaceFit),
+                              {complexityPaneRect.left + PADDING, textComplexityY + 18.f}, 14, Renderer::TEXT_COLOR);
+            if (!measured.ns.empty()) {
+                size_t last = measured.ns.size() - 1;
+                string counts = "n=" + std::to_string(static_cast<long long>(measured.ns[last])) +
+                                ": " + std::to_string(static_cast<long long>(measured.comparisons[last])) + " cmp, " +
+                                std::to_string(static_cast<long long>(measured.swaps[last])) + " swaps";
+                renderer.drawDynamicText(counts, {complexityPaneRect.left + PADDING, textComplexityY + 35.f}, 12, Renderer::TEXT_MUTED_COLOR);
+            }
+            return;
+        }
+    }
+
+    renderer.drawFunctionGraph(timeComplexityGraphRect, complexity.first, Renderer::COMPLEXITY_TIME_COLOR, "Time");
+    renderer.drawFunctionGraph(spaceComplexityGraphRect, complexity.second, Renderer::COMPLEXITY_SPACE_COLOR, "Space");
+
+    renderer.drawText("Time: " + complexity.first, {complexityPaneRect.left + PADDING, textComplexityY}, 14, Renderer::TEXT_COLOR);
+    renderer.drawText("Space: " + complexity.second, {complexityPaneRect.left + PADDING, textComplexityY + 18.f}, 14, Renderer::TEXT_COLOR);
+    string detail = compHandler.getComplexityDetail(alg);
+    if (!detail.empty()) renderer.drawText(detail, {complexityPaneRect.left + PADDING, textComplexityY + 35.f}, 12, Renderer::TEXT_MUTED_COLOR);
+}
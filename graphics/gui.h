@@ -16,6 +16,10 @@ public:
 
     void handleEvent(const sf::Event& e);
     void draw();
+    // False when every pane is cached and nothing animates, so the app can block on events
+    bool needsRedraw() const;
+    // Background measurement running: new samples can arrive without any input
+    bool isMeasuring() const;
 
 private:
     sf::RenderWindow& window;
@@ -44,6 +48,7 @@ private:
     sf::FloatRect complexityPaneRect;
     sf::FloatRect timeComplexityGraphRect;
     sf::FloatRect spaceComplexityGraphRect;
+    sf::FloatRect empiricalToggleRect; // "Measured" checkbox in the complexity pane title row
 
     // DS Top Bar Slider
     float dsListScrollOffset = 0.f;
@@ -90,4 +95,28 @@ private:
     // New methods for DS Slider
     void updateDSSliderKnobPositionFromScrollOffset();
     void updateDSScrollOffsetFromSliderKnobPosition();
+
+    // Dirty-region rendering: each pane is rendered into its own texture and
+    // only re-rendered when input, playback or measurements change it
+    enum class Pane { TopBar, Algorithms, Speed, Complexity, Visualization };
+    static const int PANE_COUNT = 5;
+    sf::RenderTexture paneTextures[PANE_COUNT];
+    bool paneDirty[PANE_COUNT] = {true, true, true, true, true};
+    bool paneCacheReady = false;
+    Algorithm lastDrawnAlgorithm = Algorithm::None;
+    std::uint64_t lastDrawnEmpiricalVersion = 0;
+
+    void createPaneTextures();
+    void markDirty(Pane pane);
+    void markAllDirty();
+    void markHoverDirty(const sf::Vector2f& oldPos, const sf::Vector2f& newPos);
+    sf::FloatRect paneRect(Pane pane) const;
+    sf::FloatRect paneCacheArea(Pane pane) const;
+
+    void drawPane(Pane pane);
+    void drawTopBarPane();
+    void drawAlgorithmPane();
+    void drawSpeedPane();
+    void drawVisualizationPane();
+    void drawComplexityGraphs();
 };
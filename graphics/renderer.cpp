@@ -29,9 +29,41 @@ const sf::Color Renderer::GRAPH_BORDER_COLOR = sf::Color(60, 60, 68);
 const sf::Color Renderer::AXIS_COLOR = sf::Color(130, 130, 140);
 const sf::Color Renderer::COMPLEXITY_TIME_COLOR = sf::Color(70, 150, 255);
 const sf::Color Renderer::COMPLEXITY_SPACE_COLOR = sf::Color(255, 99, 71);
+const sf::Color Renderer::ARRAY_BAR_COLOR = sf::Color(120, 120, 135);       // Idle bars
+const sf::Color Renderer::ARRAY_COMPARE_COLOR = sf::Color(255, 204, 0);     // Being compared
+const sf::Color Renderer::ARRAY_SWAP_COLOR = sf::Color(255, 99, 71);        // Swapped / written
+const sf::Color Renderer::ARRAY_RANGE_COLOR = Renderer::ACCENT_COLOR;       // Active sub-range bounds
+const sf::Color Renderer::ARRAY_SORTED_COLOR = sf::Color(52, 199, 89);      // Final sorted state
+const sf::Color Renderer::THEORY_CURVE_COLOR = sf::Color(160, 160, 170, 160); // Fitted Big-O under measured data
+const sf::Color Renderer::GRAPH_EDGE_COLOR = sf::Color(80, 80, 90);         // Unused edges
+const sf::Color Renderer::GRAPH_TREE_EDGE_COLOR = Renderer::ACCENT_COLOR;   // Edge a vertex was reached through
+const sf::Color Renderer::GRAPH_FRONTIER_COLOR = sf::Color(255, 204, 0);    // Current BFS level
+const sf::Color Renderer::GRAPH_VISITED_COLOR = sf::Color(50, 152, 255);    // Reached earlier
 
+sf::Color Renderer::workerColor(unsigned worker) {
+    static const sf::Color PALETTE[] = {
+        ARRAY_SWAP_COLOR, sf::Color(50, 152, 255), sf::Color(175, 82, 222), sf::Color(48, 209, 198),
+        sf::Color(255, 149, 0), sf::Color(255, 55, 135), sf::Color(140, 200, 60), sf::Color(200, 160, 120)
+    };
+    return PALETTE[worker % (sizeof(PALETTE) / sizeof(PALETTE[0]))];
+}
+
+
+Renderer::Renderer(sf::RenderWindow& w, sf::Font& f) : window(w), target(&w), font(f) {
+    dynamicText.setFont(font);
+}
 
-Renderer::Renderer(sf::RenderWindow& w, sf::Font& f) : window(w), font(f) {}
+void Renderer::setTarget(sf::RenderTarget& t) {
+    target = &t;
+}
+
+void Renderer::resetTarget() {
+    target = &window;
+}
+
+sf::RenderTarget& Renderer::getTarget() {
+    return *target;
+}
 
 void Renderer::drawStyledRect(const sf::FloatRect& r, sf::Color outline, sf::Color fill, float thick) {
     sf::RectangleShape s({r.width, r.height});
@@ -39,7 +71,7 @@ void Renderer::drawStyledRect(const sf::FloatRect& r, sf::Color outline, sf::Col
     s.setFillColor(fill);
     s.setOutlineColor(outline);
     s.setOutlineThickness(thick);
-    window.draw(s);
+    target->draw(s);
 }
 
 void Renderer::drawPanel(const sf::FloatRect& r, const string& title, unsigned titleSize) {
@@ -57,20 +89,19 @@ void Renderer::drawCheckbox(const sf::FloatRect& r, const string& label, bool ch
     box.setFillColor(hovered && !checked ? SECONDARY_UI_COLOR : PRIMARY_UI_COLOR); // Subtle hover fill
     box.setOutlineThickness(1.f);
     box.setOutlineColor(hovered || checked ? ACCENT_COLOR : BORDER_COLOR); // Accent outline on hover/check
-    window.draw(box);
+    target->draw(box);
 
     if (checked) {
         float checkPadding = checkboxSize / 3.5f;
         sf::RectangleShape tick({checkboxSize - 2 * checkPadding, checkboxSize - 2 * checkPadding});
         tick.setPosition(r.left + checkPadding, box.getPosition().y + checkPadding);
         tick.setFillColor(CHECKBOX_CHECK_COLOR);
-        window.draw(tick);
+        target->draw(tick);
     }
-    sf::Text t(label, font, static_cast<unsigned int>(fontSize));
-    t.setFillColor(TEXT_COLOR);
-    sf::FloatRect textBounds = t.getLocalBounds();
-    t.setPosition(r.left + checkboxSize + labelOffset, r.top + (r.height - textBounds.height - textBounds.top) / 2.f );
-    window.draw(t);
+    CachedText& cached = getCachedText(label, static_cast<unsigned int>(fontSize), sf::Text::Regular);
+    cached.text.setFillColor(TEXT_COLOR);
+    cached.text.setPosition(r.left + checkboxSize + labelOffset, r.top + (r.height - cached.bounds.height - cached.bounds.top) / 2.f );
+    target->draw(cached.text);
 }
 
 // For speed slider (circular knob)
@@ -79,7 +110,7 @@ void Renderer::drawSlider(const sf::FloatRect& trackRect, float knobX, float kno
     line.setPosition(trackRect.left, trackRect.top + trackRect.height / 2.f - line.getSize().y / 2.f);
     line.setFillColor(SECONDARY_UI_COLOR);
     // line.setRadius(3.f); // If SFML supports rounded rects for track
-    window.draw(line);
+    target->draw(line);
 
     sf::CircleShape knob(knobRadius);
     knob.setFillColor(SLIDER_KNOB_COLOR);
@@ -87,7 +118,7 @@ void Renderer::drawSlider(const sf::FloatRect& trackRect, float knobX, float kno
     knob.setOutlineThickness(2.f);
     knob.setOrigin(knobRadius, knobRadius);
     knob.setPosition(knobX, trackRect.top + trackRect.height / 2.f);
-    window.draw(knob);
+    target->draw(knob);
 }
 
 // For DS bar (rectangular knob/thumb)
@@ -96,35 +127,85 @@ void Renderer::drawHorizontalSlider(const sf::FloatRect& trackRect, float knobX,
     trackShape.setPosition(trackRect.left, trackRect.top);
     trackShape.setFillColor(SECONDARY_UI_COLOR); // Track color
     // trackShape.setRadius(trackRect.height / 2.f); // Rounded track
-    window.draw(trackShape);
+    target->draw(trackShape);
 
     sf::RectangleShape knobShape({knobWidth, knobHeight});
     knobShape.setPosition(knobX, trackRect.top + (trackRect.height - knobHeight) / 2.f); // Center knob vertically
     knobShape.setFillColor(ACCENT_COLOR); // Knob color
     // knobShape.setRadius(knobHeight / 2.f); // Rounded knob
-    window.draw(knobShape);
+    target->draw(knobShape);
+}
+
+
+Renderer::CachedText& Renderer::getCachedText(const string& txt, unsigned size, sf::Uint32 style) {
+    auto& bucket = textCache[(size << 8) | style];
+    auto it = bucket.find(txt);
+    if (it != bucket.end()) return it->second;
+
+    if (cachedTextCount >= MAX_CACHED_TEXTS) { // Crude but bounded: start over
+        textCache.clear();
+        cachedTextCount = 0;
+        return getCachedText(txt, size, style);
+    }
+    CachedText& entry = bucket[txt];
+    entry.text.setFont(font);
+    entry.text.setString(txt);
+    entry.text.setCharacterSize(size);
+    entry.text.setStyle(style);
+    entry.bounds = entry.text.getLocalBounds();
+    ++cachedTextCount;
+    return entry;
 }
 
+sf::FloatRect Renderer::measureText(const string& txt, unsigned size, bool bold, bool italic) {
+    sf::Uint32 style = sf::Text::Regular;
+    if (bold) style |= sf::Text::Bold;
+    if (italic) style |= sf::Text::Italic;
+    return getCachedText(txt, size, style).bounds;
+}
 
 void Renderer::drawText(const string& txt, const sf::Vector2f& position, unsigned size, sf::Color c, bool bold, bool italic) {
-    sf::Text textObj(txt, font, size);
-    textObj.setFillColor(c);
-    textObj.setPosition(position.x, position.y - size/10.f); // Minor baseline adjustment
     sf::Uint32 style = sf::Text::Regular;
     if (bold) style |= sf::Text::Bold;
     if (italic) style |= sf::Text::Italic;
-    textObj.setStyle(style);
-    window.draw(textObj);
+    sf::Text& textObj = getCachedText(txt, size, style).text;
+    textObj.setFillColor(c);
+    textObj.setOrigin(0.f, 0.f);
+    textObj.setPosition(position.x, position.y - size/10.f); // Minor baseline adjustment
+    target->draw(textObj);
+}
+
+void Renderer::drawDynamicText(const string& txt, const sf::Vector2f& position, unsigned size, sf::Color c) {
+    dynamicText.setString(txt);
+    dynamicText.setCharacterSize(size);
+    dynamicText.setFillColor(c);
+    dynamicText.setPosition(position.x, position.y - size/10.f); // Same baseline adjustment as drawText
+    target->draw(dynamicText);
 }
 
 void Renderer::drawTextCentered(const sf::FloatRect& area, const string& txt, unsigned size, sf::Color c, float vOffset) {
-    sf::Text textObj(txt, font, size);
+    CachedText& cached = getCachedText(txt, size, sf::Text::Regular);
+    sf::Text& textObj = cached.text;
+    const sf::FloatRect& textBounds = cached.bounds;
     textObj.setFillColor(c);
-    sf::FloatRect textBounds = textObj.getLocalBounds();
     // Proper centering: consider textBounds.left and textBounds.top for origin
     textObj.setOrigin(textBounds.left + textBounds.width / 2.0f, textBounds.top + textBounds.height / 2.0f);
     textObj.setPosition(area.left + area.width / 2.0f, area.top + area.height / 2.0f + vOffset);
-    window.draw(textObj);
+    target->draw(textObj);
+    textObj.setOrigin(0.f, 0.f); // Shared with drawText/drawCheckbox, which expect no origin offset
+}
+
+// Axis maxima repeat frame after frame, so format each value once
+const string& Renderer::formatAxisValue(double value) {
+    auto it = axisLabelCache.find(value);
+    if (it != axisLabelCache.end()) return it->second;
+    if (axisLabelCache.size() >= MAX_CACHED_TEXTS) axisLabelCache.clear();
+
+    ostringstream label;
+    if (value < 1000 && value > -1000 && value !=0) label << fixed << setprecision(1) << value;
+    else if (value != 0) label << fixed << setprecision(0) << value;
+    else label << "0";
+    return axisLabelCache.emplace(value, label.str()).first->second;
 }
 
 void Renderer::drawAxes(const sf::FloatRect& graphPlotArea, unsigned max_n, double maxYValue) {
@@ -132,106 +213,355 @@ void Renderer::drawAxes(const sf::FloatRect& graphPlotArea, unsigned max_n, doub
     xAxis[0].position = {graphPlotArea.left, graphPlotArea.top + graphPlotArea.height};
     xAxis[1].position = {graphPlotArea.left + graphPlotArea.width, graphPlotArea.top + graphPlotArea.height};
     xAxis[0].color = xAxis[1].color = AXIS_COLOR;
-    window.draw(xAxis);
+    target->draw(xAxis);
     drawText("n", {graphPlotArea.left + graphPlotArea.width - 12, graphPlotArea.top + graphPlotArea.height - 18}, 11, TEXT_MUTED_COLOR);
     drawText("0", {graphPlotArea.left - 8, graphPlotArea.top + graphPlotArea.height - 5}, 11, TEXT_MUTED_COLOR);
     
-    ostringstream maxXLabel; maxXLabel << max_n;
-    sf::Text tempMaxXText(maxXLabel.str(), font, 11);
-    drawText(maxXLabel.str(), {graphPlotArea.left + graphPlotArea.width - tempMaxXText.getLocalBounds().width - 2, graphPlotArea.top + graphPlotArea.height + 3}, 11, TEXT_MUTED_COLOR);
+    string maxXLabel = std::to_string(max_n); // Short enough for small-string storage, no allocation
+    drawText(maxXLabel, {graphPlotArea.left + graphPlotArea.width - measureText(maxXLabel, 11).width - 2, graphPlotArea.top + graphPlotArea.height + 3}, 11, TEXT_MUTED_COLOR);
 
     sf::VertexArray yAxis(sf::Lines, 2);
     yAxis[0].position = {graphPlotArea.left, graphPlotArea.top};
     yAxis[1].position = {graphPlotArea.left, graphPlotArea.top + graphPlotArea.height};
     yAxis[0].color = yAxis[1].color = AXIS_COLOR;
-    window.draw(yAxis);
+    target->draw(yAxis);
     drawText("Value", {graphPlotArea.left + 5, graphPlotArea.top - 1}, 11, TEXT_MUTED_COLOR);
 
-    ostringstream maxYLabel;
-    if (maxYValue < 1000 && maxYValue > -1000 && maxYValue !=0) maxYLabel << fixed << setprecision(1) << maxYValue;
-    else if (maxYValue != 0) maxYLabel << fixed << setprecision(0) << maxYValue;
-    else maxYLabel << "0";
-    sf::Text tempMaxYText(maxYLabel.str(), font, 11);
-    drawText(maxYLabel.str(), {graphPlotArea.left - tempMaxYText.getLocalBounds().width - 10, graphPlotArea.top - 5}, 11, TEXT_MUTED_COLOR);
+    const string& maxYLabel = formatAxisValue(maxYValue);
+    drawText(maxYLabel, {graphPlotArea.left - measureText(maxYLabel, 11).width - 10, graphPlotArea.top - 5}, 11, TEXT_MUTED_COLOR);
 }
 
-void Renderer::drawFunctionGraph(const sf::FloatRect& bounds,
-                                 const string& bigO_notation,
-                                 sf::Color lineColor,
-                                 const string& title,
-                                 unsigned max_n_for_plot) {
-    sf::RectangleShape graphBg(sf::Vector2f(bounds.width, bounds.height));
-    graphBg.setPosition(bounds.left, bounds.top);
-    graphBg.setFillColor(PANEL_BACKGROUND_COLOR); // Use panel bg for graph area for contrast
-    graphBg.setOutlineColor(GRAPH_BORDER_COLOR);
-    graphBg.setOutlineThickness(1.f);
-    window.draw(graphBg);
+const Renderer::FunctionGraphGeometry& Renderer::getFunctionGraph(const sf::FloatRect& bounds, const string& bigO_notation,
+                                                                   sf::Color lineColor, const string& title, unsigned max_n) {
+    for (FunctionGraphGeometry& g : graphCache) {
+        if (g.bounds != bounds) continue;
+        if (g.notation != bigO_notation || g.title != title || g.maxN != max_n || g.lineColor != lineColor) {
+            g.notation = bigO_notation; g.title = title; g.maxN = max_n; g.lineColor = lineColor;
+            buildFunctionGraph(g);
+        }
+        return g;
+    }
+    if (graphCache.size() >= MAX_CACHED_GRAPHS) graphCache.clear(); // Window was resized many times
+    graphCache.emplace_back();
+    FunctionGraphGeometry& g = graphCache.back();
+    g.bounds = bounds; g.notation = bigO_notation; g.title = title; g.maxN = max_n; g.lineColor = lineColor;
+    buildFunctionGraph(g);
+    return g;
+}
 
-    drawText(title + ": " + bigO_notation, {bounds.left + 5, bounds.top + 2}, 13, TEXT_COLOR, true);
+void Renderer::buildFunctionGraph(FunctionGraphGeometry& g) {
+    const sf::FloatRect& bounds = g.bounds;
+    g.background.setSize(sf::Vector2f(bounds.width, bounds.height));
+    g.background.setPosition(bounds.left, bounds.top);
+    g.background.setFillColor(PANEL_BACKGROUND_COLOR); // Use panel bg for graph area for contrast
+    g.background.setOutlineColor(GRAPH_BORDER_COLOR);
+    g.background.setOutlineThickness(1.f);
+    g.titleLabel = g.title + ": " + g.notation;
+    g.naLabel = "Graph N/A for\n" + g.notation;
+    g.line.clear();
+    g.maxYValue = 0.0;
+    g.plottable = false;
 
     float titleAreaHeight = 25.f;
     float axisPadding = 30.f; // Increased padding for labels
-    sf::FloatRect plotArea(bounds.left + axisPadding, bounds.top + titleAreaHeight + 5, // 5 for spacing below title
-                           bounds.width - axisPadding - 15.f, // 15 for right padding
-                           bounds.height - titleAreaHeight - axisPadding - 10.f); // 10 for bottom padding
-    
-    if (plotArea.width <=10 || plotArea.height <=10) {
-        drawTextCentered(bounds, "Plot area too small", 12, TEXT_MUTED_COLOR);
-        return;
-    }
+    g.plotArea = sf::FloatRect(bounds.left + axisPadding, bounds.top + titleAreaHeight + 5, // 5 for spacing below title
+                               bounds.width - axisPadding - 15.f, // 15 for right padding
+                               bounds.height - titleAreaHeight - axisPadding - 10.f); // 10 for bottom padding
+    const sf::FloatRect& plotArea = g.plotArea;
+    g.plotAreaTooSmall = (plotArea.width <=10 || plotArea.height <=10);
+    if (g.plotAreaTooSmall) return;
+
+    // Parse the notation once, then sample the compiled class
+    ComplexityClass complexity = parseComplexity(g.notation);
+    if (complexity == ComplexityClass::Unknown) return;
+    bool logShaped = (complexity == ComplexityClass::Logarithmic || complexity == ComplexityClass::Linearithmic);
 
     vector<sf::Vector2f> points;
+    points.reserve(g.maxN + 1);
     double maxYValue = 0.0;
-    bool plottable = true;
-
-    for (unsigned n_idx = 0; n_idx <= max_n_for_plot; ++n_idx) {
+    for (unsigned n_idx = 0; n_idx <= g.maxN; ++n_idx) {
         double n_val = static_cast<double>(n_idx);
-        if (n_idx == 0 && (bigO_notation.find("log n") != string::npos)) n_val = 1.0;
+        if (n_idx == 0 && logShaped) n_val = 1.0;
         if (n_idx == 0 && n_val == 0) n_val = 1e-9;
 
-        double val = evaluateSimpleComplexity(bigO_notation, n_val);
-        if (std::isnan(val)) { plottable = false; break; }
+        double val = evaluateComplexity(complexity, n_val);
         if (std::isinf(val) || val > 1e9) val = 1e9;
-        
+
         points.push_back(sf::Vector2f(static_cast<float>(n_idx), static_cast<float>(val))); // Use n_idx for x-axis mapping
         if (val > maxYValue && !std::isinf(val)) maxYValue = val;
     }
 
-    if (maxYValue == 0 && !points.empty() && plottable) {
-         maxYValue = 1.0; 
+    if (maxYValue == 0 && !points.empty()) {
+         maxYValue = 1.0;
          for(const auto& p : points) if(p.y > maxYValue) maxYValue = p.y;
          if(maxYValue < 1.0 && maxYValue != 0.0) maxYValue = 1.0;
          else if(maxYValue == 0.0) maxYValue = 1.0;
     }
+    if (points.empty()) return;
+    g.plottable = true;
+    g.maxYValue = maxYValue;
 
-    if (!plottable || points.empty()) {
-        drawTextCentered(plotArea, "Graph N/A for\n" + bigO_notation, 13, TEXT_MUTED_COLOR);
-        return;
-    }
-    
-    drawAxes(plotArea, max_n_for_plot, maxYValue);
-
-    sf::VertexArray lineStrip(sf::LineStrip);
-    for (const auto& p : points) { // p.x is n_idx (0 to max_n_for_plot)
-        float x_ratio = (max_n_for_plot > 0) ? (p.x / static_cast<float>(max_n_for_plot)) : 0.f;
+    for (const auto& p : points) { // p.x is n_idx (0 to maxN)
+        float x_ratio = (g.maxN > 0) ? (p.x / static_cast<float>(g.maxN)) : 0.f;
         float screenX = plotArea.left + x_ratio * plotArea.width;
-        
+
         float y_ratio = (maxYValue > 1e-9) ? (p.y / static_cast<float>(maxYValue)) : 0.0f;
         float screenY = plotArea.top + plotArea.height - (y_ratio * plotArea.height);
-        
+
         screenX = std::max(plotArea.left, std::min(screenX, plotArea.left + plotArea.width));
         screenY = std::max(plotArea.top, std::min(screenY, plotArea.top + plotArea.height));
-        lineStrip.append(sf::Vertex(sf::Vector2f(screenX, screenY), lineColor));
+        g.line.append(sf::Vertex(sf::Vector2f(screenX, screenY), g.lineColor));
     }
+}
 
-    if (lineStrip.getVertexCount() > 1) window.draw(lineStrip);
-    else if (lineStrip.getVertexCount() == 1) {
+void Renderer::drawFunctionGraph(const sf::FloatRect& bounds,
+                                 const string& bigO_notation,
+                                 sf::Color lineColor,
+                                 const string& title,
+                                 unsigned max_n_for_plot) {
+    const FunctionGraphGeometry& g = getFunctionGraph(bounds, bigO_notation, lineColor, title, max_n_for_plot);
+    target->draw(g.background);
+    drawText(g.titleLabel, {bounds.left + 5, bounds.top + 2}, 13, TEXT_COLOR, true);
+
+    if (g.plotAreaTooSmall) {
+        drawTextCentered(bounds, "Plot area too small", 12, TEXT_MUTED_COLOR);
+        return;
+    }
+    if (!g.plottable) {
+        drawTextCentered(g.plotArea, g.naLabel, 13, TEXT_MUTED_COLOR);
+        return;
+    }
+
+    drawAxes(g.plotArea, max_n_for_plot, g.maxYValue);
+
+    if (g.line.getVertexCount() > 1) target->draw(g.line);
+    else if (g.line.getVertexCount() == 1) {
         sf::CircleShape point(2.f); point.setFillColor(lineColor);
-        point.setOrigin(1.f, 1.f); point.setPosition(lineStrip[0].position);
-        window.draw(point);
+        point.setOrigin(1.f, 1.f); point.setPosition(g.line[0].position);
+        target->draw(point);
+    }
+}
+
+const Renderer::MeasuredGraphGeometry& Renderer::getMeasuredGraph(const sf::FloatRect& bounds, const vector<double>& ns,
+                                                                   const vector<double>& values, const string& notation,
+                                                                   sf::Color lineColor, const string& title) {
+    MeasuredGraphGeometry* entry = nullptr;
+    for (MeasuredGraphGeometry& g : measuredGraphCache) {
+        if (g.bounds == bounds) { entry = &g; break; }
+    }
+    if (!entry) {
+        if (measuredGraphCache.size() >= MAX_CACHED_GRAPHS) measuredGraphCache.clear();
+        measuredGraphCache.emplace_back();
+        entry = &measuredGraphCache.back();
+        entry->bounds = bounds;
+    } else if (entry->ns == ns && entry->values == values && entry->notation == notation &&
+               entry->title == title && entry->lineColor == lineColor) {
+        return *entry;
+    }
+    entry->ns = ns; entry->values = values; entry->notation = notation;
+    entry->title = title; entry->lineColor = lineColor;
+    buildMeasuredGraph(*entry);
+    return *entry;
+}
+
+void Renderer::buildMeasuredGraph(MeasuredGraphGeometry& g) {
+    const sf::FloatRect& bounds = g.bounds;
+    g.background.setSize(sf::Vector2f(bounds.width, bounds.height));
+    g.background.setPosition(bounds.left, bounds.top);
+    g.background.setFillColor(PANEL_BACKGROUND_COLOR);
+    g.background.setOutlineColor(GRAPH_BORDER_COLOR);
+    g.background.setOutlineThickness(1.f);
+    g.measuredLine.clear();
+    g.theoryLine.clear();
+
+    float titleAreaHeight = 25.f;
+    float axisPadding = 30.f;
+    g.plotArea = sf::FloatRect(bounds.left + axisPadding, bounds.top + titleAreaHeight + 5,
+                               bounds.width - axisPadding - 15.f,
+                               bounds.height - titleAreaHeight - axisPadding - 10.f);
+    const sf::FloatRect& plotArea = g.plotArea;
+    if (g.ns.empty() || plotArea.width <= 10 || plotArea.height <= 10) return;
+
+    double maxN = *std::max_element(g.ns.begin(), g.ns.end());
+    double maxY = std::max(1e-9, *std::max_element(g.values.begin(), g.values.end()));
+    g.maxN = static_cast<unsigned>(maxN);
+    g.maxYValue = maxY;
+
+    auto toScreen = [&](double n, double y) {
+        float screenX = plotArea.left + static_cast<float>(n / maxN) * plotArea.width;
+        float screenY = plotArea.top + plotArea.height - static_cast<float>(std::min(y / maxY, 1.0)) * plotArea.height;
+        return sf::Vector2f(screenX, std::max(plotArea.top, screenY));
+    };
+    for (size_t i = 0; i < g.ns.size() && i < g.values.size(); ++i) {
+        g.measuredLine.append(sf::Vertex(toScreen(g.ns[i], g.values[i]), g.lineColor));
+    }
+
+    // Theoretical class scaled to the measurements so only the shape differs
+    ComplexityClass complexity = parseComplexity(g.notation);
+    if (complexity == ComplexityClass::Unknown) return;
+    double k = complexityScale(complexity, g.ns, g.values);
+    const unsigned samples = 100;
+    for (unsigned i = 0; i <= samples; ++i) {
+        double n = std::max(1.0, maxN * i / samples);
+        double y = k * evaluateComplexity(complexity, n);
+        if (!std::isfinite(y)) break;
+        g.theoryLine.append(sf::Vertex(toScreen(n, y), THEORY_CURVE_COLOR));
+    }
+}
+
+void Renderer::drawMeasuredGraph(const sf::FloatRect& bounds,
+                                 const vector<double>& ns,
+                                 const vector<double>& values,
+                                 const string& theoreticalNotation,
+                                 sf::Color lineColor,
+                                 const string& title) {
+    const MeasuredGraphGeometry& g = getMeasuredGraph(bounds, ns, values, theoreticalNotation, lineColor, title);
+    target->draw(g.background);
+    drawText(title, {bounds.left + 5, bounds.top + 2}, 13, TEXT_COLOR, true);
+    if (g.measuredLine.getVertexCount() == 0) {
+        drawTextCentered(bounds, "Measuring...", 12, TEXT_MUTED_COLOR);
+        return;
     }
+    drawAxes(g.plotArea, g.maxN, g.maxYValue);
+    if (g.theoryLine.getVertexCount() > 1) target->draw(g.theoryLine);
+    if (g.measuredLine.getVertexCount() > 1) target->draw(g.measuredLine);
+}
+
+bool Renderer::arrayLayoutMatches(const sf::FloatRect& bounds, const vector<int>& arr) const {
+    return arrayShadow.size() == arr.size() && arrayBounds == bounds;
+}
+
+void Renderer::rebuildArrayBars(const sf::FloatRect& bounds, const vector<int>& arr, const vector<sf::Color>& highlights) {
+    arrayBounds = bounds;
+    arrayShadow = arr;
+    arrayColorShadow.assign(arr.size(), ARRAY_BAR_COLOR);
+    if (highlights.size() == arr.size()) arrayColorShadow = highlights;
+    arrayBars.resize(arr.size() * 6);
+    if (arr.empty()) return;
+
+    auto range = std::minmax_element(arr.begin(), arr.end());
+    arrayMinValue = std::min(0, *range.first);
+    arrayMaxValue = std::max(arrayMinValue + 1, *range.second);
+    arrayBarWidth = bounds.width / static_cast<float>(arr.size());
+    arrayBarGap = arrayBarWidth > 4.f ? 1.f : 0.f; // Gaps only once bars are wide enough to show them
+    for (size_t i = 0; i < arr.size(); ++i) writeBar(i, arrayShadow[i], arrayColorShadow[i]);
+}
+
+void Renderer::writeBar(size_t i, int value, sf::Color color) {
+    float ratio = static_cast<float>(value - arrayMinValue) / static_cast<float>(arrayMaxValue - arrayMinValue);
+    float left = arrayBounds.left + static_cast<float>(i) * arrayBarWidth;
+    float right = left + arrayBarWidth - arrayBarGap;
+    float bottom = arrayBounds.top + arrayBounds.height;
+    float top = bottom - std::max(1.f, ratio * arrayBounds.height); // Keep the smallest value visible
+
+    sf::Vertex* v = &arrayBars[i * 6];
+    v[0].position = {left, top};     v[1].position = {right, top};    v[2].position = {right, bottom};
+    v[3].position = {left, top};     v[4].position = {right, bottom}; v[5].position = {left, bottom};
+    for (int k = 0; k < 6; ++k) v[k].color = color;
 }
 
 void Renderer::drawArray(const sf::FloatRect& bounds, const vector<int>& arr, const vector<sf::Color>& highlights) {
-    (void)bounds; (void)arr; (void)highlights;
+    if (!arrayLayoutMatches(bounds, arr)) {
+        rebuildArrayBars(bounds, arr, highlights);
+    } else {
+        bool hasColors = highlights.size() == arr.size();
+        for (size_t i = 0; i < arr.size(); ++i) {
+            sf::Color c = hasColors ? highlights[i] : ARRAY_BAR_COLOR;
+            if (arr[i] == arrayShadow[i] && c == arrayColorShadow[i]) continue;
+            if (arr[i] < arrayMinValue || arr[i] > arrayMaxValue) { // Value range grew, rescale every bar
+                rebuildArrayBars(bounds, arr, highlights);
+                break;
+            }
+            arrayShadow[i] = arr[i];
+            arrayColorShadow[i] = c;
+            writeBar(i, arr[i], c);
+        }
+    }
+    if (arrayBars.getVertexCount() > 0) target->draw(arrayBars);
+}
+
+void Renderer::drawArray(const sf::FloatRect& bounds, const vector<int>& arr, const vector<sf::Color>& highlights,
+                         const vector<size_t>& changedIndices) {
+    if (!arrayLayoutMatches(bounds, arr)) {
+        rebuildArrayBars(bounds, arr, highlights);
+    } else {
+        bool hasColors = highlights.size() == arr.size();
+        for (size_t i : changedIndices) {
+            if (i >= arr.size()) continue;
+            if (arr[i] < arrayMinValue || arr[i] > arrayMaxValue) {
+                rebuildArrayBars(bounds, arr, highlights);
+                break;
+            }
+            sf::Color c = hasColors ? highlights[i] : ARRAY_BAR_COLOR;
+            arrayShadow[i] = arr[i];
+            arrayColorShadow[i] = c;
+            writeBar(i, arr[i], c);
+        }
+    }
+    if (arrayBars.getVertexCount() > 0) target->draw(arrayBars);
+}
+
+void Renderer::drawGraph(const sf::FloatRect& bounds, const vector<sf::Vector2f>& positions,
+                         const vector<std::pair<std::uint32_t, std::uint32_t>>& edges,
+                         const vector<std::pair<std::uint32_t, std::uint32_t>>& treeEdges,
+                         const vector<sf::Color>& nodeColors) {
+    const float padding = 16.f;
+    float nodeHalf = std::max(3.f, std::min(bounds.width, bounds.height) / 60.f);
+    sf::FloatRect area(bounds.left + padding, bounds.top + padding,
+                       std::max(1.f, bounds.width - 2 * padding), std::max(1.f, bounds.height - 2 * padding));
+    auto toScreen = [&](std::uint32_t v) {
+        return sf::Vector2f(area.left + positions[v].x * area.width, area.top + positions[v].y * area.height);
+    };
+
+    // Plain edges first, then tree edges on top of them
+    graphEdgeLines.clear();
+    auto appendEdges = [&](const vector<std::pair<std::uint32_t, std::uint32_t>>& list, sf::Color color) {
+        for (const auto& e : list) {
+            if (e.first >= positions.size() || e.second >= positions.size()) continue;
+            graphEdgeLines.append(sf::Vertex(toScreen(e.first), color));
+            graphEdgeLines.append(sf::Vertex(toScreen(e.second), color));
+        }
+    };
+    appendEdges(edges, GRAPH_EDGE_COLOR);
+    appendEdges(treeEdges, GRAPH_TREE_EDGE_COLOR);
+
+    graphNodeQuads.resize(positions.size() * 6);
+    for (std::uint32_t v = 0; v < positions.size(); ++v) {
+        sf::Vector2f c = toScreen(v);
+        sf::Color color = v < nodeColors.size() ? nodeColors[v] : ARRAY_BAR_COLOR;
+        float l = c.x - nodeHalf, r = c.x + nodeHalf, t = c.y - nodeHalf, b = c.y + nodeHalf;
+        sf::Vertex* q = &graphNodeQuads[v * 6];
+        q[0].position = {l, t}; q[1].position = {r, t}; q[2].position = {r, b};
+        q[3].position = {l, t}; q[4].position = {r, b}; q[5].position = {l, b};
+        for (int k = 0; k < 6; ++k) q[k].color = color;
+    }
+
+    if (graphEdgeLines.getVertexCount() > 0) target->draw(graphEdgeLines);
+    if (graphNodeQuads.getVertexCount() > 0) target->draw(graphNodeQuads);
+}
+
+void Renderer::drawMatrix(const sf::FloatRect& bounds, size_t rows, size_t cols, const vector<sf::Color>& cellColors) {
+    if (rows == 0 || cols == 0) return;
+    const float padding = 16.f;
+    float cell = std::min((bounds.width - 2 * padding) / static_cast<float>(cols),
+                          (bounds.height - 2 * padding) / static_cast<float>(rows));
+    if (cell <= 1.f) return;
+    float gap = cell > 6.f ? 1.f : 0.f;
+    float left = bounds.left + (bounds.width - cell * static_cast<float>(cols)) / 2.f;
+    float top = bounds.top + (bounds.height - cell * static_cast<float>(rows)) / 2.f;
+
+    matrixCells.resize(rows * cols * 6);
+    for (size_t r = 0; r < rows; ++r) {
+        for (size_t c = 0; c < cols; ++c) {
+            size_t idx = r * cols + c;
+            sf::Color color = idx < cellColors.size() ? cellColors[idx] : ARRAY_BAR_COLOR;
+            float l = left + static_cast<float>(c) * cell, t = top + static_cast<float>(r) * cell;
+            float rgt = l + cell - gap, b = t + cell - gap;
+            sf::Vertex* q = &matrixCells[idx * 6];
+            q[0].position = {l, t};   q[1].position = {rgt, t}; q[2].position = {rgt, b};
+            q[3].position = {l, t};   q[4].position = {rgt, b}; q[5].position = {l, b};
+            for (int k = 0; k < 6; ++k) q[k].color = color;
+        }
+    }
+    target->draw(matrixCells);
 }
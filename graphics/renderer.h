@@ -1,9 +1,13 @@
 // graphics/renderer.h
 #pragma once
 #include <SFML/Graphics.hpp>
+#include <cstdint>
 #include <string>
 #include <vector>
 #include <functional>
+#include <map>
+#include <unordered_map>
+#include <utility>
 
 class Renderer {
 public:
@@ -23,10 +27,28 @@ public:
     static const sf::Color AXIS_COLOR;
     static const sf::Color COMPLEXITY_TIME_COLOR;
     static const sf::Color COMPLEXITY_SPACE_COLOR;
+    static const sf::Color ARRAY_BAR_COLOR;
+    static const sf::Color ARRAY_COMPARE_COLOR;
+    static const sf::Color ARRAY_SWAP_COLOR;
+    static const sf::Color ARRAY_RANGE_COLOR;
+    static const sf::Color ARRAY_SORTED_COLOR;
+    static const sf::Color THEORY_CURVE_COLOR;
+    static const sf::Color GRAPH_EDGE_COLOR;
+    static const sf::Color GRAPH_TREE_EDGE_COLOR;
+    static const sf::Color GRAPH_FRONTIER_COLOR;
+    static const sf::Color GRAPH_VISITED_COLOR;
+    // Distinct color per worker thread for parallel traces; worker 0 is ARRAY_SWAP_COLOR
+    static sf::Color workerColor(unsigned worker);
 
 
     Renderer(sf::RenderWindow& w, sf::Font& f);
 
+    // Everything below draws into the current target: the window by default,
+    // or a pane's cached sf::RenderTexture while the GUI re-renders it
+    void setTarget(sf::RenderTarget& t);
+    void resetTarget();
+    sf::RenderTarget& getTarget();
+
     void drawPanel(const sf::FloatRect& r, const std::string& title = "", unsigned titleSize = 18);
     void drawCheckbox(const sf::FloatRect& r, const std::string& label, bool checked, bool hovered, float checkboxSize, float labelOffset, int fontSize);
     // Overload for horizontal slider (used for DS bar)
@@ -36,6 +58,11 @@ public:
 
     void drawText(const std::string& txt, const sf::Vector2f& position, unsigned size = 18, sf::Color c = TEXT_COLOR, bool bold = false, bool italic = false);
     void drawTextCentered(const sf::FloatRect& area, const std::string& txt, unsigned size = 18, sf::Color c = TEXT_COLOR, float vOffset = 0.f);
+    // For strings that change nearly every frame (playback status, live counts): laid
+    // out in one reused sf::Text instead of the cache, so they never evict static labels
+    void drawDynamicText(const std::string& txt, const sf::Vector2f& position, unsigned size = 18, sf::Color c = TEXT_COLOR);
+    // Local bounds of laid-out text, served from the text cache (no sf::Text rebuild)
+    sf::FloatRect measureText(const std::string& txt, unsigned size, bool bold = false, bool italic = false);
     
     void drawFunctionGraph(const sf::FloatRect& bounds,
                            const std::string& bigO_notation,
@@ -43,14 +70,119 @@ public:
                            const std::string& title,
                            unsigned max_n_for_plot = 100);
 
+    // Measured samples (ns[i], values[i]) with the theoretical class scaled to fit them
+    void drawMeasuredGraph(const sf::FloatRect& bounds,
+                           const std::vector<double>& ns,
+                           const std::vector<double>& values,
+                           const std::string& theoreticalNotation,
+                           sf::Color lineColor,
+                           const std::string& title);
+
+    // Bar chart kept as one persistent vertex array and drawn in a single call.
+    // This overload diffs against the previous frame to find changed bars.
     void drawArray(const sf::FloatRect& bounds, const std::vector<int>& arr,
                    const std::vector<sf::Color>& highlights = {});
+    // Same, but only rewrites the bars listed in changedIndices (caller tracks the dirty set)
+    void drawArray(const sf::FloatRect& bounds, const std::vector<int>& arr,
+                   const std::vector<sf::Color>& highlights, const std::vector<size_t>& changedIndices);
+
+    // Node-link drawing: positions are normalized to [0,1] inside bounds; treeEdges
+    // are drawn highlighted on top of the plain edges.
+    void drawGraph(const sf::FloatRect& bounds, const std::vector<sf::Vector2f>& positions,
+                   const std::vector<std::pair<std::uint32_t, std::uint32_t>>& edges,
+                   const std::vector<std::pair<std::uint32_t, std::uint32_t>>& treeEdges,
+                   const std::vector<sf::Color>& nodeColors);
+
+    // rows x cols grid of square cells (row-major colors), centered in bounds
+    void drawMatrix(const sf::FloatRect& bounds, size_t rows, size_t cols, const std::vector<sf::Color>& cellColors);
 
 private:
     sf::RenderWindow& window;
+    sf::RenderTarget* target;
     sf::Font& font;
 
     // Kept as sharp rect for now, true rounding is complex. Name implies intent.
     void drawStyledRect(const sf::FloatRect& r, sf::Color outline, sf::Color fill, float thick = 1.f);
     void drawAxes(const sf::FloatRect& graphPlotArea, unsigned max_n, double maxYValue);
+
+    // Text layout cache: sf::Text keeps its glyph geometry once built, so static
+    // labels are laid out once and only repositioned/recolored per frame.
+    // Keyed by (size, style) then string so lookups never build a key string.
+    struct CachedText {
+        sf::Text text;
+        sf::FloatRect bounds;
+    };
+    static const size_t MAX_CACHED_TEXTS = 1024; // Backstop; per-frame strings go through drawDynamicText
+    std::unordered_map<sf::Uint32, std::unordered_map<std::string, CachedText>> textCache;
+    size_t cachedTextCount = 0;
+    std::map<double, std::string> axisLabelCache;
+    sf::Text dynamicText;
+
+    CachedText& getCachedText(const std::string& txt, unsigned size, sf::Uint32 style);
+    const std::string& formatAxisValue(double value);
+
+    // drawFunctionGraph cache: one entry per graph slot (bounds), rebuilt only
+    // when the notation, colour or sample count changes (i.e. a new algorithm)
+    struct FunctionGraphGeometry {
+        sf::FloatRect bounds;
+        std::string notation;
+        std::string title;
+        std::string titleLabel;  // "Time: O(n)"
+        std::string naLabel;     // "Graph N/A for\nO(VE)"
+        unsigned maxN = 0;
+        sf::Color lineColor;
+        sf::RectangleShape background;
+        sf::FloatRect plotArea;
+        bool plotAreaTooSmall = false;
+        bool plottable = false;
+        double maxYValue = 0.0;
+        sf::VertexArray line{sf::LineStrip};
+    };
+    static const size_t MAX_CACHED_GRAPHS = 8; // Old window sizes are dropped past this
+    std::vector<FunctionGraphGeometry> graphCache;
+
+    const FunctionGraphGeometry& getFunctionGraph(const sf::FloatRect& bounds, const std::string& bigO_notation,
+                                                  sf::Color lineColor, const std::string& title, unsigned max_n);
+    void buildFunctionGraph(FunctionGraphGeometry& g);
+
+    // drawMeasuredGraph cache, rebuilt when the samples or labels change
+    struct MeasuredGraphGeometry {
+        sf::FloatRect bounds;
+        std::vector<double> ns;
+        std::vector<double> values;
+        std::string notation;
+        std::string title;
+        sf::Color lineColor;
+        sf::RectangleShape background;
+        sf::FloatRect plotArea;
+        unsigned maxN = 0;
+        double maxYValue = 0.0;
+        sf::VertexArray measuredLine{sf::LineStrip};
+        sf::VertexArray theoryLine{sf::LineStrip};
+    };
+    std::vector<MeasuredGraphGeometry> measuredGraphCache;
+
+    const MeasuredGraphGeometry& getMeasuredGraph(const sf::FloatRect& bounds, const std::vector<double>& ns,
+                                                  const std::vector<double>& values, const std::string& notation,
+                                                  sf::Color lineColor, const std::string& title);
+    void buildMeasuredGraph(MeasuredGraphGeometry& g);
+
+    // drawArray cache: 6 vertices (two triangles) per bar, reused between frames
+    sf::VertexArray arrayBars{sf::Triangles};
+    std::vector<int> arrayShadow;           // Values currently baked into arrayBars
+    std::vector<sf::Color> arrayColorShadow; // Colors currently baked into arrayBars
+    sf::FloatRect arrayBounds;
+    int arrayMinValue = 0;
+    int arrayMaxValue = 0;
+    float arrayBarWidth = 0.f;
+    float arrayBarGap = 0.f;
+
+    bool arrayLayoutMatches(const sf::FloatRect& bounds, const std::vector<int>& arr) const;
+    void rebuildArrayBars(const sf::FloatRect& bounds, const std::vector<int>& arr, const std::vector<sf::Color>& highlights);
+    void writeBar(size_t i, int value, sf::Color color);
+
+    // drawGraph geometry, refilled each call but never reallocated
+    sf::VertexArray graphEdgeLines{sf::Lines};
+    sf::VertexArray graphNodeQuads{sf::Triangles};
+    sf::VertexArray matrixCells{sf::Triangles};
 };
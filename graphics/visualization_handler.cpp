@@ -1,11 +1,29 @@
 // graphics/visualization_handler.cpp
 #include "visualization_handler.h"
+#include "../algorithms/sorting/sorting.h"
+#include "../algorithms/graph/graph_algorithms.h"
+#include "../algorithms/searching/searching.h"
+#include "../algorithms/tree_traversals/tree_traversals.h"
+#include "../data_structures/maps_sets/hash_table.h"
+#include "../data_structures/maps_sets/trie.h"
+#include "../data_structures/trees/avl_tree.h"
+#include "../data_structures/trees/fenwick_tree.h"
+#include "../data_structures/trees/red_black_tree.h"
+#include "../data_structures/trees/segment_tree.h"
+#include "../utilities/thread_pool.h"
 #include <iostream> // Optional for debugging
+#include <algorithm>
+#include <iomanip>
+#include <memory>
+#include <numeric>
+#include <random>
+#include <sstream>
 
 // Using declarations for std types in .cpp file
 using std::string;
 using std::vector;
 using std::set; // From types.h DS_TO_ALGORITHMS_MAP
+using std::min;
 // No custom namespace for av::VisualizationHandler
 
 VisualizationHandler::VisualizationHandler()
@@ -17,6 +35,7 @@ void VisualizationHandler::setDataStructure(DataStructure ds) {
     if (ds != DataStructure::None) { // User cannot select "None"
         currentDS = ds;
         currentAlg = Algorithm::None;
+        prepareTrace();
     }
 }
 
@@ -32,6 +51,7 @@ void VisualizationHandler::setAlgorithm(Algorithm alg) {
     } else { // No algorithms defined for this DS (or its alias)
         currentAlg = Algorithm::None;
     }
+    prepareTrace();
 }
 
 DataStructure VisualizationHandler::getCurrentDataStructure() const {
@@ -76,6 +96,627 @@ void VisualizationHandler::setSpeedMs(int v) {
     if (speedMs > 5000) speedMs = 5000;
 }
 
+bool VisualizationHandler::isArrayView() const {
+    bool listInput = currentDS == DataStructure::LinkedList &&
+                     (currentAlg == Algorithm::MergeSort || currentAlg == Algorithm::LinearSearch);
+    return listInput || ((currentDS == DataStructure::Array || currentDS == DataStructure::Vector) &&
+                         (isSortingAlgorithm(currentAlg) || isSearchAlgorithm(currentAlg)));
+}
+
+bool VisualizationHandler::isGraphView() const {
+    bool graphInput = currentDS == DataStructure::Graph ||
+                      (currentDS == DataStructure::DisjointSet && currentAlg == Algorithm::Kruskal) ||
+                      (currentDS == DataStructure::Trie && (currentAlg == Algorithm::BFS || currentAlg == Algorithm::DFS)) ||
+                      // The frontier BFS and DFS keep is the queue, stack or deque shown on the demo graph
+                      ((currentDS == DataStructure::Queue || currentDS == DataStructure::Stack || currentDS == DataStructure::Deque) &&
+                       (currentAlg == Algorithm::BFS || currentAlg == Algorithm::DFS));
+    return graphInput && isGraphAlgorithm(currentAlg);
+}
+
+bool VisualizationHandler::isHashTableView() const {
+    return currentDS == DataStructure::HashTable && currentAlg == Algorithm::LinearSearch;
+}
+
+bool VisualizationHandler::isRangeTreeView() const {
+    return (currentDS == DataStructure::FenwickTree || currentDS == DataStructure::SegmentTree) &&
+           currentAlg == Algorithm::BinarySearch;
+}
+
+bool VisualizationHandler::isTreeView() const {
+    bool treeInput = currentDS == DataStructure::BinaryTree || currentDS == DataStructure::BinarySearchTree ||
+                     currentDS == DataStructure::AVLTree || currentDS == DataStructure::RedBlackTree;
+    return (treeInput && isTraversalAlgorithm(currentAlg)) ||
+           (currentDS == DataStructure::MinHeap && currentAlg == Algorithm::HuffmanEncoding);
+}
+
+bool VisualizationHandler::isMatrixView() const {
+    return currentDS == DataStructure::Graph && currentAlg == Algorithm::FloydWarshall;
+}
+
+bool VisualizationHandler::hasVisualization() const {
+    return isArrayView() || isHashTableView() || isRangeTreeView() || isGraphView() || isTreeView() || isMatrixView();
+}
+
+bool VisualizationHandler::isAnimating() const {
+    return hasVisualization() && playbackCursor < trace.size();
+}
+
+bool VisualizationHandler::hasPendingChanges() const {
+    return !changedIndices.empty();
+}
+
+void VisualizationHandler::prepareTrace() {
+    trace.clear();
+    initialData.clear();
+    displayData.clear();
+    barColors.clear();
+    highlighted.clear();
+    changedIndices.clear();
+    demoGraph = Graph();
+    nodePositions.clear();
+    graphEdges.clear();
+    treeParents.clear();
+    forestEdges.clear();
+    nodeStates.clear();
+    frontierNodes.clear();
+    traceWorkers = 1;
+    listTraffic = ListSortStats();
+    hashResizes = 0;
+    rangeLevel = 0;
+    treeHeight = 0;
+    treeRotations = 0;
+    huffmanSymbols = 0;
+    huffmanCompressed = HuffmanStreamStats();
+    huffmanRoundTrip = false;
+    trieWords = 0;
+    playbackCursor = 0;
+    pendingMs = 0.0;
+
+    // Run the real algorithm to completion once; playback only replays the trace
+    if (isArrayView()) {
+        static std::mt19937 rng(std::random_device{}());
+        initialData.resize(ARRAY_SIZE);
+        std::iota(initialData.begin(), initialData.end(), 1);
+        if (isSearchAlgorithm(currentAlg)) {
+            // Binary and ternary search need the sorted data; linear search scans it shuffled.
+            // Keys past the last bar show an unsuccessful search now and then.
+            if (currentAlg == Algorithm::LinearSearch) std::shuffle(initialData.begin(), initialData.end(), rng);
+            std::uniform_int_distribution<int> keys(1, static_cast<int>(ARRAY_SIZE + ARRAY_SIZE / 8));
+            searchKey = keys(rng);
+            if (currentDS == DataStructure::LinkedList) {
+                LinkedList list;
+                for (int v : initialData) list.pushBack(v);
+                searchResult = linearSearch(list, searchKey, &trace);
+            } else {
+                runSearch(currentAlg, initialData, searchKey, searchResult, &trace);
+            }
+        } else if (currentDS == DataStructure::LinkedList) {
+            // Same bars as the array merge sort, but the merges relink nodes
+            std::shuffle(initialData.begin(), initialData.end(), rng);
+            LinkedList list;
+            for (int v : initialData) list.pushBack(v);
+            list.sort(&trace, &listTraffic);
+        } else {
+            std::shuffle(initialData.begin(), initialData.end(), rng);
+            vector<int> work = initialData;
+            ParallelSortOptions parallel;
+            parallel.pool = &ThreadPool::shared();
+            parallel.forkCutoff = SORT_FORK_CUTOFF;
+            runSort(currentAlg, work, &trace, parallel);
+            for (const TraceEvent& ev : trace.events()) traceWorkers = std::max(traceWorkers, ev.worker + 1u);
+        }
+    } else if (isHashTableView()) {
+        // The table starts empty and grows while the keys go in, so playback shows probe
+        // sequences, Robin Hood displacements, every rehash and a few backward-shift erases.
+        // Bars are slots; an empty slot has no bar. initialData stays empty: the first event sizes it.
+        static std::mt19937 rng(std::random_device{}());
+        std::uniform_int_distribution<int> keys(1, HASH_KEY_RANGE);
+        HashTable<int, int> table;
+        table.setTrace(&trace);
+        vector<int> inserted;
+        while (table.size() < HASH_KEY_COUNT) {
+            int key = keys(rng);
+            if (table.insert(key, 0)) inserted.push_back(key);
+        }
+        for (size_t i = 0; i < HASH_ERASE_COUNT; ++i) table.erase(inserted[i * 3]);
+        searchKey = keys(rng);
+        searchResult = table.slotOf(searchKey);
+        table.setTrace(nullptr);
+    } else if (isRangeTreeView()) {
+        // Random quantities at each price level; the bars are the Fenwick cells
+        // 1..n, or the segment tree's nodes in heap order from the root
+        static std::mt19937 rng(std::random_device{}());
+        std::uniform_int_distribution<int> quantities(1, RANGE_MAX_QUANTITY);
+        vector<std::int64_t> levels(RANGE_LEVEL_COUNT);
+        std::int64_t total = 0;
+        for (std::int64_t& q : levels) {
+            q = quantities(rng);
+            total += q;
+        }
+        std::uniform_int_distribution<std::int64_t> targets(1, total);
+        searchKey = static_cast<int>(targets(rng));
+        if (currentDS == DataStructure::FenwickTree) {
+            FenwickTree fenwick(levels);
+            initialData.assign(fenwick.cells().begin() + 1, fenwick.cells().end());
+            rangeLevel = fenwick.lowerBound(searchKey, &trace);
+            searchResult = rangeLevel - 1;
+        } else {
+            SegmentTree<SumMonoid> segments(levels);
+            for (size_t k = 1; k < segments.nodeCount(); ++k) initialData.push_back(static_cast<int>(segments.nodeValue(k)));
+            rangeLevel = segments.lowerBound(searchKey, &trace);
+            searchResult = segments.nodeCount() / 2 + rangeLevel - 2; // Bar of the leaf
+        }
+    } else if (isGraphView()) {
+        if (currentDS == DataStructure::Trie) prepareTrie();
+        else prepareGraph();
+        VertexId source = 0;
+        while (source + 1 < demoGraph.vertexCount() && demoGraph.degree(source) == 0) ++source;
+        runGraphAlgorithm(currentAlg, demoGraph, source, &trace);
+    } else if (isTreeView()) {
+        if (currentAlg == Algorithm::HuffmanEncoding) prepareHuffman();
+        else prepareTree();
+    } else if (isMatrixView()) {
+        prepareGraph();
+        DistanceMatrix dist = DistanceMatrix::fromGraph(demoGraph);
+        FloydWarshallOptions options;
+        options.tile = MATRIX_TILE;
+        floydWarshall(dist, options, &trace);
+        matrixTiles = (dist.size() + MATRIX_TILE - 1) / MATRIX_TILE;
+    } else {
+        return;
+    }
+
+    resetDisplay();
+    playbackClock.restart();
+}
+
+// Small road-like grid with jittered positions, so traversal order is easy to follow on screen
+void VisualizationHandler::prepareGraph() {
+    static std::mt19937 rng(std::random_device{}());
+    demoGraph = generateGridGraph(GRAPH_ROWS, GRAPH_COLUMNS, rng(), 0.8, 20);
+    std::uniform_real_distribution<float> jitter(-0.2f, 0.2f);
+    nodePositions.resize(demoGraph.vertexCount());
+    for (VertexId v = 0; v < demoGraph.vertexCount(); ++v) {
+        float column = static_cast<float>(v % GRAPH_COLUMNS) + 0.5f + jitter(rng);
+        float row = static_cast<float>(v / GRAPH_COLUMNS) + 0.5f + jitter(rng);
+        nodePositions[v] = {column / static_cast<float>(GRAPH_COLUMNS), row / static_cast<float>(GRAPH_ROWS)};
+    }
+    for (const Edge& e : demoGraph.edgeList()) graphEdges.push_back({e.from, e.to});
+}
+
+// A random handful of words that share prefixes, bulk loaded into a Trie and
+// copied out as a directed graph from the root. Node ids follow a pre-order
+// walk, so every subtree is a contiguous id range whose leaves are numbered left
+// to right; an inner node sits above the middle of its leaves.
+void VisualizationHandler::prepareTrie() {
+    static const char* const WORDS[] = {
+        "car", "card", "care", "careful", "cart", "cat", "catch", "cater", "do", "dog", "dot", "dove",
+        "tea", "team", "tear", "ten", "tent", "tend", "to", "toe", "top", "torch", "tree", "trie", "trip"
+    };
+    static std::mt19937 rng(std::random_device{}());
+    vector<string> words(std::begin(WORDS), std::end(WORDS));
+    std::shuffle(words.begin(), words.end(), rng);
+    words.resize(TRIE_WORD_COUNT);
+    std::sort(words.begin(), words.end());
+    Trie trie;
+    trie.bulkLoad(words);
+    trieWords = trie.size();
+
+    vector<Trie::NodeRef> nodes;  // By id
+    vector<std::uint32_t> parent, depth;
+    vector<std::pair<Trie::NodeRef, std::uint32_t>> stack = {{trie.root(), NO_VERTEX}};
+    vector<Trie::NodeRef> children;
+    while (!stack.empty()) {
+        auto [n, from] = stack.back();
+        stack.pop_back();
+        std::uint32_t id = static_cast<std::uint32_t>(nodes.size());
+        nodes.push_back(n);
+        parent.push_back(from);
+        depth.push_back(from == NO_VERTEX ? 0 : depth[from] + 1);
+        children.clear();
+        trie.forEachChild(n, [&](unsigned char, Trie::NodeRef child) { children.push_back(child); });
+        for (size_t c = children.size(); c-- > 0;) stack.push_back({children[c], id});
+    }
+
+    size_t count = nodes.size();
+    GraphBuilder builder(static_cast<VertexId>(count), true);
+    for (std::uint32_t v = 1; v < count; ++v) builder.addEdge(parent[v], v);
+    demoGraph = builder.freeze();
+    for (const Edge& e : demoGraph.edgeList()) graphEdges.push_back({e.from, e.to});
+
+    // Children come after their parent, so walking ids backwards finishes every
+    // subtree's leaf span before its parent needs it
+    vector<float> firstLeaf(count, 0.f), lastLeaf(count, 0.f);
+    size_t leaves = 0;
+    for (std::uint32_t v = 0; v < count; ++v) {
+        if (trie.isLeaf(nodes[v])) firstLeaf[v] = lastLeaf[v] = static_cast<float>(leaves++);
+    }
+    vector<bool> spanned(count, false);
+    for (std::uint32_t v = static_cast<std::uint32_t>(count); v-- > 1;) {
+        std::uint32_t p = parent[v];
+        if (trie.isLeaf(nodes[v])) spanned[v] = true;
+        firstLeaf[p] = spanned[p] ? std::min(firstLeaf[p], firstLeaf[v]) : firstLeaf[v];
+        lastLeaf[p] = spanned[p] ? std::max(lastLeaf[p], lastLeaf[v]) : lastLeaf[v];
+        spanned[p] = true;
+    }
+    float rows = static_cast<float>(*std::max_element(depth.begin(), depth.end()) + 1);
+    nodePositions.resize(count);
+    for (std::uint32_t v = 0; v < count; ++v) {
+        float x = (firstLeaf[v] + lastLeaf[v]) / 2.f + 0.5f;
+        nodePositions[v] = {x / static_cast<float>(std::max<size_t>(leaves, 1)), (static_cast<float>(depth[v]) + 0.5f) / rows};
+    }
+}
+
+// Random keys into the selected kind of tree: level order for a plain binary
+// tree, inserts for the search trees (so the BST shows its imbalance). The
+// traversal is pulled node by node and each node becomes one visit event.
+void VisualizationHandler::prepareTree() {
+    static std::mt19937 rng(std::random_device{}());
+    vector<int> keys(static_cast<size_t>(TREE_KEY_RANGE));
+    std::iota(keys.begin(), keys.end(), 1);
+    std::shuffle(keys.begin(), keys.end(), rng);
+    keys.resize(TREE_NODE_COUNT);
+
+    std::unique_ptr<BinaryTree> tree;
+    if (currentDS == DataStructure::BinaryTree) {
+        tree = std::make_unique<BinaryTree>();
+        tree->buildLevelOrder(keys);
+    } else {
+        std::unique_ptr<BinarySearchTree> search;
+        if (currentDS == DataStructure::AVLTree) search = std::make_unique<AVLTree>();
+        else if (currentDS == DataStructure::RedBlackTree) search = std::make_unique<RedBlackTree>();
+        else search = std::make_unique<BinarySearchTree>();
+        for (int key : keys) search->insert(key);
+        treeRotations = search->getRotations();
+        tree = std::move(search);
+    }
+    treeHeight = tree->height();
+
+    // No erases, so the nodes are pool indices 0..n-1
+    size_t n = tree->size();
+    vector<NodeIndex> parent(n, NIL_NODE);
+    vector<size_t> depth(n, 0);
+    vector<NodeIndex> level = {tree->root()};
+    for (size_t head = 0; head < level.size(); ++head) {
+        NodeIndex v = level[head];
+        for (NodeIndex child : {tree->left(v), tree->right(v)}) {
+            if (child == NIL_NODE) continue;
+            parent[child] = v;
+            depth[child] = depth[v] + 1;
+            graphEdges.push_back({v, child});
+            level.push_back(child);
+        }
+    }
+    nodePositions.resize(n);
+    float rows = static_cast<float>(std::max<size_t>(treeHeight, 1));
+    size_t rank = 0;
+    for (NodeIndex v : TreeTraversal(*tree, TraversalOrder::InOrder)) {
+        nodePositions[v] = {(static_cast<float>(rank++) + 0.5f) / static_cast<float>(n),
+                            (static_cast<float>(depth[v]) + 0.5f) / rows};
+    }
+
+    TreeTraversal walk(*tree, traversalOrderOf(currentAlg));
+    for (NodeIndex v : walk) trace.visit(v, parent[v] == NIL_NODE ? v : parent[v]);
+}
+
+// English-looking text: common words picked with Zipf-like frequencies, with
+// commas, full stops and line breaks now and then. The text fits in one chunk,
+// so the tree drawn is the one that coded all of it.
+void VisualizationHandler::prepareHuffman() {
+    static const char* const WORDS[] = {
+        "the", "of", "and", "to", "a", "in", "is", "it", "that", "was", "for", "on", "with", "as", "he", "be",
+        "at", "by", "this", "had", "not", "are", "but", "from", "or", "have", "an", "they", "which", "one",
+        "you", "were", "all", "we", "her", "she", "there", "would", "their", "will", "when", "who", "him",
+        "been", "has", "more", "if", "no", "out", "so", "said", "what", "up", "its", "about", "than", "into",
+        "them", "can", "only", "other", "time", "new", "some", "could", "these", "two", "may", "first",
+        "then", "do", "any", "like", "my", "now", "over", "such", "our", "man", "me", "even", "most", "made",
+        "after", "also", "did", "many", "off", "before", "must", "well", "back", "through", "years", "where",
+        "much", "your", "way", "down", "should", "because", "long", "each", "just", "state", "people", "those",
+        "Quickly", "zone", "jazz", "xylem", "equal", "vivid", "kayak", "queue", "Wyoming", "42", "1999"
+    };
+    static std::mt19937 rng(std::random_device{}());
+    vector<double> weights(std::size(WORDS));
+    for (size_t i = 0; i < weights.size(); ++i) weights[i] = 1.0 / static_cast<double>(i + 1);
+    std::discrete_distribution<size_t> pick(weights.begin(), weights.end());
+    std::uniform_int_distribution<int> punctuation(0, 99);
+    string text;
+    text.reserve(HUFFMAN_TEXT_BYTES + 16);
+    while (text.size() < HUFFMAN_TEXT_BYTES) {
+        text += WORDS[pick(rng)];
+        int p = punctuation(rng);
+        text += p < 6 ? ", " : p < 10 ? ". " : p < 11 ? ".\n" : " ";
+    }
+    text.resize(HUFFMAN_TEXT_BYTES);
+
+    std::istringstream plain(text);
+    std::ostringstream packed;
+    HuffmanTree tree;
+    huffmanCompress(plain, packed, &huffmanCompressed, &tree);
+    std::istringstream packedIn(packed.str());
+    std::ostringstream unpacked;
+    huffmanRoundTrip = huffmanDecompress(packedIn, unpacked) && unpacked.str() == text;
+
+    // Leaves left to right as a walk from the root meets them; a parent sits
+    // above the middle of its two children, which always have smaller ids
+    size_t k = tree.symbols.size();
+    huffmanSymbols = k;
+    size_t count = tree.weights.size();
+    if (count == 0) return;
+    std::uint32_t root = static_cast<std::uint32_t>(count - 1);
+    vector<size_t> depth(count, 0);
+    for (std::uint32_t v = root; v >= k; --v) {
+        auto [a, b] = tree.merges[v - k];
+        depth[a] = depth[b] = depth[v] + 1;
+    }
+    vector<float> x(count, 0.f);
+    float leaves = 0.f;
+    vector<std::uint32_t> stack = {root};
+    while (!stack.empty()) {
+        std::uint32_t v = stack.back();
+        stack.pop_back();
+        if (v < k) {
+            x[v] = leaves++;
+        } else {
+            stack.push_back(tree.merges[v - k].second);
+            stack.push_back(tree.merges[v - k].first);
+        }
+    }
+    for (size_t v = k; v < count; ++v) x[v] = (x[tree.merges[v - k].first] + x[tree.merges[v - k].second]) / 2.f;
+    treeHeight = *std::max_element(depth.begin(), depth.end()) + 1;
+    float rows = static_cast<float>(treeHeight);
+    nodePositions.resize(count);
+    for (size_t v = 0; v < count; ++v) {
+        nodePositions[v] = {(x[v] + 0.5f) / leaves, (static_cast<float>(depth[v]) + 0.5f) / rows};
+    }
+    for (size_t i = 0; i < tree.merges.size(); ++i) {
+        std::uint32_t parent = static_cast<std::uint32_t>(k + i);
+        graphEdges.push_back({parent, tree.merges[i].first});
+        graphEdges.push_back({parent, tree.merges[i].second});
+        trace.compare(tree.merges[i].first, tree.merges[i].second);
+        trace.visit(tree.merges[i].first, parent);
+        trace.visit(tree.merges[i].second, parent);
+    }
+    trace.visit(root, root);
+}
+
+// Puts the display back to the state the trace was recorded against
+void VisualizationHandler::resetDisplay() {
+    highlighted.clear();
+    if (isGraphView() || isTreeView()) {
+        barColors.assign(nodePositions.size(), Renderer::ARRAY_BAR_COLOR);
+        treeParents.assign(nodePositions.size(), NO_VERTEX);
+        forestEdges.clear();
+        nodeStates.assign(nodePositions.size(), Unreached);
+        frontierNodes.clear();
+        currentLevel = 0;
+    } else if (isMatrixView()) {
+        barColors.assign(matrixTiles * matrixTiles, Renderer::ARRAY_BAR_COLOR);
+        currentLevel = 0;
+    } else {
+        displayData = initialData;
+        barColors.assign(displayData.size(), Renderer::ARRAY_BAR_COLOR);
+    }
+    markAllChanged();
+}
+
+void VisualizationHandler::restartPlayback() {
+    if (!hasVisualization()) return;
+    resetDisplay();
+    playbackCursor = 0;
+    pendingMs = 0.0;
+    playbackClock.restart();
+}
+
+// Forces the renderer to rewrite every bar, e.g. after new input data was generated
+void VisualizationHandler::markAllChanged() {
+    changedIndices.resize(barColors.size());
+    std::iota(changedIndices.begin(), changedIndices.end(), size_t(0));
+}
+
+// Color an element returns to once its step highlight is cleared
+sf::Color VisualizationHandler::restColor(size_t idx) const {
+    if (idx < nodeStates.size()) {
+        if (nodeStates[idx] == InFrontier) return Renderer::GRAPH_FRONTIER_COLOR;
+        if (nodeStates[idx] == Reached) return Renderer::GRAPH_VISITED_COLOR;
+    }
+    return Renderer::ARRAY_BAR_COLOR;
+}
+
+void VisualizationHandler::markHighlight(size_t idx, sf::Color c) {
+    if (idx >= barColors.size()) return;
+    barColors[idx] = c;
+    highlighted.push_back(idx);
+    changedIndices.push_back(idx);
+}
+
+void VisualizationHandler::clearHighlights() {
+    for (size_t idx : highlighted) {
+        barColors[idx] = restColor(idx);
+        changedIndices.push_back(idx);
+    }
+    highlighted.clear();
+}
+
+void VisualizationHandler::applyEvent(const TraceEvent& ev) {
+    switch (ev.op) {
+        case TraceOp::Compare:
+            markHighlight(ev.a, Renderer::ARRAY_COMPARE_COLOR);
+            markHighlight(ev.b, Renderer::ARRAY_COMPARE_COLOR);
+            break;
+        case TraceOp::Swap:
+            if (ev.a < displayData.size() && ev.b < displayData.size()) std::swap(displayData[ev.a], displayData[ev.b]);
+            markHighlight(ev.a, Renderer::workerColor(ev.worker));
+            markHighlight(ev.b, Renderer::workerColor(ev.worker));
+            break;
+        case TraceOp::Write:
+            if (ev.a < displayData.size()) displayData[ev.a] = ev.value;
+            markHighlight(ev.a, Renderer::workerColor(ev.worker));
+            break;
+        case TraceOp::Highlight: { // Only the range bounds, so wide ranges stay O(1) per event
+            sf::Color c = traceWorkers > 1 ? Renderer::workerColor(ev.worker) : Renderer::ARRAY_RANGE_COLOR;
+            markHighlight(ev.a, c);
+            markHighlight(ev.b, c);
+            break;
+        }
+        case TraceOp::Visit:
+            if (ev.a >= nodeStates.size() || ev.b >= nodeStates.size()) break; // Graph-only event
+            if (currentAlg == Algorithm::Kruskal) { // An accepted edge joins two components
+                forestEdges.push_back({ev.b, ev.a});
+                nodeStates[ev.b] = Reached;
+                markHighlight(ev.b, Renderer::ARRAY_SWAP_COLOR);
+            } else {
+                treeParents[ev.a] = ev.b;
+            }
+            if (currentAlg != Algorithm::BFS) { // No levels: reached is final
+                nodeStates[ev.a] = Reached;
+            } else if (nodeStates[ev.a] != InFrontier) {
+                nodeStates[ev.a] = InFrontier;
+                frontierNodes.push_back(ev.a);
+            }
+            markHighlight(ev.a, Renderer::ARRAY_SWAP_COLOR);
+            break;
+        case TraceOp::Frontier: // A new BFS level starts: the previous one is done
+            currentLevel = ev.a;
+            for (size_t idx : frontierNodes) {
+                nodeStates[idx] = Reached;
+                barColors[idx] = restColor(idx);
+                changedIndices.push_back(idx);
+            }
+            frontierNodes.clear();
+            break;
+        case TraceOp::Resize: // Rehash: a fresh, empty slot array; the writes that follow refill it
+            displayData.assign(ev.a, 0);
+            barColors.assign(ev.a, Renderer::ARRAY_BAR_COLOR);
+            highlighted.clear();
+            markAllChanged();
+            ++hashResizes;
+            break;
+        case TraceOp::Tile: { // Phase 1: diagonal tile, 2: its row/column, 3: the rest
+            static const sf::Color PHASE_COLORS[] = {Renderer::ARRAY_SWAP_COLOR, Renderer::ARRAY_COMPARE_COLOR,
+                                                     Renderer::ARRAY_RANGE_COLOR};
+            if (ev.value == 1) currentLevel = ev.a;
+            if (ev.value >= 1 && ev.value <= 3) markHighlight(ev.a * matrixTiles + ev.b, PHASE_COLORS[ev.value - 1]);
+            break;
+        }
+    }
+}
+
+void VisualizationHandler::update() {
+    double elapsedMs = playbackClock.restart().asSeconds() * 1000.0;
+    if (!isAnimating()) return;
+
+    const vector<TraceEvent>& events = trace.events();
+    size_t due;
+    if (speedMs <= 0) {
+        due = FAST_STEPS_PER_UPDATE;
+    } else {
+        pendingMs += elapsedMs;
+        due = static_cast<size_t>(pendingMs / speedMs);
+        pendingMs -= static_cast<double>(due) * speedMs;
+    }
+    if (due == 0) return;
+
+    clearHighlights();
+    size_t end = min(events.size(), playbackCursor + due);
+    for (; playbackCursor < end; ++playbackCursor) {
+        applyEvent(events[playbackCursor]);
+    }
+    if (playbackCursor == events.size()) { // Finished: show the whole array as sorted / every reached vertex as done
+        highlighted.clear();
+        if (isGraphView() || isTreeView()) {
+            for (size_t idx = 0; idx < nodeStates.size(); ++idx) {
+                if (nodeStates[idx] != Unreached) nodeStates[idx] = Reached;
+                barColors[idx] = restColor(idx);
+            }
+            frontierNodes.clear();
+        } else if (isSearchAlgorithm(currentAlg)) {
+            barColors.assign(barColors.size(), Renderer::ARRAY_BAR_COLOR);
+            if (searchResult < barColors.size()) barColors[searchResult] = Renderer::ARRAY_SORTED_COLOR;
+        } else {
+            barColors.assign(barColors.size(), Renderer::ARRAY_SORTED_COLOR);
+        }
+        markAllChanged();
+    }
+}
+
+string VisualizationHandler::getPlaybackStatus() const {
+    if (!hasVisualization()) return "";
+    string status = "Step " + std::to_string(playbackCursor) + " / " + std::to_string(trace.size());
+    if (isGraphView()) {
+        status += "   Visits: " + std::to_string(trace.getVisits());
+        status += "   Edges scanned: " + std::to_string(trace.getComparisons());
+        if (currentAlg == Algorithm::BFS) status += "   Level: " + std::to_string(currentLevel);
+        if (trieWords > 0) status += "   Words: " + std::to_string(trieWords) + "   Trie nodes: " + std::to_string(nodePositions.size());
+        if (trace.isTruncated()) status += "   (trace truncated)";
+        return status;
+    }
+    if (isTreeView()) {
+        status += "   Nodes: " + std::to_string(nodePositions.size());
+        status += "   Height: " + std::to_string(treeHeight);
+        if (treeRotations > 0) status += "   Rotations: " + std::to_string(treeRotations);
+        if (currentAlg == Algorithm::HuffmanEncoding) {
+            // Over the whole demo text, stream overhead included
+            std::ostringstream rates;
+            rates << std::fixed << std::setprecision(2) << "   Symbols: " << huffmanSymbols
+                  << "   Bits/byte: " << huffmanCompressed.bitsPerByte()
+                  << "   Round trip: " << (huffmanRoundTrip ? "ok" : "FAILED");
+            status += rates.str();
+        }
+        return status;
+    }
+    if (isMatrixView()) {
+        status += "   Relaxations: " + std::to_string(trace.getComparisons());
+        status += "   k-block: " + std::to_string(currentLevel + 1) + " / " + std::to_string(matrixTiles);
+        return status;
+    }
+    if (isHashTableView()) {
+        status += "   Slots: " + std::to_string(displayData.size());
+        status += "   Probes: " + std::to_string(trace.getComparisons());
+        status += "   Rehashes: " + std::to_string(hashResizes > 0 ? hashResizes - 1 : 0);
+        status += "   Lookup: " + std::to_string(searchKey);
+        if (playbackCursor == trace.size()) {
+            status += searchResult < displayData.size() ? "   Found in slot " + std::to_string(searchResult) : "   Not found";
+        }
+        return status;
+    }
+    if (isRangeTreeView()) {
+        status += "   Target depth: " + std::to_string(searchKey);
+        status += "   Probes: " + std::to_string(trace.getComparisons());
+        if (playbackCursor == trace.size()) status += "   Reached at level " + std::to_string(rangeLevel);
+        return status;
+    }
+    if (isSearchAlgorithm(currentAlg)) {
+        status += "   Target: " + std::to_string(searchKey);
+        status += "   Probes: " + std::to_string(trace.getComparisons());
+        if (playbackCursor == trace.size()) {
+            status += searchResult < initialData.size() ? "   Found at index " + std::to_string(searchResult) : "   Not found";
+        }
+        return status;
+    }
+    status += "   Comparisons: " + std::to_string(trace.getComparisons());
+    if (currentDS == DataStructure::LinkedList) {
+        // Totals for the whole sort: the trace's writes only redraw the bars
+        status += "   Node hops: " + std::to_string(listTraffic.nodeHops);
+        status += "   Cache lines entered: " + std::to_string(listTraffic.linesEntered);
+        status += "   Link writes: " + std::to_string(listTraffic.linkWrites);
+        if (trace.isTruncated()) status += "   (trace truncated)";
+        return status;
+    }
+    status += "   Swaps: " + std::to_string(trace.getSwaps());
+    status += "   Writes: " + std::to_string(trace.getWrites());
+    if (traceWorkers > 1) status += "   Workers: " + std::to_string(traceWorkers);
+    if (trace.isTruncated()) status += "   (trace truncated)";
+    return status;
+}
+
 void VisualizationHandler::drawCurrentVisualization(Renderer& R, const sf::FloatRect& vizPane) {
-    (void)R; (void)vizPane;
+    if (isGraphView() || isTreeView()) {
+        treeEdges.assign(forestEdges.begin(), forestEdges.end());
+        for (std::uint32_t v = 0; v < treeParents.size(); ++v) {
+            if (treeParents[v] != NO_VERTEX && treeParents[v] != v) treeEdges.push_back({treeParents[v], v});
+        }
+        R.drawGraph(vizPane, nodePositions, graphEdges, treeEdges, barColors);
+    } else if (isMatrixView()) R.drawMatrix(vizPane, matrixTiles, matrixTiles, barColors);
+    else if (isArrayView() || isHashTableView() || isRangeTreeView()) R.drawArray(vizPane, displayData, barColors, changedIndices);
+    changedIndices.clear();
 }
@@ -1,6 +1,10 @@
 // graphics/visualization_handler.h
 #pragma once
 #include "../utilities/types.h" // Includes global enums
+#include "../utilities/step_trace.h"
+#include "../algorithms/greedy/huffman_encoding.h"
+#include "../data_structures/graphs/graph.h"
+#include "../data_structures/lists/linked_list.h"
 #include "renderer.h"
 #include <vector>
 #include <set>
@@ -23,10 +27,104 @@ public:
     int getSpeedMs() const;
     void setSpeedMs(int v);
 
+    // Advances trace playback by however many steps speedMs allows since the last call
+    void update();
+    void restartPlayback();
+    bool hasVisualization() const;
+    bool isAnimating() const;
+    bool hasPendingChanges() const; // Replayed steps not drawn yet
+    std::string getPlaybackStatus() const;
+
     void drawCurrentVisualization(Renderer& R, const sf::FloatRect& vizPane);
 
 private:
     DataStructure currentDS;
     Algorithm currentAlg;
     int speedMs;
+
+    // Step-trace engine: the algorithm runs once, playback only replays events
+    const size_t ARRAY_SIZE = 64;
+    const size_t FAST_STEPS_PER_UPDATE = 256; // Used when speedMs is 0
+    std::vector<int> initialData;   // Input the trace was recorded against
+    std::vector<int> displayData;   // State after the events replayed so far
+    std::vector<sf::Color> barColors;
+    std::vector<size_t> highlighted; // Indices colored by the last applied step
+    std::vector<size_t> changedIndices; // Indices touched since the last draw
+    StepTrace trace;
+    size_t playbackCursor = 0;
+    double pendingMs = 0.0;
+    sf::Clock playbackClock;
+    // Merge/quick sort fork onto the shared pool; with several workers, writes and ranges take the worker's color
+    const size_t SORT_FORK_CUTOFF = 8;
+    unsigned traceWorkers = 1;
+    // Searches run over the sorted demo array; the result stays highlighted after playback
+    int searchKey = 0;
+    size_t searchResult = 0;
+    // Linked list playback: bars are list positions; the list sort's memory traffic goes in the status line
+    ListSortStats listTraffic;
+    // Hash table playback: bars are slots holding keys; rehashes resize the display
+    const size_t HASH_KEY_COUNT = 40;
+    const size_t HASH_ERASE_COUNT = 4;
+    const int HASH_KEY_RANGE = 99;
+    size_t hashResizes = 0; // Resize events replayed so far, the initial allocation included
+    // Fenwick / segment tree playback: bars are the tree's cells, and the search
+    // descends them for the price level where cumulative quantity reaches searchKey
+    const size_t RANGE_LEVEL_COUNT = 32;
+    const int RANGE_MAX_QUANTITY = 9;
+    size_t rangeLevel = 0; // 1-based level the descent found
+
+    // Graph playback reuses barColors as node colors; the demo graph is laid out once per trace
+    const VertexId GRAPH_ROWS = 6;
+    const VertexId GRAPH_COLUMNS = 10;
+    enum NodeState : std::uint8_t { Unreached, InFrontier, Reached };
+    Graph demoGraph;
+    std::vector<sf::Vector2f> nodePositions; // Normalized to [0,1]
+    std::vector<std::pair<std::uint32_t, std::uint32_t>> graphEdges;
+    std::vector<std::uint32_t> treeParents;  // Vertex each node was last reached from
+    std::vector<std::pair<std::uint32_t, std::uint32_t>> forestEdges; // Kruskal: accepted edges
+    std::vector<std::pair<std::uint32_t, std::uint32_t>> treeEdges;   // Drawn highlighted, rebuilt per draw
+    std::vector<std::uint8_t> nodeStates;
+    std::vector<size_t> frontierNodes;
+    std::uint32_t currentLevel = 0;
+    // Tree traversals reuse the graph playback: nodes sit at (in-order rank, depth)
+    // and each visit lights the node and the link from its parent
+    const size_t TREE_NODE_COUNT = 31;
+    const int TREE_KEY_RANGE = 99;
+    size_t treeHeight = 0;
+    std::uint64_t treeRotations = 0; // Spent building the AVL / red-black demo tree
+    // Huffman playback draws the tree built for a few KiB of generated text,
+    // leaves at (rank, code length): each merge compares the two lightest nodes
+    // off the heap and links them under their new parent. The text goes through
+    // the codec both ways on the UI thread, so it stays small; throughput is the
+    // benchmark's job.
+    const size_t HUFFMAN_TEXT_BYTES = size_t(16) << 10;
+    size_t huffmanSymbols = 0;
+    HuffmanStreamStats huffmanCompressed;
+    bool huffmanRoundTrip = false;
+    // Trie BFS / DFS run on a graph copy of a small radix trie: nodes sit at
+    // (leaf rank, depth) and children are numbered in byte order, so DFS spells
+    // the words alphabetically
+    const size_t TRIE_WORD_COUNT = 14;
+    size_t trieWords = 0;
+    // Floyd-Warshall playback colors the demo graph's distance matrix tile by tile
+    const size_t MATRIX_TILE = 8;
+    size_t matrixTiles = 0;
+
+    bool isArrayView() const;
+    bool isHashTableView() const;
+    bool isRangeTreeView() const;
+    bool isGraphView() const;
+    bool isTreeView() const;
+    bool isMatrixView() const;
+    void prepareGraph();
+    void prepareTree();
+    void prepareHuffman();
+    void prepareTrie();
+    sf::Color restColor(size_t idx) const;
+    void resetDisplay();
+    void prepareTrace();
+    void applyEvent(const TraceEvent& ev);
+    void clearHighlights();
+    void markAllChanged();
+    void markHighlight(size_t idx, sf::Color c);
 };
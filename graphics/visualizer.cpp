@@ -42,16 +42,31 @@ void VisualizerApp::run() {
     if (!initialize()) {
         return;
     }
+    auto processEvent = [this](const sf::Event& event) {
+        if (event.type == sf::Event::Closed) {
+            window.close();
+        }
+        if (pGui) {
+            pGui->handleEvent(event);
+        }
+    };
     while (window.isOpen()) {
         sf::Event event;
-        while (window.pollEvent(event)) {
-            if (event.type == sf::Event::Closed) {
-                window.close();
-            }
-            if (pGui) {
-                pGui->handleEvent(event);
+        // Nothing animating and every pane cached: sleep until input arrives instead of redrawing at 60 FPS.
+        // While the profiler runs, sleep briefly instead so its samples show up without input.
+        if (pGui) {
+            bool measuring = pGui->isMeasuring();
+            if (!pGui->needsRedraw()) {
+                if (measuring) sf::sleep(sf::milliseconds(MEASURING_POLL_MS));
+                else if (window.waitEvent(event)) processEvent(event);
             }
         }
+        while (window.pollEvent(event)) {
+            processEvent(event);
+        }
+        if (pVisHandler) {
+            pVisHandler->update(); // Replays recorded trace steps; the algorithm itself already ran
+        }
         window.clear(Renderer::BACKGROUND_COLOR); // Renderer is global
         if (pGui) {
             pGui->draw();
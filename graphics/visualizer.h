@@ -19,6 +19,7 @@ private:
     const unsigned int WINDOW_WIDTH = 1250; 
     const unsigned int WINDOW_HEIGHT = 850;
     const std::string FONT_PATH = "assets/ArialCE.ttf";
+    const int MEASURING_POLL_MS = 20; // Longest wait for input while the profiler runs
 
     sf::RenderWindow window;
     sf::Font font;
@@ -0,0 +1,967 @@
+// tests/test_visualizer.cpp
+// Headless checks of the data structures and algorithms against the standard
+// library or a simpler reference implementation. Links no SFML; `make test`
+// builds and runs it. Exit status is nonzero when any check fails.
+#include "../algorithms/graph/graph_algorithms.h"
+#include "../algorithms/greedy/huffman_encoding.h"
+#include "../algorithms/searching/searching.h"
+#include "../algorithms/sorting/sorting.h"
+#include "../data_structures/lists/linked_list.h"
+#include "../data_structures/maps_sets/disjoint_set.h"
+#include "../data_structures/maps_sets/hash_table.h"
+#include "../data_structures/maps_sets/trie.h"
+#include "../data_structures/queues_stacks/deque.h"
+#include "../data_structures/queues_stacks/queue.h"
+#include "../data_structures/trees/avl_tree.h"
+#include "../data_structures/trees/binary_search_tree.h"
+#include "../data_structures/trees/fenwick_tree.h"
+#include "../data_structures/trees/red_black_tree.h"
+#include "../data_structures/trees/segment_tree.h"
+#include "../utilities/alloc_tracker.h"
+#include "../utilities/parallel.h"
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+#include <deque>
+#include <iostream>
+#include <limits>
+#include <memory>
+#include <random>
+#include <set>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+using std::vector;
+using std::size_t;
+
+static int failures = 0;
+
+static void check(bool ok, const std::string& what) {
+    if (ok) return;
+    ++failures;
+    if (failures <= 20) std::cerr << "FAIL: " << what << std::endl;
+}
+
+enum class TreeKind { Plain, AVL, RedBlack };
+
+static const char* nameOf(TreeKind kind) {
+    switch (kind) {
+        case TreeKind::AVL: return "avl";
+        case TreeKind::RedBlack: return "red-black";
+        default: return "bst";
+    }
+}
+
+static std::unique_ptr<BinarySearchTree> makeTree(TreeKind kind) {
+    switch (kind) {
+        case TreeKind::AVL: return std::make_unique<AVLTree>();
+        case TreeKind::RedBlack: return std::make_unique<RedBlackTree>();
+        default: return std::make_unique<BinarySearchTree>();
+    }
+}
+
+// Height of the subtree at n, or -1 when some node's subtrees differ by more than one
+static int balancedHeight(const BinaryTree& tree, NodeIndex n) {
+    if (n == NIL_NODE) return 0;
+    int l = balancedHeight(tree, tree.left(n)), r = balancedHeight(tree, tree.right(n));
+    if (l < 0 || r < 0 || std::abs(l - r) > 1) return -1;
+    return std::max(l, r) + 1;
+}
+
+static void inOrder(const BinaryTree& tree, NodeIndex n, vector<int>& keys) {
+    if (n == NIL_NODE) return;
+    inOrder(tree, tree.left(n), keys);
+    keys.push_back(tree.key(n));
+    inOrder(tree, tree.right(n), keys);
+}
+
+// Same keys in the same order as the reference, and the kind's balance invariant
+static void checkTree(const BinarySearchTree& tree, TreeKind kind, const std::set<int>& reference, const std::string& where) {
+    vector<int> keys;
+    inOrder(tree, tree.root(), keys);
+    check(tree.size() == reference.size(), where + ": size");
+    check(std::equal(keys.begin(), keys.end(), reference.begin(), reference.end()), where + ": keys");
+    if (kind == TreeKind::AVL) check(balancedHeight(tree, tree.root()) >= 0, where + ": AVL balance");
+    if (kind == TreeKind::RedBlack) check(static_cast<const RedBlackTree&>(tree).blackHeight() >= 0, where + ": black height");
+}
+
+// Random inserts and erases over a small key range, so both hit present and
+// absent keys often and the tree keeps growing and shrinking
+static void testInterleaved(TreeKind kind, std::uint32_t seed) {
+    std::mt19937 rng(seed);
+    std::uniform_int_distribution<int> keys(0, 199), coin(0, 99);
+    std::unique_ptr<BinarySearchTree> tree = makeTree(kind);
+    std::set<int> reference;
+    for (int step = 0; step < 4000; ++step) {
+        int key = keys(rng);
+        // Phases that mostly insert, then mostly erase, so the tree fills up and drains
+        int insertPercent = (step / 500) % 2 == 0 ? 70 : 30;
+        std::string where = std::string(nameOf(kind)) + " seed " + std::to_string(seed) + " step " + std::to_string(step);
+        if (coin(rng) < insertPercent) {
+            check(tree->insert(key) == reference.insert(key).second, where + ": insert result");
+        } else {
+            check(tree->erase(key) == (reference.erase(key) == 1), where + ": erase result");
+        }
+        check(tree->contains(key) == (reference.count(key) == 1), where + ": contains");
+        checkTree(*tree, kind, reference, where);
+    }
+}
+
+// Bulk load a sorted set (the red-black tree builds a 2-3 tree for it), then
+// erase every key in random order with a few inserts mixed in
+static void testEraseAfterBulkLoad(TreeKind kind, size_t n, std::uint32_t seed) {
+    std::mt19937 rng(seed);
+    vector<int> sorted(n);
+    for (size_t i = 0; i < n; ++i) sorted[i] = static_cast<int>(i * 3);
+    std::unique_ptr<BinarySearchTree> tree = makeTree(kind);
+    tree->bulkLoad(sorted);
+    std::set<int> reference(sorted.begin(), sorted.end());
+    std::string where = std::string(nameOf(kind)) + " bulk " + std::to_string(n);
+    checkTree(*tree, kind, reference, where + " loaded");
+
+    vector<int> order = sorted;
+    std::shuffle(order.begin(), order.end(), rng);
+    for (size_t i = 0; i < order.size(); ++i) {
+        std::string step = where + " erase " + std::to_string(i);
+        check(tree->erase(order[i]), step + ": erase result");
+        reference.erase(order[i]);
+        if (i % 7 == 0) { // Between two loaded keys, so the tree never held it
+            int fresh = order[i] + 1;
+            check(tree->insert(fresh) == reference.insert(fresh).second, step + ": insert result");
+        }
+        checkTree(*tree, kind, reference, step);
+    }
+    check(!tree->erase(-1), where + ": erase of an absent key");
+}
+
+// Keeps a few bits so keys collide in clusters and erase has long runs to shift back
+struct CoarseHash {
+    size_t operator()(int key) const { return static_cast<size_t>(key >> 3); }
+};
+
+// Overwrites, erases and the rehashes they cause against std::unordered_map,
+// checking every key in the range after each step, present or not
+template <typename Hash>
+static void testHashTable(const std::string& name, std::uint32_t seed) {
+    std::mt19937 rng(seed);
+    std::uniform_int_distribution<int> keys(0, 299), op(0, 99);
+    HashTable<int, int, Hash> table;
+    std::unordered_map<int, int> reference;
+    for (int step = 0; step < 3000; ++step) {
+        int key = keys(rng);
+        std::string where = name + " step " + std::to_string(step);
+        if (op(rng) < 65) {
+            check(table.insert(key, step) == reference.insert_or_assign(key, step).second, where + ": insert result");
+        } else {
+            check(table.erase(key) == (reference.erase(key) == 1), where + ": erase result");
+        }
+        check(table.size() == reference.size(), where + ": size");
+        check(table.loadFactor() <= table.maxLoadFactor(), where + ": load factor");
+        if (step % 10 != 0) continue;
+        for (int k = 0; k < 300; ++k) {
+            auto it = reference.find(k);
+            const int* value = table.find(k);
+            check(it == reference.end() ? value == nullptr : value != nullptr && *value == it->second, where + ": find " + std::to_string(k));
+        }
+    }
+    check(table.getStats().resizes > 0, name + ": rehashed");
+
+    // Rehash into a larger array keeps every entry
+    table.setMaxLoadFactor(0.25f);
+    table.reserve(2000);
+    check(table.size() == reference.size(), name + " after reserve: size");
+    for (const auto& [key, value] : reference) {
+        const int* found = table.find(key);
+        check(found && *found == value, name + " after reserve: find " + std::to_string(key));
+    }
+    table.clear();
+    check(table.empty() && !table.contains(reference.empty() ? 0 : reference.begin()->first), name + ": clear");
+}
+
+// Words over a few letters share long prefixes; over every byte value the
+// root fans out past 48 children, so all four node sizes get used
+static std::string randomWord(std::mt19937& rng, int alphabet) {
+    std::uniform_int_distribution<int> length(0, 8), byte(0, alphabet - 1);
+    std::string word(static_cast<size_t>(length(rng)), '\0');
+    for (char& c : word) c = static_cast<char>(alphabet == 256 ? byte(rng) : 'a' + byte(rng));
+    return word;
+}
+
+// The words the trie yields for prefix, in order, against the reference's range
+static void checkPrefix(const Trie& trie, const std::set<std::string>& reference, const std::string& prefix, const std::string& where) {
+    vector<std::string> got;
+    for (const std::string& word : trie.withPrefix(prefix)) got.push_back(word);
+    vector<std::string> expected;
+    for (auto it = reference.lower_bound(prefix); it != reference.end() && it->compare(0, prefix.size(), prefix) == 0; ++it) expected.push_back(*it);
+    check(got == expected, where + ": prefix \"" + prefix + "\"");
+}
+
+static void checkTrie(const Trie& trie, const std::set<std::string>& reference, std::mt19937& rng, int alphabet, const std::string& where) {
+    check(trie.size() == reference.size(), where + ": size");
+    for (const std::string& word : reference) check(trie.contains(word), where + ": contains");
+    for (int i = 0; i < 50; ++i) {
+        std::string probe = randomWord(rng, alphabet);
+        check(trie.contains(probe) == (reference.count(probe) == 1), where + ": contains random");
+        checkPrefix(trie, reference, probe.substr(0, probe.size() / 2), where);
+    }
+    checkPrefix(trie, reference, "", where);
+}
+
+// Inserts against std::set, then a bulk load of the same words (duplicated) into a fresh trie
+static void testTrie(int alphabet, std::uint32_t seed) {
+    std::mt19937 rng(seed);
+    std::string where = "trie (" + std::to_string(alphabet) + " symbols, seed " + std::to_string(seed) + ")";
+    Trie trie;
+    std::set<std::string> reference;
+    for (int i = 0; i < 2000; ++i) {
+        std::string word = randomWord(rng, alphabet);
+        check(trie.insert(word) == reference.insert(word).second, where + ": insert result");
+        if (i % 500 == 0) checkTrie(trie, reference, rng, alphabet, where + " insert " + std::to_string(i));
+    }
+    checkTrie(trie, reference, rng, alphabet, where + " inserted");
+
+    vector<std::string> sorted;
+    for (const std::string& word : reference) {
+        sorted.push_back(word);
+        if (sorted.size() % 3 == 0) sorted.push_back(word);
+    }
+    Trie loaded;
+    loaded.insert("stale");
+    loaded.bulkLoad(sorted);
+    checkTrie(loaded, reference, rng, alphabet, where + " bulk loaded");
+    check(loaded.insert("zz-new") == (reference.count("zz-new") == 0), where + ": insert after bulk load");
+
+    trie.clear();
+    check(trie.empty() && !trie.contains(*reference.begin()), where + ": clear");
+}
+
+// Pushes and pops at both ends against std::deque, growing past several blocks
+// and draining again so the ring wraps and reuses its blocks. Strings own heap
+// memory, so a missed or doubled destructor shows up under a sanitizer.
+static void testDeque(std::uint32_t seed) {
+    std::mt19937 rng(seed);
+    std::uniform_int_distribution<int> op(0, 99);
+    Deque<std::string> deque;
+    std::deque<std::string> reference;
+    const size_t blockSize = Deque<std::string>::BLOCK_SIZE;
+    std::string where = "deque seed " + std::to_string(seed);
+    for (int step = 0; step < 20000; ++step) {
+        // Grow for a while, then shrink, a few times over
+        int pushBias = (step / 2500) % 2 == 0 ? 70 : 30;
+        int r = op(rng);
+        std::string value = "v" + std::to_string(step);
+        if (r < pushBias / 2) {
+            deque.pushBack(value);
+            reference.push_back(value);
+        } else if (r < pushBias) {
+            deque.pushFront(value);
+            reference.push_front(value);
+        } else if (!reference.empty() && r < pushBias + (100 - pushBias) / 2) {
+            check(deque.front() == reference.front(), where + ": front");
+            deque.popFront();
+            reference.pop_front();
+        } else if (!reference.empty()) {
+            check(deque.back() == reference.back(), where + ": back");
+            deque.popBack();
+            reference.pop_back();
+        }
+        check(deque.size() == reference.size(), where + ": size");
+        if (step % 500 == 0) {
+            bool same = true;
+            for (size_t i = 0; i < reference.size(); ++i) same = same && deque[i] == reference[i];
+            check(same, where + " step " + std::to_string(step) + ": elements");
+        }
+    }
+    check(deque.blockCount() * blockSize >= deque.size(), where + ": block count");
+    while (reference.size() > 3) {
+        deque.popFront();
+        reference.pop_front();
+    }
+    deque.shrinkToFit();
+    check(deque.blockCount() <= 2, where + ": shrinkToFit");
+    for (size_t i = 0; i < reference.size(); ++i) check(deque[i] == reference[i], where + ": elements after shrinkToFit");
+    deque.clear();
+    check(deque.empty(), where + ": clear");
+}
+
+// Every value pushed by the producers is popped exactly once, through a ring
+// small enough to be full and empty often
+template <typename Ring>
+static void testRingStress(const std::string& name, unsigned producers, unsigned consumers) {
+    const std::uint32_t perProducer = 20000;
+    Ring ring(8);
+    vector<std::atomic<int>> seen(producers * perProducer);
+    for (auto& s : seen) s = 0;
+    std::atomic<std::uint32_t> popped{0};
+    const std::uint32_t total = producers * perProducer;
+    vector<std::thread> threads;
+    for (unsigned p = 0; p < producers; ++p) {
+        threads.emplace_back([&, p] {
+            for (std::uint32_t i = 0; i < perProducer; ++i) {
+                std::uint32_t value = p * perProducer + i;
+                while (!ring.tryPush(value)) std::this_thread::yield();
+            }
+        });
+    }
+    for (unsigned c = 0; c < consumers; ++c) {
+        threads.emplace_back([&] {
+            std::uint32_t value;
+            while (popped.load() < total) {
+                if (!ring.tryPop(value)) {
+                    std::this_thread::yield();
+                    continue;
+                }
+                if (value < total) seen[value].fetch_add(1);
+                popped.fetch_add(1);
+            }
+        });
+    }
+    for (std::thread& t : threads) t.join();
+    check(popped.load() == total, name + ": popped count");
+    size_t wrong = 0;
+    for (auto& s : seen) wrong += s.load() != 1;
+    check(wrong == 0, name + ": " + std::to_string(wrong) + " values not seen exactly once");
+    std::uint32_t leftover;
+    check(!ring.tryPop(leftover), name + ": empty at the end");
+}
+
+// Brute-force answers for the range trees
+static std::int64_t bruteFold(const vector<std::int64_t>& values, size_t first, size_t last, int which) {
+    std::int64_t sum = 0, low = std::numeric_limits<std::int64_t>::max(), high = std::numeric_limits<std::int64_t>::min();
+    for (size_t i = first; i < last; ++i) {
+        sum += values[i];
+        low = std::min(low, values[i]);
+        high = std::max(high, values[i]);
+    }
+    return which == 0 ? sum : which == 1 ? low : high;
+}
+
+static size_t bruteLowerBound(const vector<std::int64_t>& values, std::int64_t target) {
+    std::int64_t sum = 0;
+    for (size_t count = 0; count <= values.size(); ++count) {
+        if (sum >= target) return count;
+        if (count < values.size()) sum += values[count];
+    }
+    return values.size() + 1;
+}
+
+// Range adds, sets and queries (single and batched, so both the lazy fold and
+// the pushed-down scan run) on the segment trees, point adds on the Fenwick
+// tree and range adds on the range Fenwick tree, all against a plain array
+static void testRangeTrees(size_t n, std::uint32_t seed) {
+    std::mt19937 rng(seed);
+    std::uniform_int_distribution<int> op(0, 99), delta(-5, 20);
+    std::uniform_int_distribution<size_t> index(0, n - 1);
+    std::string where = "range trees n=" + std::to_string(n);
+    vector<std::int64_t> values(n);
+    for (std::int64_t& v : values) v = delta(rng) + 5;
+    SegmentTree<SumMonoid> sums(values);
+    SegmentTree<MinMonoid> mins(values);
+    SegmentTree<MaxMonoid> maxes(values);
+    FenwickTree fenwick(values);
+    RangeFenwickTree rangeFenwick(values);
+    vector<std::int64_t> pointValues = values; // Fenwick takes only point adds
+
+    for (int step = 0; step < 400; ++step) {
+        std::string at = where + " step " + std::to_string(step);
+        size_t a = index(rng), b = index(rng);
+        size_t first = std::min(a, b), last = std::max(a, b) + 1;
+        int r = op(rng);
+        if (r < 35) {
+            std::int64_t d = delta(rng);
+            sums.add(first, last, d);
+            mins.add(first, last, d);
+            maxes.add(first, last, d);
+            rangeFenwick.add(first, last, d);
+            for (size_t i = first; i < last; ++i) values[i] += d;
+        } else if (r < 45) {
+            std::int64_t v = delta(rng);
+            sums.set(a, v);
+            mins.set(a, v);
+            maxes.set(a, v);
+            rangeFenwick.add(a, a + 1, v - values[a]);
+            values[a] = v;
+        } else if (r < 60) {
+            std::int64_t d = delta(rng);
+            fenwick.add(a, d);
+            pointValues[a] += d;
+        } else if (r < 90) {
+            check(sums.query(first, last) == bruteFold(values, first, last, 0), at + ": segment sum");
+            check(mins.query(first, last) == bruteFold(values, first, last, 1), at + ": segment min");
+            check(maxes.query(first, last) == bruteFold(values, first, last, 2), at + ": segment max");
+            check(rangeFenwick.rangeSum(first, last) == bruteFold(values, first, last, 0), at + ": range fenwick sum");
+            check(fenwick.rangeSum(first, last) == bruteFold(pointValues, first, last, 0), at + ": fenwick sum");
+            check(sums.get(a) == values[a] && fenwick.value(a) == pointValues[a], at + ": get");
+        } else {
+            // 1 query goes the lazy way, n queries push everything down first
+            size_t count = r < 95 ? 1 : n;
+            vector<RangeQuery> queries(count);
+            for (RangeQuery& q : queries) {
+                size_t x = index(rng), y = index(rng);
+                q = {std::min(x, y), std::max(x, y) + 1};
+            }
+            vector<std::int64_t> got(count), low(count), high(count);
+            sums.queryBatch(queries.data(), count, got.data());
+            mins.queryBatch(queries.data(), count, low.data());
+            maxes.queryBatch(queries.data(), count, high.data());
+            for (size_t q = 0; q < count; ++q) {
+                check(got[q] == bruteFold(values, queries[q].first, queries[q].last, 0), at + ": batched sum");
+                check(low[q] == bruteFold(values, queries[q].first, queries[q].last, 1), at + ": batched min");
+                check(high[q] == bruteFold(values, queries[q].first, queries[q].last, 2), at + ": batched max");
+            }
+        }
+        check(sums.queryAll() == bruteFold(values, 0, n, 0), at + ": queryAll");
+        check(sums.query(first, first) == 0, at + ": empty range");
+    }
+
+    // lowerBound needs non-negative values
+    for (size_t i = 0; i < n; ++i) {
+        std::int64_t lift = std::max<std::int64_t>(0, -values[i]);
+        sums.add(i, i + 1, lift);
+        values[i] += lift;
+        std::int64_t pointLift = std::max<std::int64_t>(0, -pointValues[i]);
+        fenwick.add(i, pointLift);
+        pointValues[i] += pointLift;
+    }
+    std::int64_t total = bruteFold(values, 0, n, 0), pointTotal = bruteFold(pointValues, 0, n, 0);
+    for (std::int64_t target : {std::int64_t(-1), std::int64_t(0), std::int64_t(1), total / 3, total / 2, total, total + 1}) {
+        check(sums.lowerBound(target) == bruteLowerBound(values, target), where + ": segment lowerBound " + std::to_string(target));
+    }
+    for (std::int64_t target : {std::int64_t(1), pointTotal / 3, pointTotal, pointTotal + 1}) {
+        check(fenwick.lowerBound(target) == bruteLowerBound(pointValues, target), where + ": fenwick lowerBound " + std::to_string(target));
+    }
+}
+
+// Sort lists built from both ends (with a few pops, so the free list is in use)
+// against std::sort, then check the list still links up at both ends
+static void testListSort(size_t elementsPerNode, size_t n, std::uint32_t seed) {
+    std::mt19937 rng(seed);
+    std::uniform_int_distribution<int> values(-50, 50), side(0, 2);
+    LinkedList list(elementsPerNode);
+    std::deque<int> reference;
+    for (size_t i = 0; i < n; ++i) {
+        int v = values(rng);
+        if (side(rng) == 0) {
+            list.pushFront(v);
+            reference.push_front(v);
+        } else {
+            list.pushBack(v);
+            reference.push_back(v);
+        }
+        if (i % 9 == 4) {
+            list.popFront();
+            reference.pop_front();
+        }
+    }
+    std::string where = "list sort (" + std::to_string(elementsPerNode) + " per node, n=" + std::to_string(n) + ")";
+    vector<int> expected(reference.begin(), reference.end());
+    std::sort(expected.begin(), expected.end());
+    list.sort();
+    vector<int> got(list.begin(), list.end());
+    check(got == expected, where + ": order");
+    check(list.size() == expected.size(), where + ": size");
+    if (expected.empty()) return;
+    check(list.front() == expected.front() && list.back() == expected.back(), where + ": front/back");
+    list.pushBack(1000);
+    list.pushFront(-1000);
+    check(list.back() == 1000 && list.front() == -1000 && list.size() == expected.size() + 2, where + ": push after sort");
+}
+
+static std::string huffmanPack(const std::string& plain) {
+    std::istringstream in(plain);
+    std::ostringstream out;
+    check(huffmanCompress(in, out), "huffman: compress");
+    return out.str();
+}
+
+static bool huffmanUnpack(const std::string& packed, std::string& plain) {
+    std::istringstream in(packed);
+    std::ostringstream out;
+    bool ok = huffmanDecompress(in, out);
+    plain = out.str();
+    return ok;
+}
+
+static void checkHuffmanRoundTrip(const std::string& plain, const std::string& what) {
+    std::string packed = huffmanPack(plain), back;
+    check(huffmanUnpack(packed, back) && back == plain, "huffman round trip: " + what);
+}
+
+// Round trips (empty, one symbol, every byte value, skewed, more than one
+// chunk), a count distribution deep enough to hit the length cap, and streams
+// damaged in each part of the format
+static void testHuffman() {
+    std::mt19937 rng(7);
+    checkHuffmanRoundTrip("", "empty");
+    checkHuffmanRoundTrip("x", "one byte");
+    checkHuffmanRoundTrip(std::string(5000, 'a'), "one symbol");
+    std::string every;
+    for (int round = 0; round < 3; ++round) {
+        for (int b = 0; b < 256; ++b) every.push_back(static_cast<char>(b));
+    }
+    checkHuffmanRoundTrip(every, "every byte value");
+    std::geometric_distribution<int> skewed(0.3);
+    std::string text(HUFFMAN_CHUNK_BYTES + 12345, '\0');
+    for (char& c : text) c = static_cast<char>(std::min(skewed(rng), 255));
+    checkHuffmanRoundTrip(text, "two chunks");
+
+    // Fibonacci counts would want codes as long as the alphabet
+    HuffmanCounts counts{};
+    std::uint64_t a = 1, b = 1;
+    for (size_t s = 0; s < 40; ++s) {
+        counts[s] = a;
+        std::uint64_t next = a + b;
+        a = b;
+        b = next;
+    }
+    HuffmanCode code = buildHuffmanCode(counts);
+    unsigned longest = 0;
+    for (size_t s = 0; s < 40; ++s) longest = std::max<unsigned>(longest, code.lengths[s]);
+    check(longest > 0 && longest <= HUFFMAN_MAX_CODE_LENGTH, "huffman: lengths capped");
+    HuffmanCode rebuilt;
+    check(canonicalHuffmanCode(code.lengths, rebuilt) && rebuilt.codes == code.codes, "huffman: canonical code from lengths");
+    std::string fib;
+    for (size_t s = 0; s < 40; ++s) fib.append(static_cast<size_t>(std::min<std::uint64_t>(counts[s], 3000)), static_cast<char>(s));
+    checkHuffmanRoundTrip(fib, "capped lengths");
+
+    // Damage: magic, a length field, the code lengths, a cut-off payload
+    std::string packed = huffmanPack(every), out;
+    const size_t magicBytes = 4; // "HUF1", then each block: two 32-bit lengths and 4 bits per symbol
+    check(packed.size() > magicBytes + 8 + HUFFMAN_SYMBOLS / 2, "huffman: packed size");
+    std::string badMagic = packed;
+    badMagic[0] ^= 0x55;
+    check(!huffmanUnpack(badMagic, out), "huffman corrupt: magic");
+    std::string zeroLength = packed;
+    for (size_t i = 0; i < 4; ++i) zeroLength[magicBytes + i] = 0;
+    check(!huffmanUnpack(zeroLength, out), "huffman corrupt: zero plain length");
+    std::string oversubscribed = packed;
+    for (size_t i = 0; i < HUFFMAN_SYMBOLS / 2; ++i) oversubscribed[magicBytes + 8 + i] = 0x11;
+    check(!huffmanUnpack(oversubscribed, out), "huffman corrupt: code lengths");
+    check(!huffmanUnpack(packed.substr(0, packed.size() - 1), out), "huffman corrupt: truncated payload");
+    check(!huffmanUnpack(packed.substr(0, magicBytes + 5), out), "huffman corrupt: truncated header");
+    check(!huffmanUnpack(std::string(), out), "huffman corrupt: empty stream");
+    // Flipped payload bits may still decode to something; they must not crash it
+    for (int trial = 0; trial < 50; ++trial) {
+        std::string flipped = packed;
+        std::uniform_int_distribution<size_t> at(magicBytes + 8 + HUFFMAN_SYMBOLS / 2, flipped.size() - 1);
+        flipped[at(rng)] ^= static_cast<char>(1 << (trial % 8));
+        huffmanUnpack(flipped, out);
+        check(out.size() <= every.size(), "huffman corrupt: flipped payload output size");
+    }
+}
+
+// Sparse, hub-heavy and grid-shaped graphs; the thin grid leaves some vertices unreachable
+static vector<std::pair<std::string, Graph>> testGraphs(std::uint32_t seed) {
+    vector<std::pair<std::string, Graph>> graphs;
+    graphs.emplace_back("random", generateRandomGraph(300, 4.0, seed));
+    graphs.emplace_back("random directed", generateRandomGraph(300, 3.0, seed, true));
+    graphs.emplace_back("rmat", generateRMatGraph(256, 6.0, seed));
+    graphs.emplace_back("rmat directed", generateRMatGraph(256, 4.0, seed, true, 1000));
+    graphs.emplace_back("grid", generateGridGraph(15, 20, seed, 0.6));
+    graphs.emplace_back("single vertex", GraphBuilder(1).freeze());
+    return graphs;
+}
+
+// Every priority-queue backend gives Bellman-Ford's distances, with parents
+// that lie on a shortest path
+static void testDijkstra(std::uint32_t seed) {
+    for (const auto& [name, g] : testGraphs(seed)) {
+        for (VertexId source : {VertexId(0), g.vertexCount() / 2}) {
+            vector<Distance> expected;
+            check(bellmanFord(g, source, expected), name + ": bellman-ford");
+            for (size_t q = 0; q < PRIORITY_QUEUE_NAMES.size(); ++q) {
+                std::string where = "dijkstra " + PRIORITY_QUEUE_NAMES[q] + " on " + name + " from " + std::to_string(source);
+                vector<Distance> dist;
+                vector<VertexId> parent;
+                dijkstra(g, source, dist, parent, static_cast<PriorityQueueKind>(q));
+                check(dist == expected, where + ": distances");
+                check(parent.size() == g.vertexCount() && parent[source] == source, where + ": source parent");
+                bool parentsOk = true;
+                for (VertexId v = 0; v < g.vertexCount() && parentsOk; ++v) {
+                    if (v == source) continue;
+                    if (dist[v] == INF_DISTANCE) {
+                        parentsOk = parent[v] == NO_VERTEX;
+                        continue;
+                    }
+                    // Some arc parent -> v closes the path at v's distance
+                    bool found = false;
+                    Graph::NeighborRange arcs = g.neighbors(parent[v]);
+                    for (size_t i = 0; i < arcs.size(); ++i) found = found || (arcs.target(i) == v && dist[parent[v]] + arcs.weight(i) == dist[v]);
+                    parentsOk = found;
+                }
+                check(parentsOk, where + ": parents");
+            }
+        }
+    }
+}
+
+// Prim on every backend that allows it finds a forest of the same weight, and
+// the radix queue is refused
+static void testPrimQueues(std::uint32_t seed) {
+    for (const auto& [name, g] : testGraphs(seed)) {
+        if (g.isDirected()) continue;
+        Distance reference = -1;
+        for (size_t q = 0; q < PRIORITY_QUEUE_NAMES.size(); ++q) {
+            PriorityQueueKind kind = static_cast<PriorityQueueKind>(q);
+            std::string where = "prim " + PRIORITY_QUEUE_NAMES[q] + " on " + name;
+            vector<VertexId> parent;
+            Distance total = 0;
+            bool ran = prim(g, parent, total, kind);
+            check(ran == (kind != PriorityQueueKind::Radix), where + ": result");
+            if (!ran) continue;
+            if (reference < 0) reference = total;
+            check(total == reference, where + ": total weight");
+        }
+    }
+}
+
+// Random directed graph whose weights are shifted by vertex potentials: many
+// arcs come out negative but every cycle keeps its positive weight. With
+// negativeCycle (n >= 2), two extra arcs make a cycle of negative weight.
+static Graph potentialGraph(VertexId n, std::uint32_t seed, bool negativeCycle) {
+    std::mt19937 rng(seed);
+    std::uniform_int_distribution<int> potential(0, 50), weight(1, 20);
+    std::uniform_int_distribution<VertexId> vertex(0, n - 1);
+    vector<int> p(n);
+    for (int& v : p) v = potential(rng);
+    GraphBuilder builder(n, true);
+    for (size_t e = 0; e < size_t(n) * 3; ++e) {
+        VertexId u = vertex(rng), v = vertex(rng);
+        if (u != v) builder.addEdge(u, v, weight(rng) + p[u] - p[v]);
+    }
+    if (negativeCycle) {
+        builder.addEdge(0, 1, 1);
+        builder.addEdge(1, 0, -2);
+    }
+    return builder.freeze();
+}
+
+// Every tiled variant, with tile sizes that don't divide n, gives the naive
+// triple loop's matrix and agrees with it on negative cycles
+static void testFloydWarshall(VertexId n, std::uint32_t seed) {
+    for (bool negativeCycle : {false, true}) {
+        if (negativeCycle && n < 2) continue;
+        Graph g = potentialGraph(n, seed, negativeCycle);
+        DistanceMatrix expected = DistanceMatrix::fromGraph(g);
+        FloydWarshallOptions naive;
+        naive.variant = FloydWarshallVariant::Naive;
+        bool expectedOk = floydWarshall(expected, naive);
+        check(expectedOk == !negativeCycle, "floyd-warshall naive n=" + std::to_string(n) + ": negative cycle");
+        for (FloydWarshallVariant variant : {FloydWarshallVariant::Blocked, FloydWarshallVariant::Vectorized, FloydWarshallVariant::Parallel}) {
+            for (size_t tile : {1, 7, 13, 64}) {
+                std::string where = "floyd-warshall " + FLOYD_WARSHALL_VARIANT_NAMES[static_cast<size_t>(variant)] + " n=" + std::to_string(n) +
+                                    " tile " + std::to_string(tile) + (negativeCycle ? " (negative cycle)" : "");
+                DistanceMatrix dist = DistanceMatrix::fromGraph(g);
+                FloydWarshallOptions options;
+                options.variant = variant;
+                options.tile = tile;
+                options.threads = 3;
+                check(floydWarshall(dist, options) == expectedOk, where + ": result");
+                if (!expectedOk) continue; // Distances on a negative cycle depend on the relaxation order
+                bool same = true;
+                for (size_t i = 0; i < n; ++i) {
+                    for (size_t j = 0; j < n; ++j) same = same && dist.at(i, j) == expected.at(i, j);
+                }
+                check(same, where + ": distances");
+            }
+        }
+    }
+    // The naive matrix itself against Bellman-Ford from one source
+    Graph g = potentialGraph(n, seed, false);
+    DistanceMatrix matrix = DistanceMatrix::fromGraph(g);
+    FloydWarshallOptions naive;
+    naive.variant = FloydWarshallVariant::Naive;
+    floydWarshall(matrix, naive);
+    vector<Distance> dist;
+    bellmanFord(g, 0, dist);
+    bool same = true;
+    for (VertexId v = 0; v < n; ++v) same = same && (dist[v] == INF_DISTANCE ? matrix.at(0, v) == DistanceMatrix::INF : matrix.at(0, v) == dist[v]);
+    check(same, "floyd-warshall naive n=" + std::to_string(n) + ": against bellman-ford");
+}
+
+// Every Kruskal variant finds a forest as light as Prim's, made of real edges,
+// with no cycle and one tree per component; the concurrent union-find counts
+// the same components as a BFS sweep
+static void testKruskal(std::uint32_t seed) {
+    vector<std::pair<std::string, Graph>> graphs = testGraphs(seed);
+    // Big enough for filter-Kruskal to partition, with few distinct weights so ties abound
+    graphs.emplace_back("random ties", generateRandomGraph(5000, 8.0, seed, false, 4));
+    for (const auto& [name, g] : graphs) {
+        vector<Edge> forest;
+        Distance total = 0;
+        if (g.isDirected()) {
+            check(!kruskal(g, forest, total), "kruskal on " + name + ": refuses directed");
+            continue;
+        }
+        vector<VertexId> primParent;
+        Distance primTotal = 0;
+        prim(g, primParent, primTotal);
+
+        std::uint32_t components = 0;
+        vector<bool> seen(g.vertexCount(), false);
+        for (VertexId v = 0; v < g.vertexCount(); ++v) {
+            if (seen[v]) continue;
+            ++components;
+            BfsResult reach = breadthFirstSearch(g, v);
+            for (VertexId u = 0; u < g.vertexCount(); ++u) seen[u] = seen[u] || reach.parent[u] != NO_VERTEX;
+        }
+        check(connectedComponentCount(g, 3) == components, "components of " + name);
+
+        for (size_t variant = 0; variant < KRUSKAL_VARIANT_NAMES.size(); ++variant) {
+            std::string where = "kruskal " + KRUSKAL_VARIANT_NAMES[variant] + " on " + name;
+            KruskalOptions options;
+            options.variant = static_cast<KruskalVariant>(variant);
+            options.threads = 3;
+            check(kruskal(g, forest, total, options), where + ": result");
+            check(total == primTotal, where + ": total weight " + std::to_string(total) + " vs prim " + std::to_string(primTotal));
+            check(forest.size() + components == g.vertexCount(), where + ": edge count");
+            DisjointSet trees(g.vertexCount());
+            Distance sum = 0;
+            bool acyclic = true, real = true;
+            for (const Edge& e : forest) {
+                acyclic = acyclic && trees.unite(e.from, e.to);
+                sum += e.weight;
+                bool found = false;
+                Graph::NeighborRange arcs = g.neighbors(e.from);
+                for (size_t i = 0; i < arcs.size(); ++i) found = found || (arcs.target(i) == e.to && arcs.weight(i) == e.weight);
+                real = real && found;
+            }
+            check(acyclic && real && sum == total, where + ": forest edges");
+        }
+    }
+}
+
+// Radix sort with each digit width, single-threaded and in several blocks
+// (big inputs only), against the expected order compared bit for bit
+template <typename T>
+static void checkRadixSort(const vector<T>& input, const vector<T>& expected, const std::string& name) {
+    for (unsigned digitBits : {8u, 11u}) {
+        for (unsigned threads : {1u, 3u}) {
+            vector<T> data = input;
+            RadixSortOptions options;
+            options.digitBits = digitBits;
+            options.threads = threads;
+            radixSortKeys(data, options);
+            bool same = data.size() == expected.size() && (data.empty() || std::memcmp(data.data(), expected.data(), data.size() * sizeof(T)) == 0);
+            check(same, "radix sort " + name + " n=" + std::to_string(input.size()) + " digits " + std::to_string(digitBits) +
+                            " threads " + std::to_string(threads));
+        }
+    }
+}
+
+template <typename T>
+static void checkRadixSortIntegers(const vector<T>& input, const std::string& name) {
+    vector<T> expected = input;
+    std::sort(expected.begin(), expected.end());
+    checkRadixSort(input, expected, name);
+}
+
+// std::sort can't order NaNs or tell -0.0 from 0.0, so the reference sorts the
+// numbers with -0.0 first among zeros and puts the NaNs at the end their sign
+// bit sends them to: negative NaNs below -inf, positive ones above +inf
+template <typename T>
+static void checkRadixSortFloats(const vector<T>& input, const std::string& name) {
+    vector<T> negativeNans, numbers, positiveNans;
+    for (T v : input) {
+        if (!std::isnan(v)) numbers.push_back(v);
+        else (std::signbit(v) ? negativeNans : positiveNans).push_back(v);
+    }
+    std::sort(numbers.begin(), numbers.end(), [](T a, T b) { return a < b || (a == b && std::signbit(a) && !std::signbit(b)); });
+    vector<T> expected = negativeNans;
+    expected.insert(expected.end(), numbers.begin(), numbers.end());
+    expected.insert(expected.end(), positiveNans.begin(), positiveNans.end());
+    checkRadixSort(input, expected, name);
+}
+
+template <typename T>
+static vector<T> randomFloats(size_t n, std::mt19937& rng) {
+    std::uniform_real_distribution<T> value(-1000, 1000);
+    std::uniform_int_distribution<int> special(0, 19);
+    const T nan = std::numeric_limits<T>::quiet_NaN(), inf = std::numeric_limits<T>::infinity();
+    const T specials[] = {T(0), -T(0), nan, -nan, inf, -inf, std::numeric_limits<T>::denorm_min(), -std::numeric_limits<T>::denorm_min()};
+    vector<T> data(n);
+    for (T& v : data) v = special(rng) == 0 ? specials[special(rng) % 8] : value(rng);
+    return data;
+}
+
+// Negative and full-range keys of each width, floats with signed zeros, NaNs
+// and infinities, inputs where whole digits agree (so those passes are skipped),
+// and the int wrapper the visualizer uses
+static void testRadixSort(size_t n, std::uint32_t seed) {
+    std::mt19937 rng(seed);
+    std::mt19937_64 rng64(seed);
+    vector<std::int32_t> ints(n), smallInts(n);
+    vector<std::uint32_t> unsigned32(n);
+    vector<std::int64_t> longs(n);
+    vector<std::uint64_t> unsigned64(n);
+    std::uniform_int_distribution<int> small(-300, 300);
+    for (size_t i = 0; i < n; ++i) {
+        ints[i] = static_cast<std::int32_t>(rng());
+        smallInts[i] = small(rng);
+        unsigned32[i] = static_cast<std::uint32_t>(rng());
+        longs[i] = static_cast<std::int64_t>(rng64());
+        unsigned64[i] = rng64() >> (i % 3 == 0 ? 40 : 0); // Some keys short, so high digits vary only sometimes
+    }
+    checkRadixSortIntegers(ints, "int32");
+    checkRadixSortIntegers(smallInts, "small int32");
+    checkRadixSortIntegers(unsigned32, "uint32");
+    checkRadixSortIntegers(longs, "int64");
+    checkRadixSortIntegers(unsigned64, "uint64");
+    checkRadixSortFloats(randomFloats<float>(n, rng), "float");
+    checkRadixSortFloats(randomFloats<double>(n, rng), "double");
+
+    vector<int> wrapped(smallInts.begin(), smallInts.end()), expected = wrapped;
+    std::sort(expected.begin(), expected.end());
+    radixSort(wrapped);
+    check(wrapped == expected, "radixSort n=" + std::to_string(n));
+}
+
+// Every binary-search layout, one query at a time and in batches of several
+// sizes, and the plain binarySearch, against std::lower_bound; ternary search
+// against std::binary_search. Keys repeat and queries fall on, between and
+// beyond the stored keys.
+static void testSortedSearch(size_t n, std::uint32_t seed) {
+    std::mt19937 rng(seed);
+    std::uniform_int_distribution<int> value(-1000, 1000);
+    vector<int> sorted(n);
+    for (int& v : sorted) v = value(rng) * 2; // Even keys, so odd queries miss
+    std::sort(sorted.begin(), sorted.end());
+    vector<int> queries = {std::numeric_limits<int>::min(), std::numeric_limits<int>::max(), -3000, 3000};
+    for (int q = -2002; q <= 2002; q += n < 100 ? 1 : 7) queries.push_back(q);
+    std::shuffle(queries.begin(), queries.end(), rng);
+    vector<size_t> expected(queries.size());
+    for (size_t i = 0; i < queries.size(); ++i) expected[i] = std::lower_bound(sorted.begin(), sorted.end(), queries[i]) - sorted.begin();
+    std::string where = "n=" + std::to_string(n);
+
+    for (size_t v = 0; v < BINARY_SEARCH_VARIANT_NAMES.size(); ++v) {
+        std::string name = "binary search " + BINARY_SEARCH_VARIANT_NAMES[v] + " " + where;
+        BinarySearcher searcher(sorted, static_cast<BinarySearchVariant>(v));
+        bool single = true;
+        for (size_t i = 0; i < queries.size(); ++i) single = single && searcher.lowerBound(queries[i]) == expected[i];
+        check(single, name + ": lowerBound");
+        for (size_t batch : {1, 3, 8, 64, 1000}) {
+            vector<size_t> got(queries.size());
+            for (size_t first = 0; first < queries.size(); first += batch) {
+                size_t count = std::min(batch, queries.size() - first);
+                searcher.lowerBounds(queries.data() + first, count, got.data() + first);
+            }
+            check(got == expected, name + ": lowerBounds in batches of " + std::to_string(batch));
+        }
+    }
+    bool plain = true, ternary = true;
+    for (size_t i = 0; i < queries.size(); ++i) {
+        plain = plain && binarySearch(sorted, queries[i]) == expected[i];
+        size_t found = ternarySearch(sorted, queries[i]);
+        bool present = std::binary_search(sorted.begin(), sorted.end(), queries[i]);
+        ternary = ternary && (present ? found < n && sorted[found] == queries[i] : found == n);
+    }
+    check(plain, "binarySearch " + where);
+    check(ternary, "ternarySearch " + where);
+}
+
+// Every linear search finds the first copy of the key, wherever it sits relative
+// to the vector lanes and strides and the parallel chunks, or reports n
+static void testLinearSearch(size_t n, std::uint32_t seed) {
+    std::mt19937 rng(seed);
+    std::uniform_int_distribution<int> value(0, 40);
+    vector<int> data(n);
+    for (int& v : data) v = value(rng);
+    // Keys that are absent or sit only at the very end or very start
+    if (n > 0) {
+        data.back() = 100;
+        data.front() = 101;
+    }
+    LinkedList list(LinkedList::UNROLLED_NODE_ELEMENTS);
+    for (int v : data) list.pushBack(v);
+    std::string where = "linear search n=" + std::to_string(n);
+    for (int key : {-1, 0, 7, 40, 100, 101, 102}) {
+        size_t expected = std::find(data.begin(), data.end(), key) - data.begin();
+        std::string at = where + " key " + std::to_string(key);
+        check(linearSearch(data.data(), n, key) == expected, at + ": simd");
+        check(scalarLinearSearch(data.data(), n, key) == expected, at + ": scalar");
+        check(linearSearch(data, key) == expected, at + ": vector");
+        check(parallelLinearSearch(data, key, 3) == expected, at + ": parallel");
+        check(linearSearch(list, key) == expected, at + ": linked list");
+    }
+    // A single hit at each position of the first few strides
+    vector<int> zeros(n, 0);
+    for (size_t i = 0; i < std::min<size_t>(n, 80); ++i) {
+        zeros[i] = 1;
+        check(linearSearch(zeros.data(), n, 1) == i && parallelLinearSearch(zeros, 1, 3) == i, where + ": lone hit at " + std::to_string(i));
+        zeros[i] = 0;
+    }
+}
+
+static volatile int allocationSink;
+
+// Counts pool workers' allocations but not another thread's, and a block from
+// an earlier scope freed inside this one isn't credited against it
+static void testAllocationScope() {
+    int* older = nullptr;
+    {
+        AllocationScope earlier;
+        older = new int[1000];
+    }
+    std::atomic<bool> stop{false};
+    std::thread bystander([&] {
+        while (!stop) {
+            std::vector<char> noise(1 << 16);
+            allocationSink = noise[7];
+        }
+    });
+    AllocationStats stats;
+    vector<int*> blocks(64); // Kept past the loop, so the allocations can't be optimized out
+    {
+        AllocationScope scope;
+        delete[] older;
+        parallelFor(0, blocks.size(), 1, 4, [&](size_t b, size_t e, unsigned) {
+            for (size_t i = b; i < e; ++i) blocks[i] = new int[100];
+        });
+        for (int* block : blocks) delete[] block;
+        stats = scope.stats();
+    }
+    stop = true;
+    bystander.join();
+    check(stats.allocations >= 64 && stats.bytesAllocated >= 64 * 100 * sizeof(int), "allocation scope: workers counted");
+    check(stats.bytesAllocated < (size_t(1) << 16), "allocation scope: other threads not counted");
+    check(stats.peakBytes >= static_cast<std::int64_t>(100 * sizeof(int)), "allocation scope: peak");
+}
+
+int main() {
+    testAllocationScope();
+    for (std::uint32_t seed = 1; seed <= 3; ++seed) {
+        testHashTable<std::hash<int>>("hash table", seed);
+        testHashTable<CoarseHash>("hash table (coarse hash)", seed);
+        testTrie(3, seed);
+        testTrie(256, seed);
+        testDeque(seed);
+    }
+    for (size_t n : {1, 2, 7, 64, 100, 1000}) testRangeTrees(n, static_cast<std::uint32_t>(n));
+    for (size_t perNode : {size_t(1), size_t(2), LinkedList::UNROLLED_NODE_ELEMENTS, LinkedList::MAX_NODE_ELEMENTS}) {
+        for (size_t n : {0, 1, 2, 3, 15, 100, 1000, 5000}) testListSort(perNode, n, static_cast<std::uint32_t>(n + perNode));
+    }
+    testHuffman();
+    for (size_t n : {0, 1, 2, 100, 5000, 200000}) testRadixSort(n, static_cast<std::uint32_t>(n));
+    for (size_t n : {0, 1, 2, 3, 15, 16, 17, 100, 1000, 100000}) testSortedSearch(n, static_cast<std::uint32_t>(n));
+    for (size_t n : {0, 1, 3, 4, 7, 8, 15, 16, 17, 31, 32, 33, 63, 64, 65, 1000, 300000}) testLinearSearch(n, static_cast<std::uint32_t>(n));
+    for (VertexId n : {1, 2, 17, 64, 100, 131}) testFloydWarshall(n, n);
+    for (std::uint32_t seed = 1; seed <= 3; ++seed) {
+        testDijkstra(seed);
+        testPrimQueues(seed);
+        testKruskal(seed);
+    }
+    testRingStress<SpscRing<std::uint32_t>>("spsc ring", 1, 1);
+    testRingStress<MpmcRing<std::uint32_t>>("mpmc ring", 3, 3);
+    for (TreeKind kind : {TreeKind::Plain, TreeKind::AVL, TreeKind::RedBlack}) {
+        for (std::uint32_t seed = 1; seed <= 5; ++seed) testInterleaved(kind, seed);
+        for (size_t n : {0, 1, 2, 3, 7, 8, 31, 100, 257}) testEraseAfterBulkLoad(kind, n, static_cast<std::uint32_t>(n));
+    }
+    if (failures == 0) std::cout << "All tests passed" << std::endl;
+    else std::cout << failures << " checks failed" << std::endl;
+    return failures == 0 ? 0 : 1;
+}
@@ -0,0 +1,116 @@
+// utilities/alloc_tracker.cpp
+#include "alloc_tracker.h"
+#include <atomic>
+#include <cstdlib>
+#include <cstddef>
+#include <new>
+
+// Every block carries a small header holding its size, so delete can credit
+// it back, and the scope it was counted in (0 if none). Only blocks counted in
+// the open scope are credited, so freeing blocks from before it (or from an
+// earlier scope) can't push live bytes below the start. Over-aligned
+// new/delete are left to the standard library.
+namespace {
+struct BlockHeader {
+    std::size_t size;
+    std::uint32_t scope;
+};
+constexpr std::size_t HEADER_SIZE = (sizeof(BlockHeader) + alignof(std::max_align_t) - 1) / alignof(std::max_align_t) *
+                                    alignof(std::max_align_t);
+
+// Relaxed throughout: a scope reads the totals after joining the threads it started
+std::atomic<std::uint32_t> lastScope{0};
+std::atomic<std::uint32_t> activeScope{0}; // 0 while no scope is open
+std::atomic<std::uint64_t> allocCount{0};
+std::atomic<std::uint64_t> allocBytes{0};
+std::atomic<std::int64_t> liveBytes{0};
+std::atomic<std::int64_t> peakLiveBytes{0};
+thread_local std::uint32_t threadScope = 0; // Scope this thread counts for
+
+void* trackedAlloc(std::size_t size) noexcept {
+    void* raw = std::malloc(size + HEADER_SIZE);
+    if (!raw) return nullptr;
+    std::uint32_t scope = threadScope;
+    if (scope != 0 && scope == activeScope.load(std::memory_order_relaxed)) {
+        allocCount.fetch_add(1, std::memory_order_relaxed);
+        allocBytes.fetch_add(size, std::memory_order_relaxed);
+        std::int64_t live = liveBytes.fetch_add(static_cast<std::int64_t>(size), std::memory_order_relaxed) +
+                            static_cast<std::int64_t>(size);
+        std::int64_t peak = peakLiveBytes.load(std::memory_order_relaxed);
+        while (live > peak && !peakLiveBytes.compare_exchange_weak(peak, live, std::memory_order_relaxed)) {}
+    } else {
+        scope = 0;
+    }
+    *static_cast<BlockHeader*>(raw) = BlockHeader{size, scope};
+    return static_cast<char*>(raw) + HEADER_SIZE;
+}
+
+void trackedFree(void* p) noexcept {
+    if (!p) return;
+    void* raw = static_cast<char*>(p) - HEADER_SIZE;
+    const BlockHeader& header = *static_cast<BlockHeader*>(raw);
+    // Whichever thread frees it: the block was counted in this scope
+    if (header.scope != 0 && header.scope == activeScope.load(std::memory_order_relaxed)) {
+        liveBytes.fetch_sub(static_cast<std::int64_t>(header.size), std::memory_order_relaxed);
+    }
+    std::free(raw);
+}
+
+void* allocOrThrow(std::size_t size) {
+    if (size == 0) size = 1;
+    while (true) {
+        if (void* p = trackedAlloc(size)) return p;
+        std::new_handler handler = std::get_new_handler();
+        if (!handler) throw std::bad_alloc();
+        handler();
+    }
+}
+} // namespace
+
+AllocationScope::AllocationScope() : previous(threadScope) {
+    id = lastScope.fetch_add(1, std::memory_order_relaxed) + 1;
+    if (id == 0) id = lastScope.fetch_add(1, std::memory_order_relaxed) + 1; // 0 means none
+    allocCount.store(0, std::memory_order_relaxed);
+    allocBytes.store(0, std::memory_order_relaxed);
+    liveBytes.store(0, std::memory_order_relaxed);
+    peakLiveBytes.store(0, std::memory_order_relaxed);
+    activeScope.store(id, std::memory_order_relaxed);
+    threadScope = id;
+}
+
+AllocationScope::~AllocationScope() {
+    std::uint32_t open = id;
+    activeScope.compare_exchange_strong(open, 0, std::memory_order_relaxed);
+    threadScope = previous;
+}
+
+AllocationStats AllocationScope::stats() const {
+    AllocationStats s;
+    s.allocations = allocCount.load(std::memory_order_relaxed);
+    s.bytesAllocated = allocBytes.load(std::memory_order_relaxed);
+    s.peakBytes = peakLiveBytes.load(std::memory_order_relaxed);
+    return s;
+}
+
+std::uint32_t AllocationScope::current() {
+    return threadScope;
+}
+
+AllocationScopeJoin::AllocationScopeJoin(std::uint32_t id) : previous(threadScope) {
+    threadScope = id;
+}
+
+AllocationScopeJoin::~AllocationScopeJoin() {
+    threadScope = previous;
+}
+
+void* operator new(std::size_t size) { return allocOrThrow(size); }
+void* operator new[](std::size_t size) { return allocOrThrow(size); }
+void* operator new(std::size_t size, const std::nothrow_t&) noexcept { return trackedAlloc(size ? size : 1); }
+void* operator new[](std::size_t size, const std::nothrow_t&) noexcept { return trackedAlloc(size ? size : 1); }
+void operator delete(void* p) noexcept { trackedFree(p); }
+void operator delete[](void* p) noexcept { trackedFree(p); }
+void operator delete(void* p, std::size_t) noexcept { trackedFree(p); }
+void operator delete[](void* p, std::size_t) noexcept { trackedFree(p); }
+void operator delete(void* p, const std::nothrow_t&) noexcept { trackedFree(p); }
+void operator delete[](void* p, const std::nothrow_t&) noexcept { trackedFree(p); }
@@ -0,0 +1,48 @@
+// utilities/alloc_tracker.h
+#pragma once
+#include <cstdint>
+
+// Process-wide heap accounting. alloc_tracker.cpp replaces the global
+// operator new/delete; counting only happens on threads taking part in an
+// AllocationScope, so the rest of the program pays one thread-local load and a
+// branch. The thread that opens a scope takes part; ThreadPool tasks (and so
+// parallelFor workers) join the scope of the thread that queued them, and
+// threads started by hand join with AllocationScopeJoin. Other threads, such
+// as the UI thread while the profiler measures, are not counted. Only one
+// scope is open at a time, so scopes don't nest.
+
+struct AllocationStats {
+    std::uint64_t allocations = 0;   // Number of operator new calls
+    std::uint64_t bytesAllocated = 0; // Total bytes requested
+    std::int64_t peakBytes = 0;       // High-water mark of live bytes above the scope's start
+};
+
+class AllocationScope {
+public:
+    AllocationScope();
+    ~AllocationScope();
+    AllocationScope(const AllocationScope&) = delete;
+    AllocationScope& operator=(const AllocationScope&) = delete;
+
+    AllocationStats stats() const;
+
+    // Scope the calling thread counts for (0 = none), to hand to the threads it starts
+    static std::uint32_t current();
+
+private:
+    std::uint32_t id;
+    std::uint32_t previous;
+};
+
+// Makes the calling thread count for scope id (from AllocationScope::current())
+// until destroyed; id 0 stops it counting meanwhile
+class AllocationScopeJoin {
+public:
+    explicit AllocationScopeJoin(std::uint32_t id);
+    ~AllocationScopeJoin();
+    AllocationScopeJoin(const AllocationScopeJoin&) = delete;
+    AllocationScopeJoin& operator=(const AllocationScopeJoin&) = delete;
+
+private:
+    std::uint32_t previous;
+};
@@ -0,0 +1,40 @@
+// utilities/cpu_features.h
+#pragma once
+
+// Runtime instruction-set dispatch for the SIMD kernels. The default build
+// targets baseline x86-64 (SSE2), so the AVX2 and SSE4.1 kernels are compiled
+// per function with CPU_TARGET and picked once at run time with the checks
+// below. Builds with -mavx2 / -msse4.1 (or -march) skip the check. Elsewhere
+// CPU_DISPATCH_X86 stays undefined, CPU_TARGET expands to nothing, and the
+// kernels are chosen at compile time as before (AVX2, SSE2, NEON or scalar).
+
+#if (defined(__GNUC__) || defined(__clang__)) && defined(__x86_64__)
+#define CPU_DISPATCH_X86 1
+#define CPU_TARGET(isa) __attribute__((target(isa)))
+
+inline bool cpuHasAvx2() {
+#if defined(__AVX2__)
+    return true;
+#else
+    static const bool has = [] {
+        __builtin_cpu_init();
+        return __builtin_cpu_supports("avx2") != 0;
+    }();
+    return has;
+#endif
+}
+
+inline bool cpuHasSse41() {
+#if defined(__SSE4_1__)
+    return true;
+#else
+    static const bool has = [] {
+        __builtin_cpu_init();
+        return __builtin_cpu_supports("sse4.1") != 0;
+    }();
+    return has;
+#endif
+}
+#else
+#define CPU_TARGET(isa)
+#endif
@@ -0,0 +1,89 @@
+// utilities/node.h
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// Binary tree nodes that live in a per-tree pool and link to each other by
+// 32-bit pool index instead of by pointer. A node is 12 bytes where a pointer
+// node with malloc's header costs 32 or more, the pool is one contiguous block
+// that never fragments, and a copy of the pool is a valid copy of the tree.
+//
+// The top 4 bits of each link are spare (indices stop at 2^28 - 1), which gives
+// every node an 8-bit metadata field for free: AVL height, red-black color.
+
+using NodeIndex = std::uint32_t;
+
+constexpr unsigned NODE_INDEX_BITS = 28;
+constexpr NodeIndex NIL_NODE = (NodeIndex(1) << NODE_INDEX_BITS) - 1; // Also the index mask
+
+struct TreeNode {
+    int key;
+
+    NodeIndex left() const { return leftLink & NIL_NODE; }
+    NodeIndex right() const { return rightLink & NIL_NODE; }
+    void setLeft(NodeIndex i) { leftLink = (leftLink & ~NIL_NODE) | i; }
+    void setRight(NodeIndex i) { rightLink = (rightLink & ~NIL_NODE) | i; }
+
+    // Low nibble in the left link, high nibble in the right link
+    std::uint8_t meta() const {
+        return static_cast<std::uint8_t>((leftLink >> NODE_INDEX_BITS) | ((rightLink >> NODE_INDEX_BITS) << 4));
+    }
+    void setMeta(std::uint8_t m) {
+        leftLink = (leftLink & NIL_NODE) | (NodeIndex(m & 0xF) << NODE_INDEX_BITS);
+        rightLink = (rightLink & NIL_NODE) | (NodeIndex(m >> 4) << NODE_INDEX_BITS);
+    }
+
+    std::uint32_t leftLink;
+    std::uint32_t rightLink;
+};
+static_assert(sizeof(TreeNode) == 12, "TreeNode must stay a 12-byte record");
+
+// Grows like a vector; released nodes go on a free list threaded through their
+// left links and are handed out again first. Growing moves the block, so don't
+// hold a TreeNode& across allocate().
+class NodePool {
+public:
+    // Precondition: !full()
+    NodeIndex allocate(int key, std::uint8_t meta = 0) {
+        NodeIndex i;
+        if (freeList != NIL_NODE) {
+            i = freeList;
+            freeList = nodes[i].left();
+        } else {
+            i = static_cast<NodeIndex>(nodes.size());
+            nodes.push_back({});
+        }
+        TreeNode& n = nodes[i];
+        n.key = key;
+        n.leftLink = n.rightLink = NIL_NODE;
+        n.setMeta(meta);
+        ++live;
+        return i;
+    }
+    void release(NodeIndex i) {
+        nodes[i].setLeft(freeList);
+        freeList = i;
+        --live;
+    }
+    void clear() {
+        nodes.clear();
+        freeList = NIL_NODE;
+        live = 0;
+    }
+    // Room for n nodes in total; the pool can address at most NIL_NODE of them
+    void reserve(std::size_t n) { nodes.reserve(n); }
+
+    TreeNode& operator[](NodeIndex i) { return nodes[i]; }
+    const TreeNode& operator[](NodeIndex i) const { return nodes[i]; }
+
+    std::size_t size() const { return live; }
+    // Every index below NIL_NODE is in use, so allocate() has nothing to hand out
+    bool full() const { return freeList == NIL_NODE && nodes.size() >= NIL_NODE; }
+    std::size_t memoryBytes() const { return nodes.capacity() * sizeof(TreeNode); }
+
+private:
+    std::vector<TreeNode> nodes;
+    NodeIndex freeList = NIL_NODE;
+    std::size_t live = 0;
+};
@@ -0,0 +1,86 @@
+// utilities/parallel.h
+#pragma once
+#include "thread_pool.h"
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <thread>
+#include <utility>
+#include <vector>
+
+// Minimal fork-join helpers shared by the multithreaded algorithm variants.
+
+inline unsigned hardwareThreads() {
+    unsigned n = std::thread::hardware_concurrency();
+    return n == 0 ? 1 : n;
+}
+
+// 0 means "all hardware threads"
+inline unsigned resolveThreadCount(unsigned requested) {
+    return requested == 0 ? hardwareThreads() : requested;
+}
+
+// Runs body(begin, end, worker) over [first, last) in chunks of `grain`, handed
+// out dynamically so uneven chunks balance. The calling thread is worker 0;
+// workers 1.. are tasks on ThreadPool::shared(), so a call costs a few queue
+// pushes rather than thread starts (BFS makes one per level). With fewer pool
+// threads than `threads`, the spare workers find the chunks already taken.
+template <typename Body>
+void parallelFor(std::size_t first, std::size_t last, std::size_t grain, unsigned threads, Body body) {
+    if (first >= last) return;
+    grain = std::max<std::size_t>(grain, 1);
+    std::size_t chunks = (last - first + grain - 1) / grain;
+    unsigned workers = static_cast<unsigned>(std::min<std::size_t>(resolveThreadCount(threads), chunks));
+    if (workers <= 1) {
+        body(first, last, 0u);
+        return;
+    }
+    std::atomic<std::size_t> nextChunk{0};
+    auto worker = [&](unsigned id) {
+        for (std::size_t c = nextChunk.fetch_add(1); c < chunks; c = nextChunk.fetch_add(1)) {
+            std::size_t b = first + c * grain;
+            body(b, std::min(last, b + grain), id);
+        }
+    };
+    TaskGroup group(ThreadPool::shared());
+    for (unsigned id = 1; id < workers; ++id) group.run([&worker, id] { worker(id); });
+    worker(0);
+    group.wait();
+}
+
+// Sorts one chunk per thread, then merges neighbouring runs pairwise, each
+// round's merges also running in parallel, through a single scratch buffer.
+template <typename T, typename Compare>
+void parallelSort(std::vector<T>& data, Compare comp, unsigned threads, std::size_t minChunk = std::size_t(1) << 14) {
+    std::size_t n = data.size();
+    unsigned workers = resolveThreadCount(threads);
+    std::size_t chunks = std::min<std::size_t>(workers, std::max<std::size_t>(1, n / std::max<std::size_t>(minChunk, 1)));
+    if (chunks <= 1) {
+        std::sort(data.begin(), data.end(), comp);
+        return;
+    }
+
+    std::vector<std::size_t> bounds(chunks + 1);
+    for (std::size_t c = 0; c <= chunks; ++c) bounds[c] = n * c / chunks;
+    parallelFor(0, chunks, 1, workers, [&](std::size_t b, std::size_t e, unsigned) {
+        for (std::size_t c = b; c < e; ++c) std::sort(data.begin() + bounds[c], data.begin() + bounds[c + 1], comp);
+    });
+
+    std::vector<T> scratch(n);
+    std::vector<T>* src = &data;
+    std::vector<T>* dst = &scratch;
+    for (std::size_t width = 1; width < chunks; width *= 2) {
+        std::size_t pairs = (chunks + 2 * width - 1) / (2 * width);
+        parallelFor(0, pairs, 1, workers, [&](std::size_t b, std::size_t e, unsigned) {
+            for (std::size_t p = b; p < e; ++p) {
+                std::size_t lo = p * 2 * width;
+                std::size_t mid = std::min(lo + width, chunks), hi = std::min(lo + 2 * width, chunks);
+                std::merge(src->begin() + bounds[lo], src->begin() + bounds[mid],
+                           src->begin() + bounds[mid], src->begin() + bounds[hi],
+                           dst->begin() + bounds[lo], comp);
+            }
+        });
+        std::swap(src, dst);
+    }
+    if (src != &data) data.swap(scratch);
+}
@@ -0,0 +1,150 @@
+// utilities/step_trace.h
+#pragma once
+#include <cstdint>
+#include <cstddef>
+#include <mutex>
+#include <vector>
+
+// Compact record of what an algorithm did, captured once at native speed and
+// replayed by the visualizer at whatever rate the speed slider asks for.
+
+enum class TraceOp : std::uint8_t {
+    Compare,   // a, b: indices compared
+    Swap,      // a, b: indices exchanged
+    Write,     // a: index overwritten with value
+    Highlight, // a..b: inclusive range the algorithm is working on
+    Visit,     // a: vertex/node reached, b: where it was reached from
+    Frontier,  // a: level that starts here, b: number of vertices in it
+    Tile,      // a, b: tile row/column of a blocked matrix update, value: phase
+    Resize     // a: element count of the storage after it was reallocated (e.g. a rehash)
+};
+
+// Fixed-size POD so a whole run lives in one contiguous buffer
+struct TraceEvent {
+    TraceOp op;
+    std::uint8_t worker;   // Thread that produced the event (0 when sequential)
+    std::uint16_t reserved;
+    std::uint32_t a;
+    std::uint32_t b;
+    std::int32_t value;
+};
+static_assert(sizeof(TraceEvent) == 16, "TraceEvent must stay a 16-byte record");
+
+class StepTrace {
+public:
+    // Counters are always maintained; events are only stored when recording.
+    // Once maxEvents is reached recording stops and the trace is marked truncated.
+    explicit StepTrace(bool record = true, std::size_t maxEvents = DEFAULT_MAX_EVENTS)
+        : recording(record), eventLimit(maxEvents) {}
+
+    static constexpr std::size_t DEFAULT_MAX_EVENTS = std::size_t(1) << 22; // 64 MiB of events
+
+    void compare(std::size_t i, std::size_t j) {
+        ++comparisons;
+        push(TraceOp::Compare, i, j, 0);
+    }
+    void swap(std::size_t i, std::size_t j) {
+        ++swaps;
+        push(TraceOp::Swap, i, j, 0);
+    }
+    void write(std::size_t i, int value) {
+        ++writes;
+        push(TraceOp::Write, i, i, value);
+    }
+    void highlight(std::size_t first, std::size_t last) {
+        push(TraceOp::Highlight, first, last, 0);
+    }
+    void visit(std::size_t node, std::size_t from) {
+        ++visits;
+        push(TraceOp::Visit, node, from, 0);
+    }
+
+    void frontier(std::size_t level, std::size_t size) {
+        push(TraceOp::Frontier, level, size, 0);
+    }
+
+    void tile(std::size_t row, std::size_t column, int phase) {
+        push(TraceOp::Tile, row, column, phase);
+    }
+
+    void resize(std::size_t newSize) {
+        push(TraceOp::Resize, newSize, newSize, 0);
+    }
+
+    // Bulk tallies for multithreaded code that counts locally and merges once
+    void addComparisons(std::uint64_t n) { comparisons += n; }
+    void addWrites(std::uint64_t n) { writes += n; }
+
+    // Appends another trace's events (keeping their worker ids) and counters
+    void append(const StepTrace& other) {
+        comparisons += other.comparisons;
+        swaps += other.swaps;
+        writes += other.writes;
+        visits += other.visits;
+        truncated = truncated || other.truncated;
+        if (!recording) return;
+        std::size_t room = eventLimit - buffer.size();
+        if (other.buffer.size() > room) truncated = true;
+        std::size_t take = other.buffer.size() < room ? other.buffer.size() : room;
+        buffer.insert(buffer.end(), other.buffer.begin(), other.buffer.begin() + take);
+    }
+
+    void setWorker(std::uint8_t w) { worker = w; }
+    void clear() {
+        buffer.clear();
+        comparisons = swaps = writes = visits = 0;
+        truncated = false;
+    }
+    void reserve(std::size_t n) { if (recording) buffer.reserve(n < eventLimit ? n : eventLimit); }
+
+    const std::vector<TraceEvent>& events() const { return buffer; }
+    std::size_t size() const { return buffer.size(); }
+    bool isRecording() const { return recording; }
+    bool isTruncated() const { return truncated; }
+
+    std::uint64_t getComparisons() const { return comparisons; }
+    std::uint64_t getSwaps() const { return swaps; }
+    std::uint64_t getWrites() const { return writes; }
+    std::uint64_t getVisits() const { return visits; }
+
+private:
+    std::vector<TraceEvent> buffer;
+    bool recording;
+    bool truncated = false;
+    std::size_t eventLimit;
+    std::uint8_t worker = 0;
+    std::uint64_t comparisons = 0;
+    std::uint64_t swaps = 0;
+    std::uint64_t writes = 0;
+    std::uint64_t visits = 0;
+
+    void push(TraceOp op, std::size_t a, std::size_t b, int value) {
+        if (!recording) return;
+        if (buffer.size() >= eventLimit) { truncated = true; return; }
+        buffer.push_back({op, worker, 0, static_cast<std::uint32_t>(a), static_cast<std::uint32_t>(b), value});
+    }
+};
+
+// Funnels the private traces of concurrent tasks into one StepTrace. A task
+// publishes its events before forking children and again when it finishes, so
+// the merged trace replays every range only after the work it depends on.
+class SharedTrace {
+public:
+    explicit SharedTrace(StepTrace& t) : target(t) {}
+
+    // A private trace for the calling task, tagged with its worker id
+    StepTrace makeLocal(unsigned worker) const {
+        StepTrace local(target.isRecording());
+        local.setWorker(static_cast<std::uint8_t>(worker));
+        return local;
+    }
+    void publish(StepTrace& local) {
+        std::lock_guard<std::mutex> lock(mutex);
+        target.append(local);
+        local.clear();
+    }
+
+private:
+    StepTrace& target;
+    std::mutex mutex;
+};
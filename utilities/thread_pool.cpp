@@ -0,0 +1,103 @@
+// utilities/thread_pool.cpp
+#include "thread_pool.h"
+#include "alloc_tracker.h"
+#include "parallel.h"
+
+using std::size_t;
+
+namespace {
+thread_local const ThreadPool* currentPool = nullptr;
+thread_local unsigned currentIndex = 0;
+}
+
+ThreadPool::ThreadPool(unsigned threadCount) {
+    unsigned n = resolveThreadCount(threadCount);
+    for (unsigned i = 0; i < n; ++i) queues.push_back(std::make_unique<WorkerQueue>());
+    for (unsigned i = 1; i < n; ++i) threads.emplace_back(&ThreadPool::workerLoop, this, i);
+}
+
+ThreadPool::~ThreadPool() {
+    {
+        std::lock_guard<std::mutex> lock(sleepMutex);
+        stopping = true;
+    }
+    wake.notify_all();
+    for (std::thread& t : threads) t.join();
+}
+
+ThreadPool& ThreadPool::shared() {
+    static ThreadPool pool;
+    return pool;
+}
+
+unsigned ThreadPool::currentWorker() {
+    return currentIndex;
+}
+
+void ThreadPool::push(Task task) {
+    // Threads outside the pool (the caller) share queue 0
+    unsigned self = (currentPool == this) ? currentIndex : 0;
+    {
+        std::lock_guard<std::mutex> lock(queues[self]->mutex);
+        queues[self]->tasks.push_back(std::move(task));
+    }
+    queued.fetch_add(1, std::memory_order_release);
+    if (!threads.empty()) {
+        std::lock_guard<std::mutex> lock(sleepMutex); // Pairs with the sleeper's predicate check
+        wake.notify_one();
+    }
+}
+
+bool ThreadPool::runOne(unsigned self) {
+    Task task;
+    bool found = false;
+    {
+        WorkerQueue& own = *queues[self];
+        std::lock_guard<std::mutex> lock(own.mutex);
+        if (!own.tasks.empty()) {
+            task = std::move(own.tasks.back());
+            own.tasks.pop_back();
+            found = true;
+        }
+    }
+    for (unsigned i = 1; !found && i < size(); ++i) {
+        WorkerQueue& victim = *queues[(self + i) % size()];
+        std::lock_guard<std::mutex> lock(victim.mutex);
+        if (!victim.tasks.empty()) {
+            task = std::move(victim.tasks.front());
+            victim.tasks.pop_front();
+            found = true;
+        }
+    }
+    if (!found) return false;
+    queued.fetch_sub(1, std::memory_order_relaxed);
+    {
+        AllocationScopeJoin join(task.allocationScope);
+        task.fn();
+    }
+    task.group->pending.fetch_sub(1, std::memory_order_acq_rel);
+    return true;
+}
+
+void ThreadPool::workerLoop(unsigned index) {
+    currentPool = this;
+    currentIndex = index;
+    for (;;) {
+        if (runOne(index)) continue;
+        std::unique_lock<std::mutex> lock(sleepMutex);
+        wake.wait(lock, [&] { return stopping || queued.load(std::memory_order_acquire) > 0; });
+        if (stopping) return;
+    }
+}
+
+void TaskGroup::run(std::function<void()> fn) {
+    pending.fetch_add(1, std::memory_order_relaxed);
+    pool.push({std::move(fn), this, AllocationScope::current()});
+}
+
+void TaskGroup::wait() {
+    unsigned self = (currentPool == &pool) ? currentIndex : 0;
+    while (pending.load(std::memory_order_acquire) > 0) {
+        if (!pool.runOne(self)) std::this_thread::yield(); // Our tasks are running elsewhere
+    }
+}
@@ -0,0 +1,76 @@
+// utilities/thread_pool.h
+#pragma once
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// Work-stealing pool for recursive fork-join algorithms. Every worker owns a
+// deque: it pushes and pops its own tasks at the back (newest first, still hot
+// in cache) while idle workers steal from the front (oldest, usually the
+// biggest subproblems). A thread waiting on a TaskGroup runs queued tasks
+// instead of blocking, so nested fork-join never deadlocks.
+
+class TaskGroup;
+
+class ThreadPool {
+public:
+    // threads counts the calling thread as worker 0; 0 = all hardware threads
+    explicit ThreadPool(unsigned threads = 0);
+    ~ThreadPool();
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+
+    // Process-wide pool sized to the hardware, created on first use
+    static ThreadPool& shared();
+
+    unsigned size() const { return static_cast<unsigned>(queues.size()); }
+    // Worker index of the calling thread in whichever pool it belongs to; 0 outside any pool
+    static unsigned currentWorker();
+
+private:
+    friend class TaskGroup;
+    struct Task {
+        std::function<void()> fn;
+        TaskGroup* group;
+        std::uint32_t allocationScope = 0; // The forking thread's, so the task's allocations count with it
+    };
+    struct alignas(64) WorkerQueue {
+        std::mutex mutex;
+        std::deque<Task> tasks;
+    };
+
+    std::vector<std::unique_ptr<WorkerQueue>> queues;
+    std::vector<std::thread> threads;
+    std::atomic<std::size_t> queued{0};
+    std::mutex sleepMutex;
+    std::condition_variable wake;
+    bool stopping = false;
+
+    void push(Task task);
+    bool runOne(unsigned self);
+    void workerLoop(unsigned index);
+};
+
+// Tasks forked by one parent; wait() returns once all of them have finished
+class TaskGroup {
+public:
+    explicit TaskGroup(ThreadPool& p) : pool(p) {}
+    ~TaskGroup() { wait(); }
+    TaskGroup(const TaskGroup&) = delete;
+    TaskGroup& operator=(const TaskGroup&) = delete;
+
+    void run(std::function<void()> fn);
+    void wait();
+
+private:
+    friend class ThreadPool;
+    ThreadPool& pool;
+    std::atomic<std::size_t> pending{0};
+};
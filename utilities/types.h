@@ -70,28 +70,101 @@ inline const std::map<DataStructure, std::set<Algorithm>> DS_TO_ALGORITHMS_MAP =
     {DataStructure::AVLTree, { Algorithm::InOrder, Algorithm::PostOrder, Algorithm::PreOrder, Algorithm::BinarySearch }},
     {DataStructure::RedBlackTree, { Algorithm::InOrder, Algorithm::PostOrder, Algorithm::PreOrder, Algorithm::BinarySearch }},
     {DataStructure::MaxHeap, { Algorithm::HeapSort }},
-    {DataStructure::MinHeap, { Algorithm::HeapSort }},
-    {DataStructure::Queue, {}},
-    {DataStructure::Stack, {}},
-    {DataStructure::Deque, {}},
+    {DataStructure::MinHeap, { Algorithm::HeapSort, Algorithm::HuffmanEncoding }},
+    {DataStructure::Queue, { Algorithm::BFS }},
+    {DataStructure::Stack, { Algorithm::DFS }},
+    {DataStructure::Deque, { Algorithm::BFS, Algorithm::DFS }},
     {DataStructure::HashTable, { Algorithm::LinearSearch }},
     {DataStructure::Trie, { Algorithm::DFS, Algorithm::BFS }},
-    {DataStructure::SegmentTree, {}},
-    {DataStructure::FenwickTree, {}},
-    {DataStructure::DisjointSet, {}}
+    {DataStructure::SegmentTree, { Algorithm::BinarySearch }},
+    {DataStructure::FenwickTree, { Algorithm::BinarySearch }},
+    {DataStructure::DisjointSet, { Algorithm::Kruskal }}
 };
 
-inline double evaluateSimpleComplexity(const std::string& bigO, double n) {
+// Big-O notation parsed once into a class, so plotting a curve doesn't
+// string-compare the notation for every sample.
+enum class ComplexityClass {
+    Unknown,
+    Constant, Logarithmic, Linear, Linearithmic, Quadratic, Cubic, Exponential
+};
+
+inline ComplexityClass parseComplexity(const std::string& bigO) {
+    if (bigO == "O(1)") return ComplexityClass::Constant;
+    if (bigO == "O(log n)") return ComplexityClass::Logarithmic;
+    if (bigO == "O(n)") return ComplexityClass::Linear;
+    if (bigO == "O(n log n)") return ComplexityClass::Linearithmic;
+    if (bigO == "O(n^2)") return ComplexityClass::Quadratic;
+    if (bigO == "O(n^3)") return ComplexityClass::Cubic;
+    if (bigO == "O(2^n)") return ComplexityClass::Exponential;
+    return ComplexityClass::Unknown;
+}
+
+inline double evaluateComplexity(ComplexityClass c, double n) {
     if (n <= 0) n = 1e-9;
-    if (bigO == "O(1)") return 1.0;
-    if (bigO == "O(log n)") return std::log2(n);
-    if (bigO == "O(n)") return n;
-    if (bigO == "O(n log n)") return n * std::log2(n);
-    if (bigO == "O(n^2)") return n * n;
-    if (bigO == "O(n^3)") return n * n * n;
-    if (bigO == "O(2^n)") {
-        if (n > 20) return std::numeric_limits<double>::infinity();
-        return std::pow(2.0, n);
+    switch (c) {
+        case ComplexityClass::Constant: return 1.0;
+        case ComplexityClass::Logarithmic: return std::log2(n);
+        case ComplexityClass::Linear: return n;
+        case ComplexityClass::Linearithmic: return n * std::log2(n);
+        case ComplexityClass::Quadratic: return n * n;
+        case ComplexityClass::Cubic: return n * n * n;
+        case ComplexityClass::Exponential:
+            if (n > 20) return std::numeric_limits<double>::infinity();
+            return std::pow(2.0, n);
+        case ComplexityClass::Unknown: break;
     }
     return std::numeric_limits<double>::quiet_NaN();
 }
+
+inline double evaluateSimpleComplexity(const std::string& bigO, double n) {
+    return evaluateComplexity(parseComplexity(bigO), n);
+}
+
+inline std::string complexityNotation(ComplexityClass c) {
+    switch (c) {
+        case ComplexityClass::Constant: return "O(1)";
+        case ComplexityClass::Logarithmic: return "O(log n)";
+        case ComplexityClass::Linear: return "O(n)";
+        case ComplexityClass::Linearithmic: return "O(n log n)";
+        case ComplexityClass::Quadratic: return "O(n^2)";
+        case ComplexityClass::Cubic: return "O(n^3)";
+        case ComplexityClass::Exponential: return "O(2^n)";
+        case ComplexityClass::Unknown: break;
+    }
+    return "N/A";
+}
+
+// Scale k minimising the relative error of ys ~ k * f(ns) (weights 1/y^2)
+inline double complexityScale(ComplexityClass c, const std::vector<double>& ns, const std::vector<double>& ys) {
+    double num = 0.0, den = 0.0;
+    for (size_t i = 0; i < ns.size() && i < ys.size(); ++i) {
+        if (ys[i] <= 0.0) continue;
+        double f = evaluateComplexity(c, ns[i]);
+        if (!std::isfinite(f)) continue;
+        double w = 1.0 / (ys[i] * ys[i]);
+        num += w * ys[i] * f;
+        den += w * f * f;
+    }
+    return den > 0.0 ? num / den : 0.0;
+}
+
+// Best-matching class for measured samples; all-zero measurements fit O(1)
+inline ComplexityClass fitComplexity(const std::vector<double>& ns, const std::vector<double>& ys) {
+    static const ComplexityClass candidates[] = {
+        ComplexityClass::Constant, ComplexityClass::Logarithmic, ComplexityClass::Linear,
+        ComplexityClass::Linearithmic, ComplexityClass::Quadratic, ComplexityClass::Cubic
+    };
+    ComplexityClass best = ComplexityClass::Constant;
+    double bestError = std::numeric_limits<double>::infinity();
+    for (ComplexityClass c : candidates) {
+        double k = complexityScale(c, ns, ys);
+        double error = 0.0;
+        for (size_t i = 0; i < ns.size() && i < ys.size(); ++i) {
+            if (ys[i] <= 0.0) continue;
+            double r = (ys[i] - k * evaluateComplexity(c, ns[i])) / ys[i];
+            error += r * r;
+        }
+        if (error < bestError) { bestError = error; best = c; }
+    }
+    return best;
+}